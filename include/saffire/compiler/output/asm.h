@@ -87,6 +87,8 @@
     } t_asm_constant;
 
 
+    extern int asm_superinstructions;      // 1 (default) when the assembler fuses opcode sequences into superinstructions
+
     t_asm_opr *asm_create_opr(int type, char *s, int l);
     t_asm_line *asm_create_codeline(int lineno, int opcode, int opr_cnt, ...);
     t_asm_line *asm_create_frameline(char *name);
@@ -8,4 +8,10 @@
 
 #define SIZEOF_INT @SIZEOF_INT@
 
+/* Use computed goto (threaded) dispatch in the VM instead of a switch */
+#cmakedefine VM_COMPUTED_GOTO
+
+/* Guard the object recycle queues with a mutex */
+#cmakedefine GC_QUEUE_LOCKING
+
 #endif // __CONFIG_H__
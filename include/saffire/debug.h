@@ -67,6 +67,14 @@
         // Display ref counts
         #define __DEBUG_REFCOUNT  0
     #endif
+    #ifndef __DEBUG_GC
+        // Display garbage collector runs
+        #define __DEBUG_GC  0
+    #endif
+    #ifndef __DEBUG_GC_QUEUE
+        // Display recycle queue statistics on shutdown
+        #define __DEBUG_GC_QUEUE  0
+    #endif
 
 
     // Parse flex/bison debugging
@@ -27,9 +27,49 @@
 #ifndef __GC_H__
 #define __GC_H__
 
-    void gc_collect(void);
-    t_object *gc_queue_recycle(int type);
+    #include <saffire/objects/object.h>
+
+    // Counters for a single object recycle queue
+    typedef struct _gc_queue_stats {
+        long hits;          // Allocations served from the queue
+        long misses;        // Allocations that needed fresh memory
+        long recycled;      // Freed objects that were added to the queue
+        long discarded;     // Freed objects that did not fit in the queue
+        long queued;        // Number of objects currently inside the queue
+        long size;          // Maximum number of objects inside the queue
+    } t_gc_queue_stats;
+
+    // Cycle collector statistics
+    typedef struct _gc_stats {
+        long runs;              // Number of collections done
+        long collected;         // Total number of objects collected
+        long last_collected;    // Number of objects collected by the last run
+        long last_pause;        // Duration of the last run (in microseconds)
+        long total_pause;       // Duration of all runs (in microseconds)
+        long roots;             // Number of possible roots currently buffered
+    } t_gc_stats;
+
+    extern int gc_collect_pending;
+    extern long gc_allocations;
+    extern long gc_allocation_threshold;
+
+    // Only containers can be part of a reference cycle
+    #define GC_IS_CONTAINER(obj)    ((obj)->type == objectTypeUser || (obj)->type == objectTypeList || \
+                                     (obj)->type == objectTypeTuple || (obj)->type == objectTypeHash)
+
+    // An allocated container that is not handled by the collector yet, can be the root of garbage cycle
+    #define GC_IS_POSSIBLE_ROOT(obj) (((obj)->flags & OBJECT_GC_MASK) == 0 && OBJECT_IS_ALLOCATED(obj) && GC_IS_CONTAINER(obj))
+
+    // Schedules a collection when enough objects are allocated. The VM will collect at the next safe point.
+    #define GC_COUNT_ALLOCATION() \
+        if (++gc_allocations >= gc_allocation_threshold) gc_collect_pending = 1;
+
+    long gc_collect(void);
+    void gc_possible_root(t_object *obj);
+    void gc_get_stats(t_gc_stats *stats);
+    t_object *gc_queue_recycle(int type, long data_size);
     int gc_queue_add(t_object *obj);
+    int gc_queue_stats(int type, t_gc_queue_stats *stats);
     void gc_init(void);
     void gc_fini(void);
 
@@ -0,0 +1,52 @@
+/*
+ Copyright (c) 2012-2015, The Saffire Group
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+     * Redistributions of source code must retain the above copyright
+       notice, this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of the Saffire Group the
+       names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef __HASH_COMPACT_H__
+#define __HASH_COMPACT_H__
+
+    #include <saffire/general/hashtable.h>
+
+    // A single element, stored in insertion order
+    typedef struct _compact_entry {
+        t_hash_key key;                         // Key (owned by the table), key.hash holds the full hash
+        void *value;                            // Actual variable stored
+    } t_compact_entry;
+
+    // Storage of a compact hash table (ht->storage)
+    typedef struct _compact_storage {
+        unsigned long index_size;               // Number of slots in the index (power of 2)
+        int index_width;                        // Width of a single index slot in bytes (1, 2, 4 or 8)
+        void *index;                            // Open addressed index into the entries array
+
+        t_compact_entry *entries;               // Dense entries array
+        unsigned long entries_used;             // Number of used entries (including removed ones)
+        unsigned long entries_size;             // Number of allocated entries
+    } t_compact_storage;
+
+    // Hash functions for an insertion ordered hash table without separate buckets
+    extern t_hashfuncs compact_hf;
+
+#endif
@@ -32,7 +32,11 @@
     /**
      * Different hashing methods. Just add them to a hashfunc structure to use
      */
-    hash_t hash_native(t_hash_table *ht, const char *key);
-    hash_t hash_djbx33a(t_hash_table *ht, const char *key);
+    hash_t hash_native(t_hash_table *ht, const char *key, size_t len);
+    hash_t hash_djbx33a(t_hash_table *ht, const char *key, size_t len);
+    hash_t hash_fx(t_hash_table *ht, const char *key, size_t len);
+
+    void hash_seed_init(void);
+    uint64_t hash_siphash(const char *key, size_t len);
 
 #endif
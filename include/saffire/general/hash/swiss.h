@@ -0,0 +1,59 @@
+/*
+ Copyright (c) 2012-2015, The Saffire Group
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+     * Redistributions of source code must retain the above copyright
+       notice, this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of the Saffire Group the
+       names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef __HASH_SWISS_H__
+#define __HASH_SWISS_H__
+
+    #include <stdint.h>
+    #include <saffire/general/hashtable.h>
+
+    // Number of control bytes that are probed at once
+    #define SWISS_GROUP_WIDTH       16
+
+    // A single element, stored in insertion order
+    typedef struct _swiss_entry {
+        t_hash_key key;                         // Key (owned by the table), key.hash holds the full hash
+        void *value;                            // Actual variable stored
+        char key_buf[HT_KEY_INLINE_SIZE];       // Storage for short string keys
+    } t_swiss_entry;
+
+    // Storage of a swiss hash table (ht->storage)
+    typedef struct _swiss_storage {
+        unsigned long capacity;                 // Number of slots (power of 2, at least SWISS_GROUP_WIDTH)
+        unsigned long growth_left;              // Number of empty slots that can be filled before rehashing
+
+        uint8_t *ctrl;                          // Control byte per slot, followed by a copy of the first group
+        uint32_t *slots;                        // Entry index per slot
+
+        t_swiss_entry *entries;                 // Entries array
+        unsigned long entries_used;             // Number of used entries (including removed ones)
+        unsigned long entries_size;             // Number of allocated entries
+    } t_swiss_storage;
+
+    // Hash functions for open addressed hash tables that probe a group of slots at once
+    extern t_hashfuncs swiss_hf;
+
+#endif
@@ -27,6 +27,7 @@
 #ifndef __HASHTABLE_H__
 #define __HASHTABLE_H__
 
+    #include <stddef.h>
     #include <stdint.h>
 
     // Hashd value
@@ -39,20 +40,31 @@
     #define HASH_KEY_OBJ         2
     #define HASH_KEY_PTR         3
 
+    struct _hash_table;
+    struct _symbol;
+
     typedef struct _hash_key {
         char type;                          // One of the HASH_KEY_* defines
+        char interned;                      // 1 when the string value is the name of a symbol (never copied or freed)
         union {
             char *s;                        // String value
             int n;                          // Numerical value
             uintptr_t p;                        // Pointers
             t_object *o;                    // Objects
         } val;
+        size_t len;                         // Length of a string value
+
+        hash_t hash;                        // Cached hash value
+        hash_t (*hashed_by)(struct _hash_table *ht, const char *, size_t);     // Hash function that computed the cached hash (or NULL)
     } t_hash_key;
 
 
+    // Short string keys are stored inside the bucket itself
+    #define HT_KEY_INLINE_SIZE      24
+
     // Hash table bucket
     typedef struct _hash_table_bucket {
-        t_hash_key  *key;
+        t_hash_key key;                         // Key (owned by the bucket)
         void *value;                            // Actual variable stored
 
         hash_t hash;                            // The calculated hash for the item (for rehashing)
@@ -61,6 +73,8 @@
         struct _hash_table_bucket *next_element; // Link to next element (any bucket)
 
         struct _hash_table_bucket *next_in_bucket; // Link to next entry in this bucket
+
+        char key_buf[HT_KEY_INLINE_SIZE];       // Storage for short string keys
     } t_hash_table_bucket;
 
 
@@ -79,23 +93,36 @@
         t_hash_table_bucket *tail;              // DLL head (for appending elements)
 
         t_hash_table_bucket **bucket_list;      // Actual bucket list array
+        t_hash_table_bucket **old_bucket_list;  // Bucket list that is still being migrated after a resize (or NULL)
+        unsigned int old_bucket_count;          // Number of buckets in the old bucket list
+        unsigned int rehash_idx;                // Next bucket in the old bucket list to migrate
+
+        void *storage;                          // Storage for hash functions that don't use buckets
     } t_hash_table;
 
+    struct _hash_iter;
+
 
     // Actual hash functions
     typedef struct _hashfuncs {
-        hash_t (*hash)(t_hash_table *ht, const char *);                  // Returns hash of string (0..bucket_count)
+        hash_t (*hash)(t_hash_table *ht, const char *, size_t);          // Returns hash of string (0..bucket_count)
         void *(*find)(t_hash_table *ht, t_hash_key *);                   // Find value for key in hashtable
         int (*exists)(t_hash_table *ht, t_hash_key *);                   // Find if a key exists in a hashtable
-        int (*add)(t_hash_table *ht, t_hash_key *, void *value);         // Add value to key
+        int (*add)(t_hash_table *ht, t_hash_key *, void *value);         // Add value to key (key is copied into the table)
         void *(*replace)(t_hash_table *ht, t_hash_key *, void *value);   // Replace value to key
         void *(*remove)(t_hash_table *ht, t_hash_key *);                 // Remove key
         void (*resize)(t_hash_table *ht, int new_bucket_count);        // Resize (and rehash) hashtable to new size
         void (*deep_copy)(t_hash_table *ht);                           // Makes a deep copy of the buckets
+        void (*destroy)(t_hash_table *ht);                             // Frees all elements and storage
+        void (*iter_seek)(struct _hash_iter *iter, int tail);          // Moves iterator to the first (or last) element
+        void (*iter_step)(struct _hash_iter *iter, int forward);       // Moves iterator to the next (or previous) element
+        t_hash_key *(*iter_key)(struct _hash_iter *iter);              // Key of the current element (NULL when not valid)
+        void *(*iter_value)(struct _hash_iter *iter);                  // Value of the current element
     } t_hashfuncs;
 
 
     t_hash_table *ht_create(void);
+    t_hash_table *ht_create_lookup(void);
     t_hash_table *ht_create_custom(int bucket_count, float load_factor, float resize_factor, t_hashfuncs *hashfuncs);
     t_hash_table *ht_copy(t_hash_table *ht, int copy_on_write);
     void ht_destroy(t_hash_table *ht);
@@ -105,18 +132,21 @@
     int ht_exists_num(t_hash_table *ht, long key);
     int ht_exists_obj(t_hash_table *ht, t_object *key);
     int ht_exists_ptr(t_hash_table *ht, void *key);
+    int ht_exists_sym(t_hash_table *ht, struct _symbol *key);
 
     void *ht_find(t_hash_table *ht, t_hash_key *key);
     void *ht_find_str(t_hash_table *ht, char *key);
     void *ht_find_num(t_hash_table *ht, long key);
     void *ht_find_obj(t_hash_table *ht, t_object *key);
     void *ht_find_ptr(t_hash_table *ht, void *key);
+    void *ht_find_sym(t_hash_table *ht, struct _symbol *key);
 
     int ht_add(t_hash_table *ht, t_hash_key *key, void *value);
     int ht_add_str(t_hash_table *ht, char *key, void *value);
     int ht_add_num(t_hash_table *ht, long key, void *value);
     int ht_add_obj(t_hash_table *ht, t_object *key, void *value);
     int ht_add_ptr(t_hash_table *ht, void *key, void *value);
+    int ht_add_sym(t_hash_table *ht, struct _symbol *key, void *value);
 
     int ht_append_num(t_hash_table *ht, void *value);
 
@@ -125,12 +155,14 @@
     void *ht_replace_num(t_hash_table *ht, long key, void *value);
     void *ht_replace_obj(t_hash_table *ht, t_object *key, void *value);
     void *ht_replace_ptr(t_hash_table *ht, void *key, void *value);
+    void *ht_replace_sym(t_hash_table *ht, struct _symbol *key, void *value);
 
     void *ht_remove(t_hash_table *ht, t_hash_key *key);
     void *ht_remove_str(t_hash_table *ht, char *key);
     void *ht_remove_num(t_hash_table *ht, long key);
     void *ht_remove_obj(t_hash_table *ht, t_object *key);
     void *ht_remove_ptr(t_hash_table *ht, void *key);
+    void *ht_remove_sym(t_hash_table *ht, struct _symbol *key);
 
 #ifdef __DEBUG
     void ht_debug(t_hash_table *ht);
@@ -141,8 +173,8 @@
     // Functionality for iterating a hash table (forward only)
     typedef struct _hash_iter {
         t_hash_table *ht;
-        unsigned long bucket_idx;
-        t_hash_table_bucket *bucket;
+        unsigned long bucket_idx;               // Current position (for hash functions without buckets)
+        t_hash_table_bucket *bucket;            // Current bucket
     } t_hash_iter;
 
     int ht_iter_init(t_hash_iter *iter, t_hash_table *ht);
@@ -155,11 +187,26 @@
     char *ht_iter_key_str(t_hash_iter *iter);
     long ht_iter_key_num(t_hash_iter *iter);
     t_object *ht_iter_key_obj(t_hash_iter *iter);
+    struct _symbol *ht_iter_key_sym(t_hash_iter *iter);
     void *ht_iter_value(t_hash_iter *iter);
 
     t_hash_key *ht_key_create(int type, void *val);
     t_hash_key *ht_key_copy(t_hash_key *org);
     void ht_key_free(t_hash_key *hk);
+    int ht_key_equals(t_hash_key *hk1, t_hash_key *hk2);
+    void ht_key_store(t_hash_key *dst, t_hash_key *src);
+    void ht_key_release(t_hash_key *hk);
+
+    // Borrowed keys live on the stack and point to the caller's data, so lookups don't touch the heap
+    void ht_key_borrow(t_hash_key *hk, int type, void *val);
+    void ht_key_borrow_str(t_hash_key *hk, const char *s, size_t len);
+    void ht_key_borrow_sym(t_hash_key *hk, struct _symbol *symbol);
+    hash_t ht_key_hash(t_hash_table *ht, t_hash_key *hk);
+
+    t_hash_table_bucket *ht_bucket_alloc(void);
+    void ht_bucket_free(t_hash_table_bucket *htb);
+    void ht_bucket_set_key(t_hash_table_bucket *htb, t_hash_key *key);
+    void ht_bucket_free_key(t_hash_table_bucket *htb);
 
 
 #endif
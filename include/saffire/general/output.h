@@ -32,6 +32,8 @@
     #include <saffire/general/dll.h>
     #include <saffire/general/string.h>
 
+    struct _object;
+
     #define ANSI_BRIGHTRED    "\33[31;1m"
     #define ANSI_BRIGHTGREEN  "\33[32;1m"
     #define ANSI_BRIGHTYELLOW "\33[33;1m"
@@ -54,7 +56,7 @@
     void output_debug_string(t_string *format, ...);
 
 //    void output_char_printf(char *format, t_dll *args);
-    void output_string_printf(t_string *format, t_dll *args);
+    void output_string_printf(t_string *format, struct _object **argv, int argc);
 
     void output_debug_char_printf(char *format, t_dll *args);
     void output_debug_string_printf(t_string *format, t_dll *args);
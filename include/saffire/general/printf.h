@@ -31,6 +31,8 @@
     #include <saffire/general/dll.h>
     #include <saffire/general/string.h>
 
+    struct _object;
+
     // Flags user in processing format string
     #define PR_LJ   0x01    // Left Justify
     #define PR_CA   0x02    // Casing (A..F instead of a..f)
@@ -45,6 +47,6 @@
 
     typedef int (*fnptr)(FILE *f, char c);
 
-    int arg_printf_string(FILE *f, t_string *fmt, t_dll *args, fnptr output);
+    int arg_printf_string(FILE *f, t_string *fmt, struct _object **argv, int argc, fnptr output);
 
 #endif
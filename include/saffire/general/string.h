@@ -31,6 +31,12 @@
     #include <saffire/general/md5.h>
 
 
+    // Character set of a string, as found by string_charset()
+    #define STRING_CHARSET_UNKNOWN      0           // Not scanned yet
+    #define STRING_CHARSET_ASCII        1           // Only 7-bit characters
+    #define STRING_CHARSET_UTF8         2           // Valid UTF-8, with multibyte characters
+    #define STRING_CHARSET_BINARY       3           // Not valid UTF-8
+
     // Forward defined in general/unicode.h
 
     // t_string are compatible with 0-terminated char strings.
@@ -38,11 +44,13 @@
         char            *val;           // Pointer to char data
         size_t          len;            // Length of the string
         UChar           *unicode;       // Unicode string. May or may not be filled.
+        int             charset;        // Character set (STRING_CHARSET_*). Must be reset when val is changed.
     };
 
     #define STRING_CHAR0(str)       str->val
     #define STRING_LEN(str)         str->len
     #define STRING_UNICODE(str)     str->unicode
+    #define STRING_IS_ASCII(str)    (string_charset(str) == STRING_CHARSET_ASCII)
 
     t_string *char0_to_string(const char *s);
     t_string *char_to_string(const char *s, size_t len);
@@ -67,5 +75,11 @@
 
     void string_free(t_string *str);
 
+    int string_charset(t_string *str);
+
+    t_string *string_ascii_toupper(const t_string *src);
+    t_string *string_ascii_tolower(const t_string *src);
+    t_string *string_ascii_ucfirst(const t_string *src);
+
 #endif
 
@@ -0,0 +1,50 @@
+/*
+ Copyright (c) 2012-2015, The Saffire Group
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+     * Redistributions of source code must retain the above copyright
+       notice, this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of the Saffire Group the
+       names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef __SYMBOL_H__
+#define __SYMBOL_H__
+
+    #include <stddef.h>
+    #include <saffire/general/hashtable.h>
+
+    /*
+     * Symbols are interned strings: there is only one symbol for every name, so two symbols are equal when their
+     * pointers are equal. Symbols are never freed until symbol_fini().
+     */
+    typedef struct _symbol {
+        hash_t hash;                // Precalculated hash of the name (by hash_fx)
+        size_t len;                 // Length of the name
+        char s[];                   // Name, always \0 terminated
+    } t_symbol;
+
+    // Returns the symbol of a name that has been returned by symbol_intern() (for instance, from a hash table key)
+    #define SYMBOL_FROM_STR(str)    ((t_symbol *)((str) - offsetof(t_symbol, s)))
+
+    t_symbol *symbol_intern(const char *s, size_t len);
+    t_symbol *symbol_intern0(const char *s);
+    void symbol_fini(void);
+
+#endif
@@ -29,6 +29,7 @@
 
     #include <saffire/objects/object.h>
     #include <saffire/objects/objects.h>
+    #include <saffire/general/symbol.h>
 
 
     // Attribute visibility
@@ -101,11 +102,15 @@
 
     #define Object_Attrib   (t_object *)&Object_Attrib_struct
 
+    // Increased whenever attributes of a class are added or a class is freed, so cached attribute lookups can be invalidated.
+    extern unsigned long object_attrib_generation;
+
     void object_attrib_init(void);
     void object_attrib_fini(void);
 
     void object_attrib_bind(t_attrib_object *attrib_obj, t_object *bound_obj, char *name);
     t_attrib_object *object_attrib_duplicate(t_attrib_object *attrib, t_object *bound_obj);
     t_attrib_object *object_attrib_find(t_object *self, char *name);
+    t_attrib_object *object_attrib_find_sym(t_object *self, t_symbol *name);
 
 #endif
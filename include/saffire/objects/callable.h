@@ -36,14 +36,17 @@
     typedef struct _method_arg {
         t_object *value;                // Value of the method (or NULL when it doesn't have a default value)
         t_string_object *typehint;      // Typehint of the class (as a string)
+        int slot;                       // Local variable slot inside the method frame, or -1 when not found
     } t_method_arg;
 
     /* Callable code types */
     #define CALLABLE_CODE_INTERNAL         1        /* This is an internal function (native_func) */
     #define CALLABLE_CODE_EXTERNAL         2        /* This is an external function (bytecode) */
+    #define CALLABLE_CODE_DLL              4        /* Internal function receives its arguments inside a DLL (native_dll_func) */
 
     #define CALLABLE_IS_CODE_INTERNAL(callable) ((((t_callable_object *)callable)->data.routing & CALLABLE_CODE_INTERNAL) == CALLABLE_CODE_INTERNAL)
     #define CALLABLE_IS_CODE_EXTERNAL(callable) ((((t_callable_object *)callable)->data.routing & CALLABLE_CODE_EXTERNAL) == CALLABLE_CODE_EXTERNAL)
+    #define CALLABLE_IS_CODE_DLL(callable) ((((t_callable_object *)callable)->data.routing & CALLABLE_CODE_DLL) == CALLABLE_CODE_DLL)
 
     typedef struct {
         int routing;     // A CALLABLE_CODE_*, to distinguish between external (userland saffire) and internal (C code)
@@ -54,7 +57,8 @@
                 struct _vm_stackframe *frame;                       // Running in this stackframe (with local vars etc)
             } external;
             struct {
-                t_object *(*native_func)(t_object *, t_dll *);      // internal function
+                t_object *(*native_func)(t_object *, t_object **, int);     // internal function
+                t_object *(*native_dll_func)(t_object *, t_dll *);          // internal function with DLL arguments
             } internal;
         } code;
 
@@ -37,7 +37,9 @@
 
 
     typedef struct {
-        t_hash_table *ht;
+        t_object **elements;        // Contiguous array with the elements of the list
+        long length;                // Number of elements in the list
+        long capacity;              // Number of allocated element slots
         struct {
             long idx;
         } iter;
@@ -56,4 +58,8 @@
     void object_list_init(void);
     void object_list_fini(void);
 
+    void object_list_reserve(t_list_object *list_obj, long capacity);
+    void object_list_append(t_list_object *list_obj, t_object *obj);
+    int object_list_set(t_list_object *list_obj, long idx, t_object *obj);
+
 #endif
@@ -29,8 +29,15 @@
 
     #include <saffire/objects/object.h>
 
+    typedef struct {
+        long index;             // Current iteration (zero based)
+        long count;             // Number of elements in the iteration (-1 if not available)
+        int populated;          // 1 when the attributes are created, 0 otherwise
+    } t_meta_object_data;
+
     typedef struct {
         SAFFIRE_OBJECT_HEADER
+        t_meta_object_data data;
         SAFFIRE_OBJECT_FOOTER
     } t_meta_object;
 
@@ -38,7 +45,10 @@
 
     #define Object_Meta   (t_object *)&Object_Meta_struct
 
+    #define OBJECT_IS_META(obj)     ((obj)->class == Object_Meta)
+
     void object_meta_init(void);
     void object_meta_fini(void);
+    void object_meta_populate_attributes(t_meta_object *meta_obj);
 
 #endif
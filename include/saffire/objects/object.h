@@ -29,6 +29,8 @@
 
     #include <stdlib.h>
     #include <stdarg.h>
+    #include <stdint.h>
+    #include <limits.h>
     #include <saffire/general/hashtable.h>
     #include <saffire/general/dll.h>
     #include <saffire/compiler/ast_nodes.h>
@@ -43,14 +45,19 @@
 
 
     // These functions must be present to deal with object administration (cloning, allocating and free-ing info)
+    // Called by traverse() for every object that is referenced (and ref-counted) by another object
+    typedef void (*t_object_visit)(t_object *obj, void *arg);
+
     typedef struct _object_funcs {
         void (*populate)(t_object *, t_dll *);      // Populates an object with new values
         void (*free)(t_object *);                   // Frees objects internal data and places it onto gc queue
         void (*destroy)(t_object *);                // Destroys object. Don't use object after this call!
         void (*clone)(const t_object *, t_object *);  // Clones additional object data
         t_object *(*cache)(t_object *, t_dll *);    // Returns a cached object or NULL when no cached object is found
-        char *(*hash)(t_object *);                  // Returns a string hash (prob md5) of the object
+        uint64_t (*hash)(t_object *);               // Returns a (cached) 64bit hash of the object's value
         char *(*debug)(t_object *);                 // Return debug string (value and info)
+        void (*traverse)(t_object *, t_object_visit, void *);  // Visits all objects referenced by the object's data
+        int (*equals)(t_object *, t_object *);      // Returns 1 when two objects of this type hold the same value
     } t_object_funcs;
 
 
@@ -106,6 +113,14 @@
     #define OBJECT_FLAG_FINAL         64           /* Object is finalized */
     #define OBJECT_FLAG_MASK         112           /* Object flag bitmask */
 
+    // Cycle collector state, only used by the garbage collector
+    #define OBJECT_GC_GRAY          8192            /* Object is being trial-deleted */
+    #define OBJECT_GC_WHITE        16384            /* Object is only referenced from a cycle */
+    #define OBJECT_GC_GARBAGE      32768            /* Object is collected as cyclic garbage */
+    #define OBJECT_GC_BUFFERED     65536            /* Object is inside the possible roots buffer */
+    #define OBJECT_GC_CLEARED     131072            /* Object references are released by the collector */
+    #define OBJECT_GC_MASK        253952            /* Cycle collector bitmask */
+
 
 
     // Object type and flag checks
@@ -122,7 +137,7 @@
 
     // Simple macro's for object type checks
     #define OBJECT_IS_NULL(obj)         (obj->type == objectTypeNull)
-    #define OBJECT_IS_NUMERICAL(obj)    (obj->type == objectTypeNumerical)
+    #define OBJECT_IS_NUMERICAL(obj)    (OBJECT_IS_TAGGED(obj) || obj->type == objectTypeNumerical)
     #define OBJECT_IS_STRING(obj)       (obj->type == objectTypeString)
     #define OBJECT_IS_REGEX(obj)        (obj->type == objectTypeRegex)
     #define OBJECT_IS_BOOLEAN(obj)      (obj->type == objectTypeBoolean)
@@ -145,7 +160,17 @@
     #define DUP_OBJ2STR0(_obj_)  string_to_char0(((t_string_object *)_obj_)->data.value)
 
     // Fetches (long) value from a numerical object
-    #define OBJ2NUM(_obj_) (((t_numerical_object *)_obj_)->data.value)
+    #define OBJ2NUM(_obj_) (OBJECT_IS_TAGGED(_obj_) ? TAGGED2NUM(_obj_) : ((t_numerical_object *)_obj_)->data.value)
+
+
+    // Numericals can be tagged immediate values (lowest bit set) instead of allocated objects. Tagged values only live
+    // on the stack and inside the local variable slots of a frame. They are boxed into numerical objects before
+    // anything else gets hold of them.
+    #define OBJECT_TAG_NUMERICAL        1
+    #define OBJECT_IS_TAGGED(obj)       (((uintptr_t)(obj)) & OBJECT_TAG_NUMERICAL)
+    #define NUM_FITS_TAGGED(num)        ((num) >= (LONG_MIN >> 1) && (num) <= (LONG_MAX >> 1))
+    #define NUM2TAGGED(num)             ((t_object *)((((uintptr_t)(num)) << 1) | OBJECT_TAG_NUMERICAL))
+    #define TAGGED2NUM(obj)             ((long)(((intptr_t)(obj)) >> 1))
 
 
     // Number of different object types (also needed for GC queues)
@@ -235,13 +260,20 @@
     /*
      * Header macros
      */
-    #define SAFFIRE_METHOD(obj, method) static t_object *object_##obj##_method_##method(t_##obj##_object *self, t_dll *arguments)
-    #define SAFFIRE_OPERATOR_METHOD(obj, method) static t_object *object_##obj##_method_opr_##method(t_##obj##_object *self, t_dll *arguments)
-    #define SAFFIRE_COMPARISON_METHOD(obj, method) static t_object *object_##obj##_method_cmp_##method(t_##obj##_object *self, t_dll *arguments)
+    // Methods receive their arguments as a vector, which normally points into the operand stack of the caller
+    #define SAFFIRE_METHOD(obj, method) static t_object *object_##obj##_method_##method(t_##obj##_object *self, t_object **argv, int argc)
+    #define SAFFIRE_OPERATOR_METHOD(obj, method) static t_object *object_##obj##_method_opr_##method(t_##obj##_object *self, t_object **argv, int argc)
+    #define SAFFIRE_COMPARISON_METHOD(obj, method) static t_object *object_##obj##_method_cmp_##method(t_##obj##_object *self, t_object **argv, int argc)
 
-    #define SAFFIRE_METHOD_ARGS arguments
+    #define SAFFIRE_METHOD_ARGS argv, argc
 
-    #define SAFFIRE_MODULE_METHOD(mod, method) static t_object *module_##mod##_method_##method(t_object *self, t_dll *arguments)
+    #define SAFFIRE_MODULE_METHOD(mod, method) static t_object *module_##mod##_method_##method(t_object *self, t_object **argv, int argc)
+
+    // Methods that receive their arguments inside a DLL. Must be added with object_add_internal_dll_method().
+    #define SAFFIRE_DLL_METHOD(obj, method) static t_object *object_##obj##_method_##method(t_##obj##_object *self, t_dll *arguments)
+    #define SAFFIRE_DLL_MODULE_METHOD(mod, method) static t_object *module_##mod##_method_##method(t_object *self, t_dll *arguments)
+
+    #define SAFFIRE_DLL_METHOD_ARGS arguments
 
 
     // Returns custom object 'obj'
@@ -254,12 +286,16 @@
     void object_init(void);
     void object_fini(void);
 
-    int object_parse_arguments(t_dll *arguments, const char *speclist, ...);
-    int object_parse_argument_objects(t_dll *arguments, const char *speclist, ...);
+    int object_parse_arguments(t_object **argv, int argc, const char *speclist, ...);
+    int object_parse_argument_objects(t_object **argv, int argc, const char *speclist, ...);
+    int object_parse_dll_arguments(t_dll *arguments, const char *speclist, ...);
+    int object_parse_dll_argument_objects(t_dll *arguments, const char *speclist, ...);
 
     char *object_debug(t_object *obj);
+    t_object *object_alloc_memory(int type, int data_size);
     t_object *object_clone(t_object *obj);
-    char *object_get_hash(t_object *obj);
+    uint64_t object_get_hash(t_object *obj);
+    int object_equals(t_object *obj1, t_object *obj2);
 
     t_object *object_alloc_instance(t_object *obj, int arg_count, ...);
     t_object *object_alloc_class(t_object *obj, int arg_count, ...);
@@ -267,11 +303,16 @@
     void object_inc_ref(t_object *obj);
     long object_release(t_object *obj);
 
+    void object_traverse(t_object *obj, t_object_visit visit, void *arg);
+    void object_gc_clear(t_object *obj);
+    void object_gc_destroy(t_object *obj);
+
 
     void object_add_interface(t_object *class, t_object *interface);
     void object_add_property(t_object *obj, char *name, int visibility, t_object *property);
     void object_add_constant(t_object *obj, char *name, int visibility, t_object *constant);
     void object_add_internal_method(t_object *obj, char *name, int flags, int visibility, void *func);
+    void object_add_internal_dll_method(t_object *obj, char *name, int flags, int visibility, void *func);
     void object_add_internal_method_attributes(t_hash_table *attributes, t_object *obj, char *name, int flags, int visibility, void *func);
     void object_free_internal_object(t_object *obj);
 
@@ -48,13 +48,23 @@
     #define STROBJ2CHAR0LEN(obj)                        ((((t_string_object *)obj)->data.value)->len)
 
 
+    // Strings shorter than this are stored inside the string object itself
+    #define STRING_OBJECT_INLINE_SIZE   24
+
+    // Substrings are views into their parent, unless the parent is more than this many times their size
+    #define STRING_VIEW_MAX_WASTE       4
+
     typedef struct {
-        t_string *value;            // string value
-        md5_byte_t hash[16];        // (MD5) hash of the actual string
+        t_string *value;            // string value (points to string below, or NULL when not set)
+        uint64_t hash;              // Hash of the actual string
         int needs_hashing;          // 1 : string needs hashing, 0 : hash done
 
         int iter;                   // Simple iteration index on the characters
-        char *locale;               // Locale
+        char *locale;               // Locale (interned, so it is shared between strings and never freed)
+
+        t_string string;                                // Actual string, so it does not need a separate allocation
+        char inline_buf[STRING_OBJECT_INLINE_SIZE];     // Character data of short strings
+        t_object *parent;                               // String that owns the character data when this is a view
     } t_string_object_data;
 
     typedef struct {
@@ -71,6 +81,6 @@
     void object_string_fini(void);
 
 
-    int object_string_hash_compare(t_string_object *s1, t_string_object *s2);
+    t_string_object *object_string_char_at(t_string_object *str_obj, long idx);
 
 #endif
@@ -33,7 +33,12 @@
     #define RETURN_TUPLE(t)   RETURN_OBJECT(object_alloc_instance(Object_Tuple, 1, t));
 
     typedef struct {
-        t_hash_table *ht;
+        t_object **elements;        // Contiguous array with the elements of the tuple
+        long length;                // Number of elements in the tuple
+        long capacity;              // Number of allocated element slots
+        struct {
+            long idx;
+        } iter;
     } t_tuple_object_data;
 
     typedef struct {
@@ -49,4 +54,7 @@
     void object_tuple_init(void);
     void object_tuple_fini(void);
 
+    void object_tuple_reserve(t_tuple_object *tuple_obj, long capacity);
+    void object_tuple_append(t_tuple_object *tuple_obj, t_object *obj);
+
 #endif
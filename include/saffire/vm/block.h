@@ -32,6 +32,12 @@
     #define BLOCK_TYPE_LOOP             1
     #define BLOCK_TYPE_EXCEPTION        2
 
+    #define ITER_NATIVE_NONE            0
+    #define ITER_NATIVE_LIST            1
+    #define ITER_NATIVE_TUPLE           2
+    #define ITER_NATIVE_HASH            3
+    #define ITER_NATIVE_STRING          4
+
     void vm_push_block_loop(t_vm_stackframe *frame, int type, int sp, int ip, int ip_else);
     void vm_push_block_exception(t_vm_stackframe *frame, int type, int sp, int ip_catch, int ip_finally, int ip_end_finally);
     t_vm_frameblock *vm_pop_block(t_vm_stackframe *frame);
@@ -32,5 +32,8 @@
 
     t_vm_codeblock *vm_codeblock_new(t_bytecode *bytecode, t_vm_context *context);
     void vm_codeblock_destroy(t_vm_codeblock *codeblock);
+    int vm_codeblock_get_slot(t_vm_codeblock *codeblock, char *id);
+    void vm_codeblock_disassemble(t_vm_codeblock *codeblock);
+    void vm_codeblock_fini(void);
 
 #endif
@@ -35,31 +35,40 @@
     #include <saffire/vm/context.h>
 
 
+    // Increased whenever identifiers are added to or removed from a table, as this can change identifier resolving
+    extern unsigned long vm_identifier_generation;
+
     t_vm_stackframe *vm_create_empty_stackframe(void);
     t_vm_stackframe *vm_stackframe_new_scoped(t_vm_stackframe *scope_frame, t_vm_stackframe *parent_frame, t_vm_context *context, t_bytecode *bytecode);
     t_vm_stackframe *vm_stackframe_new(t_vm_stackframe *parent_frame, t_vm_codeblock *codeblock);
     void vm_stackframe_destroy(t_vm_stackframe *frame);
 
-    unsigned char vm_frame_get_next_opcode(t_vm_stackframe *frame);
-    unsigned int vm_frame_get_operand(t_vm_stackframe *frame);
+    t_vm_instruction *vm_frame_get_next_instruction(t_vm_stackframe *frame);
 
     t_object *vm_frame_stack_pop(t_vm_stackframe *frame, int resolve_attrib);
+    t_object *vm_frame_stack_pop_tagged(t_vm_stackframe *frame, int resolve_attrib);
     void vm_frame_stack_push(t_vm_stackframe *frame, t_object *obj);
     void vm_frame_stack_modify(t_vm_stackframe *frame, int idx, t_object *obj);
     t_object *vm_frame_stack_fetch_top(t_vm_stackframe *frame, int resolve_attrib);
+    t_object *vm_frame_stack_fetch(t_vm_stackframe *frame, int idx, int resolve_attrib);
+    t_object *vm_frame_stack_fetch_tagged(t_vm_stackframe *frame, int idx, int resolve_attrib);
 
     long vm_frame_get_source_line(t_vm_stackframe *frame);
 
     t_object *vm_frame_get_constant(t_vm_stackframe *frame, int idx);
+    t_symbol *vm_frame_get_constant_symbol(t_vm_stackframe *frame, int idx);
     t_object *vm_frame_get_identifier(t_vm_stackframe *frame, char *id);
     t_object *vm_frame_find_identifier(t_vm_stackframe *frame, char *id);
     t_object *vm_frame_get_global_identifier(t_vm_stackframe *frame, char *id);
     t_object *vm_frame_identifier_exists(t_vm_stackframe *frame, char *id);
+    t_object *vm_frame_find_cached_identifier(t_vm_stackframe *frame, int idx);
 
     void vm_frame_set_alias_identifier(t_vm_stackframe *frame, char *id, char *fqcn);
     void vm_frame_set_global_identifier(t_vm_stackframe *frame, char *id, t_object *obj);
     void vm_frame_set_local_identifier(t_vm_stackframe *frame, char *id, t_object *obj);
     void vm_frame_set_builtin_identifier(t_vm_stackframe *frame, char *id, t_object *obj);
+    void vm_frame_set_fast_identifier(t_vm_stackframe *frame, int idx, t_object *obj);
+    t_object *vm_frame_get_fast_identifier(t_vm_stackframe *frame, int idx);
 
     void *vm_frame_get_constant_literal(t_vm_stackframe *frame, int idx);
     char *vm_frame_get_name(t_vm_stackframe *frame, int idx);
@@ -30,6 +30,10 @@
     #include <saffire/vm/stackframe.h>
     #include <saffire/objects/objects.h>
 
+    #define THREAD_FRAME_POOL_SIZE      64          // Maximum number of destroyed frames that are kept for reuse
+    #define THREAD_STACK_SIZE        65536          // Number of object slots in the VM stack of a thread
+    #define THREAD_MAX_DEPTH        100000          // Default maximum number of nested calls
+
     /**
      * All data relevant to a single thread
      */
@@ -38,7 +42,19 @@
         t_exception_object *exception;          // Current thrown exception
         t_vm_stackframe *exception_frame;       // Snapshot of the frame on when the exception was thrown
 
-        char *locale;                           // Current global locale
+        char *locale;                           // Current global locale (interned)
+
+        long max_depth;                         // Maximum number of nested calls
+
+        t_vm_stackframe *frame_pool;            // Destroyed frames that can be reused, linked through their parent
+        int frame_pool_len;                     // Number of frames inside the frame pool
+
+        t_object **stack;                       // VM stack. Frames take their operand stack from it in LIFO order
+        long stack_len;                         // Number of slots in the VM stack
+        long stack_top;                         // First unused slot in the VM stack
+        long *stack_released;                   // Start and end slots of segments that are released out of LIFO order
+        int stack_released_len;                 // Number of segments inside stack_released
+        int stack_released_cap;                 // Number of segments that fit inside stack_released
     } t_thread;
 
     t_thread *current_thread;
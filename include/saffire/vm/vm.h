@@ -50,6 +50,7 @@
     void vm_fini(void);
     int vm_execute(t_vm_stackframe *stackframe);
     void vm_populate_builtins(const char *name, t_object *obj);
+    unsigned int vm_generic_opcode(unsigned int opcode);
 
     t_vm_stackframe *vm_execute_import(t_vm_codeblock *codeblock, t_object **result);
     t_object *call_saffire_method(t_object *self, t_attrib_object *attrib_obj, int arg_count, ...);
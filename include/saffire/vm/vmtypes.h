@@ -29,6 +29,7 @@
 
     #include <saffire/compiler/bytecode.h>
     #include <saffire/objects/objects.h>
+    #include <saffire/general/symbol.h>
 
 
     #define BLOCK_MAX_DEPTH             20          // Maximum depth of the number of blocks we can have (nested if's, for instance)
@@ -51,12 +52,73 @@
     } t_vm_context;
 
 
+    #define VM_IDENTIFIER_TABLE_LOCAL       0
+    #define VM_IDENTIFIER_TABLE_GLOBAL      1
+    #define VM_IDENTIFIER_TABLE_BUILTIN     2
+
+    /**
+     * Where an identifier was resolved. Only valid as long as its generation matches the global identifier
+     * generation. The object itself is looked up again, so stores into existing identifiers do not invalidate it.
+     */
+    typedef struct _vm_identifier_cache {
+        unsigned long generation;       // Identifier generation during resolving
+        t_hash_object *globals;         // Global identifiers of the frame that resolved the identifier
+        int table;                      // Identifier table that holds the identifier (VM_IDENTIFIER_TABLE_*)
+        t_symbol *key;                  // Key of the identifier inside the table, or NULL when not resolved
+    } t_vm_identifier_cache;
+
+    #define VM_ATTRIB_CACHE_WAYS    4     // Number of receiver classes cached for a single attribute instruction
+
+    /**
+     * A cached attribute lookup for a single receiver class.
+     */
+    typedef struct _vm_attrib_cache_entry {
+        t_object *class;                // Receiver class (or the receiver itself when it is a class), NULL when unused
+        int is_class;                   // 1 when the receiver is a class, 0 when it is an instance of the class
+        t_attrib_object *attrib;        // Attribute when owned by a class, NULL when it must be fetched from the receiver itself
+        int checked;                    // 1 when static-call, visibility and readonly checks are known to pass
+    } t_vm_attrib_cache_entry;
+
+    /**
+     * Inline cache of a LOAD_ATTRIB or STORE_ATTRIB instruction. Only valid as long as its generation matches the global attribute generation.
+     */
+    typedef struct _vm_attrib_cache {
+        unsigned long generation;       // Attribute generation during caching
+        int next;                       // Next entry to overwrite when all entries are in use
+        t_vm_attrib_cache_entry entries[VM_ATTRIB_CACHE_WAYS];
+    } t_vm_attrib_cache;
+
+    /**
+     * A decoded instruction. Every offset in the code has an entry, but only the offsets where an instruction starts
+     * are actually decoded. All others are STOP instructions.
+     */
+    typedef struct _vm_instruction {
+        unsigned int opcode;                // Opcode of the instruction
+        unsigned int oparg1;                // Operands (0 when not present)
+        unsigned int oparg2;
+        unsigned int oparg3;
+        unsigned long next;                 // Offset of the next instruction
+        void *handler;                      // Address of the opcode handler when using threaded dispatch
+        t_vm_attrib_cache *attrib_cache;    // Inline cache for LOAD_ATTRIB and STORE_ATTRIB, allocated on first execution
+        unsigned int quicken_count;         // Number of consecutive executions with operand types that can be quickened
+        unsigned int deopt_count;           // Number of times the quickened instruction fell back to its generic opcode
+    } t_vm_instruction;
+
     typedef struct _vm_codeblock {
         t_vm_context *context;          // Context of this codeblock
 
         t_bytecode *bytecode;           // Frame's bytecode
         long constants_objects_len;     // Length of the constants
         t_object **constants_objects;   // Constants taken from bytecode, converted to actual objects
+        t_symbol **constants_symbols;   // Interned string constants (NULL for other constants), used as attribute names
+        t_symbol **identifiers_symbols; // Interned identifier names, one for each bytecode identifier
+        int self_slot;                  // Local variable slot of "self", or -1 when the codeblock has none
+
+        t_vm_identifier_cache *identifier_cache;    // Resolved identifiers, one for each bytecode identifier
+
+        unsigned long instructions_len;             // Number of decoded instructions (length of the code + 1)
+        t_vm_instruction *instructions;             // Decoded instructions, indexed by the offset of the instruction in the code
+        int instructions_threaded;                  // 1 when the handlers of the instructions are resolved
     } t_vm_codeblock;
 
     typedef struct _vm_frameblock {
@@ -80,12 +142,22 @@
             int available;  // 1 if this loop has iteration data, 0 otherwise
             int count;  // Number of elements in the iterator (-1 if not available)
             int index;  // Current iteration (zero based)
+            int native; // Builtin object that is iterated without calling its methods (any of ITER_NATIVE_*), or 0
+            long pos;   // Cursor of a native list, tuple or string iteration
+            t_hash_iter ht_iter;    // Cursor of a native hash iteration
         } iter;
     } t_vm_frameblock;
 
 
     struct _vm_stackframe {
         t_vm_stackframe *parent;                    // Parent frame, or NULL when we reached the initial / global frame.
+        t_vm_stackframe *caller;                    // Calling frame when called inside the same VM loop, or NULL
+        long depth;                                 // Number of calls between this frame and the initial frame
+        long tail_calls;                            // Number of frames released by tail calls into this frame
+
+        t_object *call_attrib;                      // Called attribute, released when the frame returns to its caller
+        t_object **call_argv;                       // Arguments of the call when moved from the stack of the caller, or NULL
+        int call_argc;                              // Number of arguments of the call, released when the frame returns
 
         t_vm_codeblock *codeblock;                  // Actual codeblock
 
@@ -98,8 +170,11 @@
 
         t_object **stack;                           // Local variable stack
         int sp;                                     // Stack pointer (signed so we can detect -1 for overflow)
+        int stack_pooled;                           // 1 when the stack is a segment of the VM stack of the thread
 
-        t_hash_object *local_identifiers;           // Local identifiers (local variables, method arguments etc)
+        t_object **local_slots;                     // Local variables and method arguments, indexed by identifier
+        int local_slots_len;                        // Number of allocated local variable slots
+        t_hash_object *local_identifiers;           // Local identifiers not found in a slot (created when needed)
         t_hash_object *global_identifiers;          // Global identifiers
         t_hash_object *builtin_identifiers;         // Builtin identifiers (String, Numerical, modules etc)
 
@@ -108,8 +183,8 @@
         int block_cnt;                              // Last used block number (0 = no blocks on the stack)
         t_vm_frameblock blocks[BLOCK_MAX_DEPTH];    // Frame blocks
 
-        char *trace_class;                          // Class that is currently executed
-        char *trace_method;                         // Method that is currently executed
+        char *trace_class;                          // Class that is currently executed (borrowed, not freed)
+        char *trace_method;                         // Method that is currently executed (borrowed, not freed)
         int param_count;                            // Number of arguments
         t_object **params;                          // The arguments list (start offset on stack)
 
@@ -116,7 +116,7 @@ static void _load_or_store(int lineno, t_asm_opr *opr, t_dll *frame, t_state *st
 
 
 static void __ast_walker(t_ast_element *leaf, t_hash_table *output, t_dll *frame, t_state *state, int append_return_statement);
-static void _ast_to_frame(t_ast_element *leaf, t_hash_table *output, const char *name, int append_return_statement);
+static void _ast_to_frame(t_ast_element *leaf, t_hash_table *output, const char *name, t_ast_element *arguments, int append_return_statement);
 
 
 
@@ -497,7 +497,7 @@ static void __ast_walker(t_ast_element *leaf, t_hash_table *output, t_dll *frame
                 dll_append(frame, asm_create_codeline(leaf->lineno, VM_LOAD_CONST, 1, opr1));
 
                 // Walk the body inside a new frame!
-                _ast_to_frame(leaf->attribute.value, output, label1, append_return_statement);
+                _ast_to_frame(leaf->attribute.value, output, label1, arglist, append_return_statement);
             }
 
             if (leaf->attribute.attrib_type == ATTRIB_TYPE_CONSTANT) {
@@ -607,6 +607,15 @@ static void __ast_walker(t_ast_element *leaf, t_hash_table *output, t_dll *frame
                     WALK_LEAF(leaf->opr.ops[0]);
                     stack_pop(state->call_state);
                     stack_pop(state->context);
+
+                    // Returning the result of a call directly is a tail call. The RETURN stays, as the VM falls back
+                    // to a normal call when the frame cannot be released (like inside a try block).
+                    if (DLL_TAIL(frame)) {
+                        t_asm_line *line = DLL_DATA_PTR(DLL_TAIL(frame));
+                        if (line->type == ASM_LINE_TYPE_CODE && line->opcode == VM_CALL) {
+                            line->opcode = VM_TAIL_CALL;
+                        }
+                    }
                     dll_append(frame, asm_create_codeline(leaf->lineno, VM_RETURN, 0));
 
                     break;
@@ -1529,9 +1538,54 @@ void _ast_state_fini(t_state *state) {
 }
 
 /**
- * Initialize a new frame and walk the leaf into this frame
+ * Converts the LOAD_ID and STORE_ID opcodes for local variables inside a method frame into LOAD_FAST and STORE_FAST,
+ * which access a slot on the frame instead of the local identifier hash. Local variables are "self", the method
+ * arguments, and all identifiers that are stored somewhere inside the frame.
  */
-static void _ast_to_frame(t_ast_element *leaf, t_hash_table *output, const char *name, int append_return_statement) {
+static void _ast_frame_assign_slots(t_dll *frame, t_ast_element *arguments) {
+    t_hash_table *locals = ht_create();
+    t_dll_element *e;
+
+    ht_replace_str(locals, "self", (void *)1);
+
+    if (arguments && arguments->type == typeAstOpr && arguments->opr.oper == T_ARGUMENT_LIST) {
+        for (int i=0; i!=arguments->opr.nops; i++) {
+            t_ast_element *arg = arguments->opr.ops[i];
+            ht_replace_str(locals, arg->opr.ops[1]->string.value, (void *)1);
+        }
+    }
+
+    // Find all identifiers that are stored inside this frame
+    e = DLL_HEAD(frame);
+    while (e) {
+        t_asm_line *line = DLL_DATA_PTR(e);
+        if (line->type == ASM_LINE_TYPE_CODE && line->opcode == VM_STORE_ID && line->opr[0]->type == ASM_LINE_TYPE_OP_ID) {
+            ht_replace_str(locals, line->opr[0]->data.s, (void *)1);
+        }
+        e = DLL_NEXT(e);
+    }
+
+    // Every access to a local variable, load or store, must use the slot. Otherwise loads and stores could end up
+    // in different places.
+    e = DLL_HEAD(frame);
+    while (e) {
+        t_asm_line *line = DLL_DATA_PTR(e);
+        if (line->type == ASM_LINE_TYPE_CODE && line->opr_count == 1 && line->opr[0]->type == ASM_LINE_TYPE_OP_ID && ht_exists_str(locals, line->opr[0]->data.s)) {
+            if (line->opcode == VM_LOAD_ID) line->opcode = VM_LOAD_FAST;
+            if (line->opcode == VM_STORE_ID) line->opcode = VM_STORE_FAST;
+        }
+        e = DLL_NEXT(e);
+    }
+
+    ht_destroy(locals);
+}
+
+
+/**
+ * Initialize a new frame and walk the leaf into this frame. Arguments are the method arguments when the frame is
+ * a method body, or NULL otherwise.
+ */
+static void _ast_to_frame(t_ast_element *leaf, t_hash_table *output, const char *name, t_ast_element *arguments, int append_return_statement) {
     // Initialize state structure
     t_state *state = _ast_state_init();
 
@@ -1555,6 +1609,11 @@ static void _ast_to_frame(t_ast_element *leaf, t_hash_table *output, const char
         dll_append(frame, asm_create_codeline(0, VM_RETURN, 0));
     }
 
+    // Local variables of methods are stored in slots instead of a hash
+    if (strcmp(name, "main") != 0) {
+        _ast_frame_assign_slots(frame, arguments);
+    }
+
     // Clean up state structure
     _ast_state_fini(state);
 }
@@ -1566,7 +1625,7 @@ static void _ast_to_frame(t_ast_element *leaf, t_hash_table *output, const char
 t_hash_table *ast_to_asm(t_ast_element *ast, int append_return_statement) {
     t_hash_table *output = ht_create();
 
-    _ast_to_frame(ast, output, "main", append_return_statement);
+    _ast_to_frame(ast, output, "main", NULL, append_return_statement);
 
     return output;
 }
@@ -33,6 +33,7 @@
 #include <saffire/memory/smm.h>
 #include <saffire/general/dll.h>
 #include <saffire/vm/vm_opcodes.h>
+#include <saffire/objects/object.h>
 #include <saffire/debug.h>
 
 /**
@@ -48,6 +49,28 @@ struct _backpatch {
     char *label;
 };
 
+// A sequence of opcodes that is fused into a single superinstruction. The operands of the superinstruction are the
+// operands of the sequence, except for the scope of LOAD_ATTRIB, which must be the self scope.
+struct _superinstruction {
+    int len;                        // Number of opcodes in the sequence
+    int opcodes[3];                 // Sequence of opcodes
+    int opcode;                     // Superinstruction
+};
+
+static struct _superinstruction superinstructions[] = {
+    { 3, { VM_LOAD_ID, VM_LOAD_ATTRIB, VM_CALL }, VM_LOAD_ID_ATTRIB_CALL },
+    { 3, { VM_LOAD_ID, VM_LOAD_ID, VM_OPERATOR }, VM_LOAD_ID_ID_OPERATOR },
+    { 2, { VM_COMPARE_OP, VM_JUMP_IF_FALSE }, VM_COMPARE_JUMP_FALSE },
+    { 2, { VM_LOAD_CONST, VM_STORE_ID }, VM_LOAD_CONST_STORE_ID },
+    // Locals of method frames are already converted into local variable slots
+    { 3, { VM_LOAD_FAST, VM_LOAD_ATTRIB, VM_CALL }, VM_LOAD_FAST_ATTRIB_CALL },
+    { 3, { VM_LOAD_FAST, VM_LOAD_FAST, VM_OPERATOR }, VM_LOAD_FAST_FAST_OPERATOR },
+    { 2, { VM_LOAD_CONST, VM_STORE_FAST }, VM_LOAD_CONST_STORE_FAST },
+    { 0, { 0 }, 0 }
+};
+
+int asm_superinstructions = 1;
+
 /**
  * Calculate the maximum stack size needed for this frame (run all available paths)
  */
@@ -461,6 +484,80 @@ static void _asm_free_line(t_asm_line *line) {
     smm_free(line);
 }
 
+/**
+ * Returns 1 when the opcode sequence of the superinstruction starts at the given element
+ */
+static int _superinstruction_matches(struct _superinstruction *si, t_dll_element *e) {
+    int lineno = ((t_asm_line *)DLL_DATA_PTR(e))->lineno;
+
+    for (int i=0; i!=si->len; i++) {
+        if (! e) return 0;
+
+        t_asm_line *line = DLL_DATA_PTR(e);
+
+        // Labels can be jumped to, so we cannot fuse over them
+        if (line->type != ASM_LINE_TYPE_CODE || line->opcode != si->opcodes[i]) return 0;
+
+        // Don't lose any line numbers
+        if (line->lineno != lineno && line->lineno != 0) return 0;
+
+        // Superinstructions don't have room for the scope operand
+        if (line->opcode == VM_LOAD_ATTRIB && line->opr[1]->data.l != OBJECT_SCOPE_SELF) return 0;
+
+        e = DLL_NEXT(e);
+    }
+
+    return 1;
+}
+
+/**
+ * Peephole pass that fuses common opcode sequences of a frame into superinstructions. Labels are never fused, so
+ * backpatching is not affected.
+ */
+static void _fuse_superinstructions(t_dll *frame) {
+    t_dll_element *e = DLL_HEAD(frame);
+    while (e) {
+        for (struct _superinstruction *si = superinstructions; si->len; si++) {
+            if (! _superinstruction_matches(si, e)) continue;
+
+            t_asm_line *line = DLL_DATA_PTR(e);
+
+            // Collect the operands of the sequence. Superinstructions have at most 3 operands.
+            t_asm_opr **opr = smm_malloc(sizeof(t_asm_opr *) * 3);
+            int opr_count = 0;
+            for (int i=0; i!=line->opr_count; i++) {
+                opr[opr_count++] = line->opr[i];
+            }
+
+            for (int i=1; i!=si->len; i++) {
+                t_dll_element *next = DLL_NEXT(e);
+                t_asm_line *next_line = DLL_DATA_PTR(next);
+
+                for (int j=0; j!=next_line->opr_count; j++) {
+                    if (next_line->opcode == VM_LOAD_ATTRIB && j == 1) {
+                        _asm_free_opr(next_line->opr[j]);
+                        continue;
+                    }
+                    opr[opr_count++] = next_line->opr[j];
+                }
+
+                // Operands are moved to the superinstruction, so only free the line itself
+                next_line->opr_count = 0;
+                _asm_free_line(next_line);
+                dll_remove(frame, next);
+            }
+
+            smm_free(line->opr);
+            line->opcode = si->opcode;
+            line->opr = opr;
+            line->opr_count = opr_count;
+            break;
+        }
+
+        e = DLL_NEXT(e);
+    }
+}
+
 /**
  * Free assembler DLL structure
  */
@@ -545,6 +642,10 @@ t_bytecode *assembler(t_hash_table *asm_code, const char *filename) {
         t_dll *frame = ht_iter_value(&iter);
         char *key = ht_iter_key_str(&iter);
 
+        if (asm_superinstructions) {
+            _fuse_superinstructions(frame);
+        }
+
         t_asm_frame *assembled_frame = assemble_frame(frame, strcmp(key, "main") == 0 ? 1 : 0);
         ht_add_str(assembled_frames, key, assembled_frame);
 
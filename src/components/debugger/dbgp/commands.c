@@ -362,94 +362,111 @@ DBGP_CMD_DEF(status) {
 }
 
 /**
- *
+ * Adds a property node for the given identifier to the context response
  */
-DBGP_CMD_DEF(context_get) {
+static void _dbgp_context_add_property(xmlNodePtr root_node, char *key, t_object *obj) {
     xmlNodePtr node;
     char xmlbuf[1000];
     char *basebuf;
     size_t basebuflen;
 
-    int i = dbgp_args_find("-c", argc, argv);
-    int context_id = atoi(argv[i+1]);
+    if (obj == (t_object *)-1) {
+        node = xmlNewChild(root_node, NULL, BAD_CAST "property", NULL);
+        xmlSetProp(node, BAD_CAST "type", BAD_CAST "unresolved");
+        xmlNodeSetContent(node, BAD_CAST "unresolved");
 
-    xmlNodePtr root_node = dbgp_xml_create_response(di);
-    snprintf(xmlbuf, 999, "%d", context_id);
-    xmlSetProp(root_node, BAD_CAST "context", BAD_CAST xmlbuf);
+        xmlSetProp(node, BAD_CAST "name", BAD_CAST key);
+        xmlSetProp(node, BAD_CAST "fullname", BAD_CAST key);
+        xmlSetProp(node, BAD_CAST "classname", BAD_CAST "unresolved");
 
-    t_vm_stackframe *frame = di->frame;
+    } else if (OBJECT_TYPE_IS_INSTANCE(obj)) {
 
-    t_hash_table *ht;
-    if (context_id == 0) {
-        ht = frame->local_identifiers->data.ht;
-    } else if (context_id == 1) {
-        ht = frame->global_identifiers->data.ht;
-    } else {
-        ht = frame->builtin_identifiers->data.ht;
-    }
+        node = xmlNewChild(root_node, NULL, BAD_CAST "property", NULL);
 
-    t_hash_iter iter;
-    ht_iter_init(&iter, ht);
-    while (ht_iter_valid(&iter)) {
-        char *key = ht_iter_key_str(&iter);
-        t_object *obj = ht_iter_value(&iter);
+        if (OBJECT_IS_NUMERICAL(obj)) {
+            xmlSetProp(node, BAD_CAST "type", BAD_CAST "numerical");
 
-        if (obj == (t_object *)-1) {
-            node = xmlNewChild(root_node, NULL, BAD_CAST "property", NULL);
-            xmlSetProp(node, BAD_CAST "type", BAD_CAST "unresolved");
-            xmlNodeSetContent(node, BAD_CAST "unresolved");
+            snprintf(xmlbuf, 999, "%ld", ((t_numerical_object *)obj)->data.value);
+            xmlNodeSetContent(node, BAD_CAST xmlbuf);
 
-            xmlSetProp(node, BAD_CAST "name", BAD_CAST key);
-            xmlSetProp(node, BAD_CAST "fullname", BAD_CAST key);
-            xmlSetProp(node, BAD_CAST "classname", BAD_CAST "unresolved");
+        } else if (OBJECT_IS_NULL(obj)) {
+            xmlSetProp(node, BAD_CAST "type", BAD_CAST "null");
 
-        } else if (OBJECT_TYPE_IS_INSTANCE(obj)) {
+            xmlNodeSetContent(node, BAD_CAST "null");
 
-            node = xmlNewChild(root_node, NULL, BAD_CAST "property", NULL);
+        } else if (OBJECT_IS_BOOLEAN(obj)) {
+            xmlSetProp(node, BAD_CAST "type", BAD_CAST "boolean");
 
-            if (OBJECT_IS_NUMERICAL(obj)) {
-                xmlSetProp(node, BAD_CAST "type", BAD_CAST "numerical");
+            snprintf(xmlbuf, 999, "%s", ((t_boolean_object *)obj)->data.value ? "true" : "false");
+            xmlNodeSetContent(node, BAD_CAST xmlbuf);
 
-                snprintf(xmlbuf, 999, "%ld", ((t_numerical_object *)obj)->data.value);
-                xmlNodeSetContent(node, BAD_CAST xmlbuf);
+        } else if (OBJECT_IS_STRING(obj)) {
+            xmlSetProp(node, BAD_CAST "type", BAD_CAST "string");
 
-            } else if (OBJECT_IS_NULL(obj)) {
-                xmlSetProp(node, BAD_CAST "type", BAD_CAST "null");
+            t_string *s = ((t_string_object *)obj)->data.value;
 
-                xmlNodeSetContent(node, BAD_CAST "null");
+            // @TODO: We have to convert
+            basebuf = base64_encode((unsigned char *)STRING_CHAR0(s), STRING_LEN(s), &basebuflen);
+//                printf("basebuf: '%s'\n", basebuf);
+            xmlNodeSetContent(node, BAD_CAST basebuf);
+            free(basebuf);
+            xmlSetProp(node, BAD_CAST "encoding", BAD_CAST "base64");
 
-            } else if (OBJECT_IS_BOOLEAN(obj)) {
-                xmlSetProp(node, BAD_CAST "type", BAD_CAST "boolean");
+//            } else if (OBJECT_IS_USER(obj)) {
+//                xmlSetProp(node, BAD_CAST "type", BAD_CAST "object");
+//                xmlNodeSetContent(node, BAD_CAST "object");
 
-                snprintf(xmlbuf, 999, "%s", ((t_boolean_object *)obj)->data.value ? "true" : "false");
-                xmlNodeSetContent(node, BAD_CAST xmlbuf);
+        } else {
+            xmlSetProp(node, BAD_CAST "type", BAD_CAST "object");
+            xmlNodeSetContent(node, BAD_CAST "unknown");
+        }
 
-            } else if (OBJECT_IS_STRING(obj)) {
-                xmlSetProp(node, BAD_CAST "type", BAD_CAST "string");
+        xmlSetProp(node, BAD_CAST "name", BAD_CAST key);
+        xmlSetProp(node, BAD_CAST "fullname", BAD_CAST key);
+        xmlSetProp(node, BAD_CAST "classname", BAD_CAST obj->name);
+    }
+}
 
-                t_string *s = ((t_string_object *)obj)->data.value;
+/**
+ *
+ */
+DBGP_CMD_DEF(context_get) {
+    char xmlbuf[1000];
 
-                // @TODO: We have to convert
-                basebuf = base64_encode((unsigned char *)STRING_CHAR0(s), STRING_LEN(s), &basebuflen);
-//                printf("basebuf: '%s'\n", basebuf);
-                xmlNodeSetContent(node, BAD_CAST basebuf);
-                free(basebuf);
-                xmlSetProp(node, BAD_CAST "encoding", BAD_CAST "base64");
+    int i = dbgp_args_find("-c", argc, argv);
+    int context_id = atoi(argv[i+1]);
 
-//            } else if (OBJECT_IS_USER(obj)) {
-//                xmlSetProp(node, BAD_CAST "type", BAD_CAST "object");
-//                xmlNodeSetContent(node, BAD_CAST "object");
+    xmlNodePtr root_node = dbgp_xml_create_response(di);
+    snprintf(xmlbuf, 999, "%d", context_id);
+    xmlSetProp(root_node, BAD_CAST "context", BAD_CAST xmlbuf);
 
-            } else {
-                xmlSetProp(node, BAD_CAST "type", BAD_CAST "object");
-                xmlNodeSetContent(node, BAD_CAST "unknown");
-            }
+    t_vm_stackframe *frame = di->frame;
 
-            xmlSetProp(node, BAD_CAST "name", BAD_CAST key);
-            xmlSetProp(node, BAD_CAST "fullname", BAD_CAST key);
-            xmlSetProp(node, BAD_CAST "classname", BAD_CAST obj->name);
+    t_hash_table *ht;
+    if (context_id == 0) {
+        // Local variables stored in slots
+        for (int j=0; j!=frame->codeblock->bytecode->identifiers_len; j++) {
+            if (frame->local_slots[j] == NULL) continue;
+
+            // Slots can hold tagged numericals, which must be boxed before they can be inspected
+            t_object *obj = object_numerical_box(frame->local_slots[j]);
+            object_inc_ref(obj);
+            _dbgp_context_add_property(root_node, frame->codeblock->bytecode->identifiers[j]->s, obj);
+            object_release(obj);
         }
 
+        ht = frame->local_identifiers ? frame->local_identifiers->data.ht : NULL;
+    } else if (context_id == 1) {
+        ht = frame->global_identifiers->data.ht;
+    } else {
+        ht = frame->builtin_identifiers->data.ht;
+    }
+
+    t_hash_iter iter;
+    ht_iter_init(&iter, ht);
+    while (ht_iter_valid(&iter)) {
+        _dbgp_context_add_property(root_node, ht_iter_key_str(&iter), ht_iter_value(&iter));
+
         ht_iter_next(&iter);
     }
 
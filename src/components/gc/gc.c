@@ -25,97 +25,515 @@
  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <saffire/config.h>
 #include <saffire/objects/object.h>
 #include <saffire/objects/objects.h>
 #include <saffire/gc/gc.h>
 #include <saffire/general/mutex.h>
+#include <saffire/general/config.h>
 #include <saffire/memory/smm.h>
 #include <saffire/debug.h>
 #include <saffire/general/output.h>
 
-#define GC_OBJECT_QUEUE_SIZE        100;
+#define GC_OBJECT_QUEUE_SIZE        100
+#define GC_USER_QUEUE_COUNT         8           /* Number of different data sizes of user objects that are recycled */
+#define GC_ALLOCATION_THRESHOLD     10000       /* Number of allocations after which a collection is scheduled */
+#define GC_ROOTS_THRESHOLD          10000       /* Number of possible roots after which a collection is scheduled */
 
 typedef struct _gc_queue {
+#ifdef GC_QUEUE_LOCKING
     t_mutex mutex;          // Mutex to guard the queue
+#endif
     t_object **queue;       // Actual queue
     int index;              // Current first free item
     int size;               // Size of the queue
+    long data_size;         // Data size of the objects in this queue, or -1 when not known yet
+
+    t_gc_queue_stats stats; // Hit/miss counters
 } t_gc_queue;
 
 t_gc_queue gc_queue[OBJECT_TYPE_LEN];
 
+// User objects have different data sizes for each class, so they are recycled through a queue for each data size
+t_gc_queue gc_user_queue[GC_USER_QUEUE_COUNT];
+
+#ifdef GC_QUEUE_LOCKING
+    #define GC_QUEUE_LOCK(q)    mutex_wait_for_lock(&(q)->mutex)
+    #define GC_QUEUE_UNLOCK(q)  mutex_unlock(&(q)->mutex)
+#else
+    // The VM runs on a single thread, so there is no need to lock the queues
+    #define GC_QUEUE_LOCK(q)
+    #define GC_QUEUE_UNLOCK(q)
+#endif
+
+
+// A growing stack of objects, used for the possible roots buffer and for walking the object graph
+typedef struct _gc_stack {
+    t_object **items;
+    long count;
+    long size;
+} t_gc_stack;
+
+static t_gc_stack gc_roots;         // Containers whose reference count decreased, but did not reach 0
+static t_gc_stack gc_work;          // Objects that still need to be walked
+static t_gc_stack gc_work_black;    // Objects that still need to be walked while restoring reference counts
+
+static t_gc_stats gc_stats;
+static long gc_roots_threshold = GC_ROOTS_THRESHOLD;
+
+int gc_collect_pending = 0;
+long gc_allocations = 0;
+long gc_allocation_threshold = GC_ALLOCATION_THRESHOLD;
+
+
+static void _gc_stack_push(t_gc_stack *stack, t_object *obj) {
+    if (stack->count == stack->size) {
+        stack->size = stack->size ? stack->size * 2 : 256;
+        stack->items = smm_realloc(stack->items, sizeof(t_object *) * stack->size);
+    }
+    stack->items[stack->count++] = obj;
+}
+
+static void _gc_stack_free(t_gc_stack *stack) {
+    smm_free(stack->items);
+    stack->items = NULL;
+    stack->count = 0;
+    stack->size = 0;
+}
+
+
+/**
+ * Only allocated objects are collected. Static objects and tagged values are never part of the object graph.
+ */
+static inline int _gc_is_managed(t_object *obj) {
+    return obj && ! OBJECT_IS_TAGGED(obj) && OBJECT_IS_ALLOCATED(obj);
+}
+
+
+/**
+ * Adds a container to the possible roots buffer. Its reference count was decreased, so the remaining
+ * references could all come from a reference cycle.
+ */
+void gc_possible_root(t_object *obj) {
+    obj->flags |= OBJECT_GC_BUFFERED;
+    _gc_stack_push(&gc_roots, obj);
+
+    if (gc_roots.count >= gc_roots_threshold) {
+        gc_collect_pending = 1;
+    }
+}
+
+
+static void _gc_visit_push(t_object *obj, void *arg) {
+    if (_gc_is_managed(obj)) _gc_stack_push((t_gc_stack *)arg, obj);
+}
+
+static void _gc_visit_gray(t_object *obj, void *arg) {
+    if (! _gc_is_managed(obj)) return;
+
+    obj->ref_count--;
+    if ((obj->flags & OBJECT_GC_GRAY) == 0) {
+        obj->flags |= OBJECT_GC_GRAY;
+        _gc_stack_push(&gc_work, obj);
+    }
+}
+
+static void _gc_visit_black(t_object *obj, void *arg) {
+    if (! _gc_is_managed(obj)) return;
+
+    obj->ref_count++;
+    if ((obj->flags & (OBJECT_GC_GRAY | OBJECT_GC_WHITE)) != 0) {
+        obj->flags &= ~(OBJECT_GC_GRAY | OBJECT_GC_WHITE);
+        _gc_stack_push(&gc_work_black, obj);
+    }
+}
+
+static void _gc_visit_restore(t_object *obj, void *arg) {
+    if (_gc_is_managed(obj)) obj->ref_count++;
+}
+
+
+/**
+ * Trial-deletes all references from the object graph starting at obj. Every visited object is colored gray.
+ */
+static void _gc_mark_gray(t_object *obj) {
+    if ((obj->flags & OBJECT_GC_GRAY) == OBJECT_GC_GRAY) return;
+
+    obj->flags |= OBJECT_GC_GRAY;
+    _gc_stack_push(&gc_work, obj);
+    while (gc_work.count) {
+        t_object *cur = gc_work.items[--gc_work.count];
+        object_traverse(cur, _gc_visit_gray, NULL);
+    }
+}
+
+
+/**
+ * The object is still referenced from outside the graph: restore the references of everything it can reach
+ */
+static void _gc_scan_black(t_object *obj) {
+    obj->flags &= ~(OBJECT_GC_GRAY | OBJECT_GC_WHITE);
+    _gc_stack_push(&gc_work_black, obj);
+    while (gc_work_black.count) {
+        t_object *cur = gc_work_black.items[--gc_work_black.count];
+        object_traverse(cur, _gc_visit_black, NULL);
+    }
+}
+
 
 /**
- * Do garbage collection
+ * Gray objects that are still referenced become black again, all others are colored white
  */
-void gc_collect(void) {
-    DEBUG_PRINT_CHAR("gc_collect()");
+static void _gc_scan(t_object *obj) {
+    _gc_stack_push(&gc_work, obj);
+    while (gc_work.count) {
+        t_object *cur = gc_work.items[--gc_work.count];
+        if ((cur->flags & OBJECT_GC_GRAY) == 0) continue;
+
+        if (cur->ref_count > 0) {
+            _gc_scan_black(cur);
+            continue;
+        }
+
+        cur->flags &= ~OBJECT_GC_GRAY;
+        cur->flags |= OBJECT_GC_WHITE;
+        object_traverse(cur, _gc_visit_push, &gc_work);
+    }
+}
+
+
+/**
+ * Moves all white objects reachable from obj into the garbage stack
+ */
+static void _gc_collect_white(t_object *obj, t_gc_stack *garbage) {
+    _gc_stack_push(&gc_work, obj);
+    while (gc_work.count) {
+        t_object *cur = gc_work.items[--gc_work.count];
+        if ((cur->flags & (OBJECT_GC_WHITE | OBJECT_GC_GARBAGE | OBJECT_GC_BUFFERED)) != OBJECT_GC_WHITE) continue;
+
+        cur->flags |= OBJECT_GC_GARBAGE;
+        _gc_stack_push(garbage, cur);
+        object_traverse(cur, _gc_visit_push, &gc_work);
+    }
 }
 
 
 /**
- * recylces an object from the specified queue
+ * Collects reference cycles through trial deletion (Bacon & Rajan). Every possible root is trial-deleted
+ * together with everything it references. Objects whose reference count drops to 0 are only referenced from
+ * inside the graph, and are freed. Returns the number of collected objects.
  */
-t_object *gc_queue_recycle(int type) {
+long gc_collect(void) {
+    struct timeval start, end;
+    gettimeofday(&start, NULL);
+
+    gc_collect_pending = 0;
+    gc_allocations = 0;
+
+    // Take over the roots. Containers that are released while collecting are buffered again for the next run.
+    t_gc_stack roots = gc_roots;
+    memset(&gc_roots, 0, sizeof(t_gc_stack));
+
+    // Destroy roots that were freed while being buffered, and trial-delete the others
+    long count = 0;
+    for (long i=0; i!=roots.count; i++) {
+        t_object *obj = roots.items[i];
+        if (obj->ref_count == 0) {
+            object_gc_destroy(obj);
+            continue;
+        }
+
+        roots.items[count++] = obj;
+        _gc_mark_gray(obj);
+    }
+    roots.count = count;
+
+    for (long i=0; i!=roots.count; i++) {
+        _gc_scan(roots.items[i]);
+    }
+
+    for (long i=0; i!=roots.count; i++) {
+        roots.items[i]->flags &= ~OBJECT_GC_BUFFERED;
+    }
+
+    t_gc_stack garbage = { NULL, 0, 0 };
+    for (long i=0; i!=roots.count; i++) {
+        _gc_collect_white(roots.items[i], &garbage);
+    }
+    _gc_stack_free(&roots);
+
+    // Restore the trial-deleted references, and hold on to all garbage so nothing is destroyed while the cycles
+    // are being broken.
+    for (long i=0; i!=garbage.count; i++) {
+        object_traverse(garbage.items[i], _gc_visit_restore, NULL);
+    }
+    for (long i=0; i!=garbage.count; i++) {
+        garbage.items[i]->ref_count++;
+    }
+
+    // Break the cycles. Every object releases what it references, including the other garbage objects.
+    for (long i=0; i!=garbage.count; i++) {
+        object_gc_clear(garbage.items[i]);
+    }
+
+    // Only our own reference is left, so releasing the garbage will destroy it
+    for (long i=0; i!=garbage.count; i++) {
+        object_release(garbage.items[i]);
+    }
+
+    count = garbage.count;
+    _gc_stack_free(&garbage);
+
+    gettimeofday(&end, NULL);
+    long pause = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_usec - start.tv_usec);
+
+    gc_stats.runs++;
+    gc_stats.collected += count;
+    gc_stats.last_collected = count;
+    gc_stats.last_pause = pause;
+    gc_stats.total_pause += pause;
+
+#if __DEBUG_GC
+    DEBUG_PRINT_CHAR("gc_collect(): collected %ld objects in %ld usec\n", count, pause);
+#endif
+
+    return count;
+}
+
+
+/**
+ * Returns the cycle collector statistics
+ */
+void gc_get_stats(t_gc_stats *stats) {
+    *stats = gc_stats;
+    stats->roots = gc_roots.count;
+}
+
+
+/**
+ * Returns the queue for objects of the given type and data size. For user objects this is the queue that holds
+ * objects of the data size. When there is none and claim is set, an unused user queue is claimed for the data size.
+ * Otherwise NULL is returned.
+ */
+static t_gc_queue *_gc_find_queue(int type, long data_size, int claim) {
+    if (type != objectTypeUser) {
+        return &gc_queue[type];
+    }
+
+    for (int i=0; i!=GC_USER_QUEUE_COUNT; i++) {
+        t_gc_queue *q = &gc_user_queue[i];
+
+        GC_QUEUE_LOCK(q);
+        if (claim && q->data_size == -1) {
+            q->data_size = data_size;
+        }
+        int found = (q->data_size == data_size);
+        GC_QUEUE_UNLOCK(q);
+
+        if (found) return q;
+    }
+
+    return NULL;
+}
+
+
+/**
+ * Recycles an object with the given data size from the specified queue. Returns NULL when no object is available.
+ */
+t_object *gc_queue_recycle(int type, long data_size) {
     // Check bounds for type
     if (type < 0 || type >= OBJECT_TYPE_LEN) {
         return NULL;
     }
 
-    // Lock mutex for this queue
-    mutex_wait_for_lock(&gc_queue[type].mutex);
+    t_gc_queue *q = _gc_find_queue(type, data_size, 0);
+    if (! q) {
+        // User objects without a queue of their own are counted in the first user queue
+        GC_QUEUE_LOCK(&gc_user_queue[0]);
+        gc_user_queue[0].stats.misses++;
+        GC_QUEUE_UNLOCK(&gc_user_queue[0]);
+        return NULL;
+    }
+
+    GC_QUEUE_LOCK(q);
 
     t_object *obj = NULL;
-    if (gc_queue[type].index > 0) {
-        gc_queue[type].index--;
-        obj = gc_queue[type].queue[gc_queue[type].index];
+    if (q->index > 0 && q->data_size == data_size) {
+        q->index--;
+        obj = q->queue[q->index];
+        q->stats.hits++;
+    } else {
+        q->stats.misses++;
     }
 
-    // Unlock mutex
-    mutex_unlock(&gc_queue[type].mutex);
+    GC_QUEUE_UNLOCK(q);
 
     return obj;
 }
 
 
 /**
- * Try and adds object to the end of the queue. Returns 1 on success, 0 when queue is full
+ * Try and adds object to the end of the queue. Returns 1 on success, 0 when queue is full or the object
+ * cannot be recycled.
  */
 int gc_queue_add(t_object *obj) {
-    int ret;
+    int ret = 0;
+
+    if (obj->type < 0 || obj->type >= OBJECT_TYPE_LEN) {
+        return 0;
+    }
+
+    t_gc_queue *q = _gc_find_queue(obj->type, obj->data_size, 1);
+    if (! q) {
+        GC_QUEUE_LOCK(&gc_user_queue[0]);
+        gc_user_queue[0].stats.discarded++;
+        GC_QUEUE_UNLOCK(&gc_user_queue[0]);
+        return 0;
+    }
 
-    // @TODO: There is no sanity check to see if obj->type is between 0 and OBJECT_TYPE_LEN!
+    GC_QUEUE_LOCK(q);
 
-    // Lock mutex for this queue
-    mutex_wait_for_lock(&gc_queue[obj->type].mutex);
+    // All objects in a queue must be of the same size, so they can be used for any allocation of this type
+    if (q->data_size == -1) {
+        q->data_size = obj->data_size;
+    }
 
     // Add to recycle queue
-    if (gc_queue[obj->type].index < gc_queue[obj->type].size) {
-        gc_queue[obj->type].queue[gc_queue[obj->type].index] = obj;
-        gc_queue[obj->type].index++;
+    if (q->index < q->size && q->data_size == obj->data_size) {
+        q->queue[q->index] = obj;
+        q->index++;
+        q->stats.recycled++;
         ret = 1;
     } else {
-        ret = 0;
+        q->stats.discarded++;
     }
 
-    // Unlock mutex
-    mutex_unlock(&gc_queue[obj->type].mutex);
+    GC_QUEUE_UNLOCK(q);
 
     return ret;
 }
 
 
+/**
+ * Returns the statistics for the queue of the given type. Returns 0 when the type is invalid.
+ */
+int gc_queue_stats(int type, t_gc_queue_stats *stats) {
+    if (type < 0 || type >= OBJECT_TYPE_LEN) {
+        return 0;
+    }
+
+    if (type != objectTypeUser) {
+        GC_QUEUE_LOCK(&gc_queue[type]);
+        *stats = gc_queue[type].stats;
+        stats->queued = gc_queue[type].index;
+        stats->size = gc_queue[type].size;
+        GC_QUEUE_UNLOCK(&gc_queue[type]);
+
+        return 1;
+    }
+
+    // The statistics of user objects are the totals of all user queues
+    memset(stats, 0, sizeof(t_gc_queue_stats));
+    for (int i=0; i!=GC_USER_QUEUE_COUNT; i++) {
+        t_gc_queue *q = &gc_user_queue[i];
+
+        GC_QUEUE_LOCK(q);
+        stats->hits += q->stats.hits;
+        stats->misses += q->stats.misses;
+        stats->recycled += q->stats.recycled;
+        stats->discarded += q->stats.discarded;
+        stats->queued += q->index;
+        stats->size += q->size;
+        GC_QUEUE_UNLOCK(q);
+    }
+
+    return 1;
+}
+
+
+/**
+ * Returns the configured queue size for the given type. Uses "gc.queue.size.<type>" when present, otherwise
+ * "gc.queue.size", otherwise the default size.
+ */
+static int _gc_queue_size(int type) {
+    char key[64];
+
+    snprintf(key, sizeof(key), "gc.queue.size.%s", objectTypeNames[type]);
+    char *val = config_get_string(key, NULL);
+    if (! val) {
+        val = config_get_string("gc.queue.size", NULL);
+    }
+    if (! val) {
+        return GC_OBJECT_QUEUE_SIZE;
+    }
+
+    long size = atol(val);
+    return size < 0 ? 0 : (int)size;
+}
+
+
+/**
+ * Initializes an empty recycle queue that can hold size objects
+ */
+static void _gc_queue_create(t_gc_queue *q, int size) {
+#ifdef GC_QUEUE_LOCKING
+    mutex_create(&q->mutex);
+#endif
+    q->size = size;
+    q->queue = smm_malloc(sizeof(t_object *) * (size ? size : 1));
+    q->index = 0;
+    q->data_size = -1;
+    memset(&q->stats, 0, sizeof(t_gc_queue_stats));
+}
+
+
+/**
+ * Frees a recycle queue and the objects inside it
+ */
+static void _gc_queue_destroy(t_gc_queue *q) {
+    // Objects inside the queue are already freed, only their memory is left
+    while (q->index > 0) {
+        q->index--;
+        smm_free(q->queue[q->index]);
+    }
+
+#ifdef GC_QUEUE_LOCKING
+    mutex_destroy(&q->mutex);
+#endif
+    smm_free(q->queue);
+
+    // Objects freed from now on are destroyed directly
+    q->queue = NULL;
+    q->size = 0;
+}
+
+
+/**
+ * Returns a numerical setting from the configuration, or the default value when it's not present
+ */
+static long _gc_config_long(const char *key, long default_value) {
+    char *val = config_get_string(key, NULL);
+    return val ? atol(val) : default_value;
+}
+
+
 /**
  *
  */
 void gc_init(void) {
+    gc_allocation_threshold = _gc_config_long("gc.threshold.allocations", GC_ALLOCATION_THRESHOLD);
+    gc_roots_threshold = _gc_config_long("gc.threshold.roots", GC_ROOTS_THRESHOLD);
+    memset(&gc_stats, 0, sizeof(t_gc_stats));
+
     // Create all queues
     for (int i=0; i!=OBJECT_TYPE_LEN; i++) {
-        mutex_create(&gc_queue[i].mutex);
-        gc_queue[i].size = GC_OBJECT_QUEUE_SIZE;
-
-        gc_queue[i].queue = smm_malloc(sizeof(t_object *) * gc_queue[i].size);
-        gc_queue[i].index = 0;
+        _gc_queue_create(&gc_queue[i], _gc_queue_size(i));
+    }
+    for (int i=0; i!=GC_USER_QUEUE_COUNT; i++) {
+        _gc_queue_create(&gc_user_queue[i], _gc_queue_size(objectTypeUser));
     }
 }
 
@@ -124,8 +542,29 @@ void gc_init(void) {
  *
  */
 void gc_fini(void) {
+    // Destroy objects that were freed while being buffered. Other roots are still in use, so we cannot touch them.
+    for (long i=0; i!=gc_roots.count; i++) {
+        t_object *obj = gc_roots.items[i];
+        if (obj->ref_count == 0) {
+            object_gc_destroy(obj);
+        } else {
+            obj->flags &= ~OBJECT_GC_BUFFERED;
+        }
+    }
+    _gc_stack_free(&gc_roots);
+    _gc_stack_free(&gc_work);
+    _gc_stack_free(&gc_work_black);
+
     for (int i=0; i!=OBJECT_TYPE_LEN; i++) {
-        mutex_destroy(&gc_queue[i].mutex);
-        smm_free(gc_queue[i].queue);
+#if __DEBUG_GC_QUEUE
+        t_gc_queue_stats stats;
+        gc_queue_stats(i, &stats);
+        DEBUG_PRINT_CHAR("GC queue %-10s: %ld hits, %ld misses, %ld recycled, %ld discarded\n", objectTypeNames[i], stats.hits, stats.misses, stats.recycled, stats.discarded);
+#endif
+
+        _gc_queue_destroy(&gc_queue[i]);
+    }
+    for (int i=0; i!=GC_USER_QUEUE_COUNT; i++) {
+        _gc_queue_destroy(&gc_user_queue[i]);
     }
 }
@@ -35,30 +35,69 @@
  * These hash tables are not reentrant, nor threadsafe!
  */
 
-static hash_t ht_hash(t_hash_table *ht, t_hash_key *key) {
-    hash_t hash_value = 0;
-    if (! ht) return 0;      // Not a hash table
+/**
+ * Returns non-zero when the stored key in the bucket equals the given key
+ */
+static int key_equals(t_hash_table_bucket *htb, t_hash_key *key, hash_t hash_value) {
+    return htb->hash == hash_value && ht_key_equals(&htb->key, key);
+}
 
-    switch (key->type) {
-        case HASH_KEY_STR :
-            hash_value = ht->hashfuncs->hash(ht, (const char *)key->val.s);
-            break;
-        case HASH_KEY_NUM :
-            hash_value = key->val.n;
-            break;
-        case HASH_KEY_OBJ :
-            hash_value = ht->hashfuncs->hash(ht, (const char *)object_get_hash((t_object *)(key->val.o)));
-            break;
-        case HASH_KEY_PTR :
-            hash_value = (uintptr_t)key->val.p;
+/**
+ * Large tables are not rehashed in one go, as that would stall the unlucky operation that triggered the resize.
+ * Instead, the old bucket list is kept around and every following operation migrates a few of its buckets to the
+ * new list. Until all buckets are migrated, lookups consult both lists.
+ */
+#define CHF_INCREMENTAL_THRESHOLD   1024        // Tables with more buckets than this are rehashed incrementally
+#define CHF_REHASH_STEPS               4        // Number of old buckets migrated per operation
+#define CHF_REHASH_EMPTY_VISITS       40        // Maximum number of empty old buckets visited per operation
+#define CHF_GROWTH_CAP           1048576        // Never grow with more than this number of buckets at once
+
+
+/**
+ * Moves all elements of a bucket chain to their bucket in the current bucket list
+ */
+static void migrate_chain(t_hash_table *ht, t_hash_table_bucket *htb) {
+    while (htb) {
+        t_hash_table_bucket *next = htb->next_in_bucket;
+
+        hash_t hash_capped = htb->hash % ht->bucket_count;
+        htb->next_in_bucket = ht->bucket_list[hash_capped];       // just add the element in front of the line
+        ht->bucket_list[hash_capped] = htb;
+
+        htb = next;
+    }
+}
+
+/**
+ * Migrate (at most) the given number of buckets from the old bucket list
+ */
+static void rehash_step(t_hash_table *ht, long steps) {
+    long empty_visits = steps * (CHF_REHASH_EMPTY_VISITS / CHF_REHASH_STEPS);
+
+    while (steps && ht->rehash_idx < ht->old_bucket_count) {
+        t_hash_table_bucket *htb = ht->old_bucket_list[ht->rehash_idx];
+        ht->old_bucket_list[ht->rehash_idx] = NULL;
+        ht->rehash_idx++;
+
+        if (htb) {
+            migrate_chain(ht, htb);
+            steps--;
+        } else if (--empty_visits == 0) {
             break;
+        }
     }
 
-    return hash_value;
+    // All done, we don't need the old bucket list anymore
+    if (ht->rehash_idx == ht->old_bucket_count) {
+        smm_free(ht->old_bucket_list);
+        ht->old_bucket_list = NULL;
+        ht->old_bucket_count = 0;
+        ht->rehash_idx = 0;
+    }
 }
 
 /**
- * Resize the hashtable, and rehash all values
+ * Resize the hashtable, and rehash all values (or start migrating them for large tables)
  */
 static void chf_resize(t_hash_table *ht, int new_bucket_count) {
     if (ht->bucket_count == 0) {
@@ -69,76 +108,77 @@ static void chf_resize(t_hash_table *ht, int new_bucket_count) {
         return;
     }
 
-    // Resize bucket index
-    t_hash_table_bucket **new_bucket_list = smm_malloc(sizeof(t_hash_table_bucket *) * new_bucket_count);
-    bzero(new_bucket_list, sizeof(t_hash_table_bucket *) * new_bucket_count);
-
-    // We only have to rehash the first elements for each bucket // @TODO: NO WE CANT. REHASH ALL THE ELEMENTS!
-    t_hash_table_bucket *htb = ht->head;
-    while (htb) {
-        hash_t hash_capped = htb->hash % new_bucket_count;
-        htb->next_in_bucket = new_bucket_list[hash_capped];       // just add the element in front of the line
-        new_bucket_list[hash_capped] = htb;
-        htb = htb->next_element;
+    // Finish a migration that is still in progress, so there are never more than two bucket lists
+    if (ht->old_bucket_list) {
+        rehash_step(ht, ht->old_bucket_count);
     }
 
-    // Free our "old" bucket-list
-    smm_free(ht->bucket_list);
+    // Resize bucket index
+    t_hash_table_bucket **new_bucket_list = smm_zalloc(sizeof(t_hash_table_bucket *) * new_bucket_count);
+
+    t_hash_table_bucket **old_bucket_list = ht->bucket_list;
+    unsigned int old_bucket_count = ht->bucket_count;
 
     // Set the new bucket-list
     ht->bucket_list = new_bucket_list;
     ht->bucket_count = new_bucket_count;
 
-    // @TODO: If bucket count reaches a certain limit, don't increase expansion, but use a constant one. Basically
-    //        it means that after a threshold, the resize_factor should become 1.00
+    if (old_bucket_count > CHF_INCREMENTAL_THRESHOLD) {
+        // Migrate the buckets on the following operations
+        ht->old_bucket_list = old_bucket_list;
+        ht->old_bucket_count = old_bucket_count;
+        ht->rehash_idx = 0;
+        return;
+    }
+
+    // Small table, just rehash all the elements right away
+    for (unsigned int i = 0; i != old_bucket_count; i++) {
+        migrate_chain(ht, old_bucket_list[i]);
+    }
+
+    // Free our "old" bucket-list
+    smm_free(old_bucket_list);
 }
 
 
 /**
- * Return bucket for specified key
+ * Returns the link (either in the bucket list, the old bucket list or the previous element) that points to the
+ * bucket with the specified key, or NULL when the key is not found.
  */
-static t_hash_table_bucket *find_bucket(t_hash_table *ht, t_hash_key *key) {
-    // Locate the hash value in the bucket list.
-    hash_t hash_value = ht_hash(ht, key);
-    hash_t hash_value_capped = hash_value % ht->bucket_count;
-    if (ht->bucket_list[hash_value_capped] == NULL) {
-        // Not found
-        return NULL;
+static t_hash_table_bucket **find_link(t_hash_table *ht, t_hash_key *key) {
+    // Copy-on-write tables share their bucket lists, so they cannot migrate
+    if (ht->old_bucket_list && ! ht->copy_on_write) {
+        rehash_step(ht, CHF_REHASH_STEPS);
     }
 
-    // Found bucket. Try and find the key. Traverse linked list if needed.
-    int found = 0;
-    t_hash_table_bucket *htb = ht->bucket_list[hash_value_capped];
+    hash_t hash_value = ht_key_hash(ht, key);
 
-
-    // Cache the key hashval when we are dealing with objects.
-    char *key_hash_val = NULL;
-    if (key->type == HASH_KEY_OBJ) {
-        key_hash_val = object_get_hash((t_object *)(key->val.o));
+    t_hash_table_bucket **link = &ht->bucket_list[hash_value % ht->bucket_count];
+    while (*link) {
+        if (key_equals(*link, key, hash_value)) return link;
+        link = &(*link)->next_in_bucket;
     }
 
-    while (htb) {
-        switch (key->type) {
-            case HASH_KEY_STR :
-                if (strcmp(htb->key->val.s, key->val.s) == 0) found = 1;
-                break;
-            case HASH_KEY_NUM :
-                if (htb->key->val.n == key->val.n) found = 1;
-                break;
-            case HASH_KEY_OBJ :
-                if (strcmp(object_get_hash((t_object *)(htb->key->val.o)), key_hash_val) == 0) found = 1;
-                break;
-            case HASH_KEY_PTR :
-                if (htb->key->val.p == key->val.p) found = 1;
-                break;
+    // Not found, but it could still live in a bucket that has not been migrated yet
+    if (ht->old_bucket_list) {
+        link = &ht->old_bucket_list[hash_value % ht->old_bucket_count];
+        while (*link) {
+            if (key_equals(*link, key, hash_value)) return link;
+            link = &(*link)->next_in_bucket;
         }
-        if (found) return htb;
-        htb = htb->next_in_bucket;
     }
 
     return NULL;
 }
 
+/**
+ * Return bucket for specified key
+ */
+static t_hash_table_bucket *find_bucket(t_hash_table *ht, t_hash_key *key) {
+    t_hash_table_bucket **link = find_link(ht, key);
+    return link ? *link : NULL;
+}
+
 
 /**
  * Find key in hash table
@@ -172,13 +212,17 @@ static int chf_exists(t_hash_table *ht, t_hash_key *key) {
 static int chf_add(t_hash_table *ht, t_hash_key *key, void *value) {
     if (! ht) return 0;      // Not a hash table
 
-    hash_t hash_value = ht_hash(ht, key);
+    if (ht->old_bucket_list) {
+        rehash_step(ht, CHF_REHASH_STEPS);
+    }
+
+    hash_t hash_value = ht_key_hash(ht, key);
     hash_t hash_value_capped = hash_value % ht->bucket_count;
 
     // Create bucket for new variable
-    t_hash_table_bucket *htb = (t_hash_table_bucket *)smm_malloc(sizeof(t_hash_table_bucket));
+    t_hash_table_bucket *htb = ht_bucket_alloc();
     htb->hash = hash_value;         // Store original hash value (for quick rehashing)
-    htb->key = key;
+    ht_bucket_set_key(htb, key);
 
     htb->value = value;
     htb->next_in_bucket = NULL;
@@ -212,10 +256,17 @@ static int chf_add(t_hash_table *ht, t_hash_key *key, void *value) {
     // Increase element count
     ht->element_count++;
 
-    // Calculate load_factor and resize if needed
+    // Calculate load_factor and resize if needed. We don't resize while still migrating from a previous resize,
+    // the load factor is allowed to exceed a bit until that is done.
     float lf = ht->element_count / (float)ht->bucket_count;
-    if (lf > ht->load_factor) {
-        chf_resize(ht, floor(ht->bucket_count * ht->resize_factor));
+    if (lf > ht->load_factor && ! ht->old_bucket_list) {
+        unsigned long new_bucket_count = floor(ht->bucket_count * ht->resize_factor);
+
+        // Very large tables grow linearly instead of exponentially
+        if (new_bucket_count > ht->bucket_count + CHF_GROWTH_CAP) {
+            new_bucket_count = ht->bucket_count + CHF_GROWTH_CAP;
+        }
+        chf_resize(ht, new_bucket_count);
     }
 
     return 1;
@@ -250,39 +301,13 @@ static void *chf_remove(t_hash_table *ht, t_hash_key *key) {
 
     t_hash_table_bucket *prev, *next;
 
-    hash_t hash_value = ht_hash(ht, key);
-    hash_t hash_value_capped = hash_value % ht->bucket_count;
-
-    // Nothing to remove if nothing was found
-    if (ht->bucket_list[hash_value_capped] == NULL) return 0;
-
-    // Traverse list to find actual element
-    t_hash_table_bucket *prev_htb = NULL;   // Keep a reference to the previous element in the bucket
-    t_hash_table_bucket *htb = ht->bucket_list[hash_value_capped];
-    while (htb) {
-        int found = 0;
-        switch (htb->key->type) {
-            case HASH_KEY_STR :
-                found = strcmp(htb->key->val.s, key->val.s) == 0;
-                break;
-            case HASH_KEY_NUM :
-                found = htb->key->val.n == key->val.n;
-                break;
-            case HASH_KEY_OBJ :
-                found = strcmp(object_get_hash((t_object *)(htb->key->val.o)), object_get_hash((t_object *)(key->val.o)));
-                break;
-            case HASH_KEY_PTR :
-                found = htb->key->val.p == key->val.p;
-                break;
-        }
-        if (found) break;
-        prev_htb = htb;
-        htb = htb->next_in_bucket;
-    }
+    // Find the link to the bucket, so we can unlink it from the bucket list it lives in
+    t_hash_table_bucket **link = find_link(ht, key);
 
-    // Key is still not found
-    if (!htb) return 0;
+    // Key is not found
+    if (! link) return 0;
 
+    t_hash_table_bucket *htb = *link;
     val = htb->value;
 
 
@@ -296,14 +321,8 @@ static void *chf_remove(t_hash_table *ht, t_hash_key *key) {
         ht->tail = htb->prev_element;
     }
 
-    // Check if we removed the first element of the bucket
-    if (prev_htb == NULL) {
-        // First element, so we need to "relink" the bucket
-        ht->bucket_list[hash_value_capped] = ht->bucket_list[hash_value_capped]->next_in_bucket;
-    } else {
-        // Otherwise, it's in the middle or at the end of the bucket, make sure it's connected correctly
-        prev_htb->next_in_bucket = htb->next_in_bucket;
-    }
+    // Remove the element from the bucket
+    *link = htb->next_in_bucket;
 
     // Remove the element from the element LL
     prev = htb->prev_element;
@@ -313,8 +332,8 @@ static void *chf_remove(t_hash_table *ht, t_hash_key *key) {
 
 
     // Free key and bucket
-    ht_key_free(htb->key);
-    smm_free(htb);
+    ht_bucket_free_key(htb);
+    ht_bucket_free(htb);
 
     // Decrease element count
     ht->element_count--;
@@ -325,9 +344,9 @@ static void *chf_remove(t_hash_table *ht, t_hash_key *key) {
 }
 
 t_hash_table_bucket *_copy_bucket(t_hash_table_bucket *bucket) {
-    t_hash_table_bucket *copy = smm_malloc(sizeof(t_hash_table_bucket));
+    t_hash_table_bucket *copy = ht_bucket_alloc();
 
-    copy->key = ht_key_copy(bucket->key);
+    ht_bucket_set_key(copy, &bucket->key);
     copy->value = bucket->value;
     copy->hash = bucket->hash;
 
@@ -347,11 +366,18 @@ void _place_bucket(t_hash_table *ht, t_hash_table_bucket *bucket) {
 void chf_deep_copy(t_hash_table *ht) {
     ht->copy_on_write = 0;
 
+    // All copied buckets are placed directly into the new bucket list
+    ht->old_bucket_list = NULL;
+    ht->old_bucket_count = 0;
+    ht->rehash_idx = 0;
+
     int bucket_count = ht->bucket_count;
     ht->bucket_count = 0;
     chf_resize(ht, bucket_count);
 
     t_hash_table_bucket *old_current = ht->head;
+    if (! old_current) return;
+
     ht->head = _copy_bucket(old_current);
 
     t_hash_table_bucket *new_current = ht->head;
@@ -372,6 +398,44 @@ void chf_deep_copy(t_hash_table *ht) {
     ht->tail = new_current;
 }
 
+/**
+ * Free all buckets and the bucket list
+ */
+static void chf_destroy(t_hash_table *ht) {
+    t_hash_table_bucket *bucket = ht->head;
+    while (bucket) {
+        t_hash_table_bucket *next_bucket = bucket->next_element;
+
+        ht_bucket_free_key(bucket);
+        ht_bucket_free(bucket);
+
+        bucket = next_bucket;
+    }
+
+    smm_free(ht->bucket_list);
+    smm_free(ht->old_bucket_list);
+}
+
+
+/*
+ * Iteration follows the element list, so it always returns elements in insertion order.
+ */
+static void chf_iter_seek(t_hash_iter *iter, int tail) {
+    iter->bucket = tail ? iter->ht->tail : iter->ht->head;
+}
+
+static void chf_iter_step(t_hash_iter *iter, int forward) {
+    iter->bucket = forward ? iter->bucket->next_element : iter->bucket->prev_element;
+}
+
+static t_hash_key *chf_iter_key(t_hash_iter *iter) {
+    return iter->bucket ? &iter->bucket->key : NULL;
+}
+
+static void *chf_iter_value(t_hash_iter *iter) {
+    return iter->bucket->value;
+}
+
 
 // Hash structure with our function definitions
 t_hashfuncs chained_hf = {
@@ -384,4 +448,9 @@ t_hashfuncs chained_hf = {
     chf_remove,
     chf_resize,
     chf_deep_copy,
+    chf_destroy,
+    chf_iter_seek,
+    chf_iter_step,
+    chf_iter_key,
+    chf_iter_value,
 };
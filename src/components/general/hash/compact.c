@@ -0,0 +1,381 @@
+/*
+ Copyright (c) 2012-2015, The Saffire Group
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+     * Redistributions of source code must retain the above copyright
+       notice, this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of the Saffire Group the
+       names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <string.h>
+#include <stdint.h>
+#include <saffire/general/hashtable.h>
+#include <saffire/general/hash/compact.h>
+#include <saffire/general/hash/hash_funcs.h>
+#include <saffire/memory/smm.h>
+
+/**
+ * Compact hash tables keep all elements in a dense array in insertion order. Lookups go through a small open
+ * addressed index which only holds positions into that array, so its slots are 1, 2, 4 or 8 bytes wide depending
+ * on the size of the table. Removed elements leave a marked entry behind, which is dropped on the next resize.
+ *
+ * These hash tables are not reentrant, nor threadsafe!
+ */
+
+#define COMPACT_MIN_SIZE        8               // Minimum number of index slots
+#define COMPACT_PERTURB_SHIFT   5
+
+#define SLOT_EMPTY             -1               // Index slot has never been used
+#define SLOT_DUMMY             -2               // Index slot pointed to an element that has been removed
+
+#define ENTRY_REMOVED         127               // Key type of removed entries
+
+#define ENTRY_IS_REMOVED(e)     ((e)->key.type == ENTRY_REMOVED)
+
+// Number of elements that fit in an index of the given size (2/3 of the slots)
+#define USABLE_SIZE(n)          (((n) << 1) / 3)
+
+
+static long index_get(t_compact_storage *cs, unsigned long i) {
+    switch (cs->index_width) {
+        case 1 : return ((int8_t *)cs->index)[i];
+        case 2 : return ((int16_t *)cs->index)[i];
+        case 4 : return ((int32_t *)cs->index)[i];
+    }
+    return ((int64_t *)cs->index)[i];
+}
+
+static void index_set(t_compact_storage *cs, unsigned long i, long ix) {
+    switch (cs->index_width) {
+        case 1 : ((int8_t *)cs->index)[i] = ix; return;
+        case 2 : ((int16_t *)cs->index)[i] = ix; return;
+        case 4 : ((int32_t *)cs->index)[i] = ix; return;
+    }
+    ((int64_t *)cs->index)[i] = ix;
+}
+
+
+/**
+ * Returns the position of the slot that points to the entry with the given key, or the first empty slot
+ * when the key is not found.
+ */
+static unsigned long find_slot(t_compact_storage *cs, t_hash_key *key, hash_t hash_value) {
+    unsigned long mask = cs->index_size - 1;
+    unsigned long i = hash_value & mask;
+    hash_t perturb = hash_value;
+
+    while (1) {
+        long ix = index_get(cs, i);
+        if (ix == SLOT_EMPTY) return i;
+
+        if (ix >= 0) {
+            t_compact_entry *entry = &cs->entries[ix];
+            if (entry->key.hash == hash_value && ht_key_equals(&entry->key, key)) return i;
+        }
+
+        perturb >>= COMPACT_PERTURB_SHIFT;
+        i = (i * 5 + perturb + 1) & mask;
+    }
+}
+
+/**
+ * Returns the position of a free slot for a key that is known not to be present in the index
+ */
+static unsigned long find_free_slot(t_compact_storage *cs, hash_t hash_value) {
+    unsigned long mask = cs->index_size - 1;
+    unsigned long i = hash_value & mask;
+    hash_t perturb = hash_value;
+
+    while (index_get(cs, i) >= 0) {
+        perturb >>= COMPACT_PERTURB_SHIFT;
+        i = (i * 5 + perturb + 1) & mask;
+    }
+    return i;
+}
+
+/**
+ * Returns the entry of the given key, or NULL when not found
+ */
+static t_compact_entry *find_entry(t_hash_table *ht, t_hash_key *key) {
+    t_compact_storage *cs = ht->storage;
+
+    long ix = index_get(cs, find_slot(cs, key, ht_key_hash(ht, key)));
+    if (ix < 0) return NULL;
+    return &cs->entries[ix];
+}
+
+
+/**
+ * Resize the index to (at least) the given number of slots. Removed entries are compacted away.
+ */
+static void cf_resize(t_hash_table *ht, int new_bucket_count) {
+    t_compact_storage *cs = ht->storage;
+
+    // Make sure all current elements will fit
+    unsigned long needed = (ht->element_count * 3 / 2) + 1;
+    if ((unsigned long)new_bucket_count > needed) needed = new_bucket_count;
+
+    unsigned long index_size = COMPACT_MIN_SIZE;
+    while (index_size < needed) index_size <<= 1;
+
+    t_compact_storage *new_cs = smm_malloc(sizeof(t_compact_storage));
+    new_cs->index_size = index_size;
+    if (index_size <= 128) {
+        new_cs->index_width = 1;
+    } else if (index_size <= 0x8000) {
+        new_cs->index_width = 2;
+    } else if (index_size <= 0x80000000UL) {
+        new_cs->index_width = 4;
+    } else {
+        new_cs->index_width = 8;
+    }
+
+    // Setting all bytes to 0xFF sets all slots to SLOT_EMPTY, whatever the width
+    new_cs->index = smm_malloc(index_size * new_cs->index_width);
+    memset(new_cs->index, 0xFF, index_size * new_cs->index_width);
+
+    new_cs->entries_size = USABLE_SIZE(index_size);
+    new_cs->entries = smm_malloc(sizeof(t_compact_entry) * new_cs->entries_size);
+    new_cs->entries_used = 0;
+
+    if (cs) {
+        // Move over all elements that are still present, and rebuild the index
+        for (unsigned long i = 0; i != cs->entries_used; i++) {
+            t_compact_entry *entry = &cs->entries[i];
+            if (ENTRY_IS_REMOVED(entry)) continue;
+
+            index_set(new_cs, find_free_slot(new_cs, entry->key.hash), new_cs->entries_used);
+            new_cs->entries[new_cs->entries_used++] = *entry;
+        }
+
+        smm_free(cs->index);
+        smm_free(cs->entries);
+        smm_free(cs);
+    }
+
+    ht->storage = new_cs;
+    ht->bucket_count = index_size;
+}
+
+
+/**
+ * Find key in hash table
+ */
+static void *cf_find(t_hash_table *ht, t_hash_key *key) {
+    if (! ht) return NULL;      // Not a hash table
+
+    t_compact_entry *entry = find_entry(ht, key);
+    if (! entry) return NULL;
+
+    return entry->value;
+}
+
+
+/**
+ * Check if a key exists in a hashtable
+ */
+static int cf_exists(t_hash_table *ht, t_hash_key *key) {
+    if (! ht) return 0;      // Not a hash table
+
+    return find_entry(ht, key) != NULL;
+}
+
+
+/**
+ * Add key/value pair to the hash
+ */
+static int cf_add(t_hash_table *ht, t_hash_key *key, void *value) {
+    if (! ht) return 0;      // Not a hash table
+
+    t_compact_storage *cs = ht->storage;
+    hash_t hash_value = ht_key_hash(ht, key);
+
+    // No more room in the entries array. Resize to 3 times the number of elements, so tables that have
+    // lots of removed entries will not grow
+    if (cs->entries_used == cs->entries_size) {
+        cf_resize(ht, (ht->element_count + 1) * 3);
+        cs = ht->storage;
+    }
+
+    t_compact_entry *entry = &cs->entries[cs->entries_used];
+    ht_key_store(&entry->key, key);
+    entry->key.hash = hash_value;
+    entry->value = value;
+
+    index_set(cs, find_free_slot(cs, hash_value), cs->entries_used);
+    cs->entries_used++;
+
+    ht->element_count++;
+    return 1;
+}
+
+
+/**
+ * Replace value of key, or add the key/value pair when not found
+ */
+static void *cf_replace(t_hash_table *ht, t_hash_key *key, void *value) {
+    if (! ht) return 0;      // Not a hash table
+
+    t_compact_entry *entry = find_entry(ht, key);
+    if (! entry) {
+        cf_add(ht, key, value);
+        return NULL;
+    }
+
+    void *val = entry->value;
+    entry->value = value;
+    return val;
+}
+
+
+/**
+ * Remove key from hash table
+ */
+static void *cf_remove(t_hash_table *ht, t_hash_key *key) {
+    if (! ht) return 0;      // Not a hash table
+
+    t_compact_storage *cs = ht->storage;
+
+    unsigned long slot = find_slot(cs, key, ht_key_hash(ht, key));
+    long ix = index_get(cs, slot);
+    if (ix < 0) return 0;
+
+    t_compact_entry *entry = &cs->entries[ix];
+    void *val = entry->value;
+
+    // Keep the probe sequence intact for other keys
+    index_set(cs, slot, SLOT_DUMMY);
+
+    ht_key_release(&entry->key);
+    entry->key.type = ENTRY_REMOVED;
+    entry->value = NULL;
+
+    ht->element_count--;
+    return val;
+}
+
+
+/**
+ * Make a copy of the index and entries, so the table does not share them anymore
+ */
+static void cf_deep_copy(t_hash_table *ht) {
+    ht->copy_on_write = 0;
+
+    t_compact_storage *org = ht->storage;
+    t_compact_storage *cs = smm_malloc(sizeof(t_compact_storage));
+    memcpy(cs, org, sizeof(t_compact_storage));
+
+    cs->index = smm_malloc(cs->index_size * cs->index_width);
+    memcpy(cs->index, org->index, cs->index_size * cs->index_width);
+
+    cs->entries = smm_malloc(sizeof(t_compact_entry) * cs->entries_size);
+    memcpy(cs->entries, org->entries, sizeof(t_compact_entry) * cs->entries_used);
+    for (unsigned long i = 0; i != cs->entries_used; i++) {
+        t_compact_entry *entry = &cs->entries[i];
+        if (ENTRY_IS_REMOVED(entry)) continue;
+
+        ht_key_store(&entry->key, &org->entries[i].key);
+    }
+
+    ht->storage = cs;
+}
+
+
+/**
+ * Free all keys and storage
+ */
+static void cf_destroy(t_hash_table *ht) {
+    t_compact_storage *cs = ht->storage;
+    if (! cs) return;
+
+    for (unsigned long i = 0; i != cs->entries_used; i++) {
+        t_compact_entry *entry = &cs->entries[i];
+        if (ENTRY_IS_REMOVED(entry)) continue;
+
+        ht_key_release(&entry->key);
+    }
+
+    smm_free(cs->index);
+    smm_free(cs->entries);
+    smm_free(cs);
+    ht->storage = NULL;
+}
+
+
+/*
+ * Iteration walks the entries array directly. The iterator's bucket_idx is the current entry, and is set past
+ * the end of the array when there are no more elements.
+ */
+#define ITER_END    ((unsigned long)-1)
+
+static void cf_iter_step(t_hash_iter *iter, int forward) {
+    t_compact_storage *cs = iter->ht->storage;
+
+    do {
+        if (forward) {
+            iter->bucket_idx++;
+        } else {
+            iter->bucket_idx = iter->bucket_idx == 0 ? ITER_END : iter->bucket_idx - 1;
+        }
+    } while (iter->bucket_idx < cs->entries_used && ENTRY_IS_REMOVED(&cs->entries[iter->bucket_idx]));
+}
+
+static void cf_iter_seek(t_hash_iter *iter, int tail) {
+    t_compact_storage *cs = iter->ht->storage;
+
+    if (tail) {
+        iter->bucket_idx = cs->entries_used;
+        cf_iter_step(iter, 0);
+    } else {
+        iter->bucket_idx = ITER_END;
+        cf_iter_step(iter, 1);
+    }
+}
+
+static t_hash_key *cf_iter_key(t_hash_iter *iter) {
+    t_compact_storage *cs = iter->ht->storage;
+
+    if (iter->bucket_idx >= cs->entries_used) return NULL;
+    t_compact_entry *entry = &cs->entries[iter->bucket_idx];
+    return ENTRY_IS_REMOVED(entry) ? NULL : &entry->key;
+}
+
+static void *cf_iter_value(t_hash_iter *iter) {
+    t_compact_storage *cs = iter->ht->storage;
+    return cs->entries[iter->bucket_idx].value;
+}
+
+
+// Hash structure with our function definitions
+t_hashfuncs compact_hf = {
+    hash_native,                // Use the native hashing method
+    cf_find,
+    cf_exists,
+    cf_add,
+    cf_replace,
+    cf_remove,
+    cf_resize,
+    cf_deep_copy,
+    cf_destroy,
+    cf_iter_seek,
+    cf_iter_step,
+    cf_iter_key,
+    cf_iter_value,
+};
@@ -24,6 +24,10 @@
  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
 #include <saffire/general/hash/hash_funcs.h>
 
 
@@ -36,10 +40,10 @@
 /*
  * SDBM hash
  */
-hash_t hash_native(t_hash_table *ht, const char *key) {
+hash_t hash_native(t_hash_table *ht, const char *key, size_t len) {
 	hash_t h = 0;
 
-	while (*key) h = *key++ + (h<<6) + (h<<16) - h;
+	while (len--) h = *key++ + (h<<6) + (h<<16) - h;
 
 	return h;
 }
@@ -48,13 +52,125 @@ hash_t hash_native(t_hash_table *ht, const char *key) {
 /**
  * Bernstein DJB33A hash
  */
-hash_t hash_djbx33a(t_hash_table *ht, const char *key) {
+hash_t hash_djbx33a(t_hash_table *ht, const char *key, size_t len) {
     hash_t h = 0;
 
-    for (; *key; key++) {
+    for (; len; key++, len--) {
         h = *key + (h << 5) + h;
     }
 
     return h;
 
 }
+
+
+/**
+ * FxHash (as used in rustc), which reads the key a word at a time. Its low bits are weak, so hash tables using
+ * it should mix the result further.
+ */
+hash_t hash_fx(t_hash_table *ht, const char *key, size_t len) {
+    uint64_t h = 0, w;
+
+    for (; len >= 8; key += 8, len -= 8) {
+        memcpy(&w, key, 8);
+        h = (((h << 5) | (h >> 59)) ^ w) * 0x517cc1b727220a95ULL;
+    }
+    if (len) {
+        const unsigned char *p = (const unsigned char *)key;
+        w = 0;
+        switch (len) {
+            case 7: w |= (uint64_t)p[6] << 48;
+            case 6: w |= (uint64_t)p[5] << 40;
+            case 5: w |= (uint64_t)p[4] << 32;
+            case 4: w |= (uint64_t)p[3] << 24;
+            case 3: w |= (uint64_t)p[2] << 16;
+            case 2: w |= (uint64_t)p[1] << 8;
+            case 1: w |= (uint64_t)p[0];
+        }
+        h = (((h << 5) | (h >> 59)) ^ w) * 0x517cc1b727220a95ULL;
+    }
+
+    return h;
+}
+
+
+/*
+ * SipHash-1-3 (https://131002.net/siphash/), keyed with a per-process seed so hash values of
+ * user-supplied strings cannot be predicted.
+ */
+static uint64_t siphash_k0 = 0x736f6d6570736575ULL;
+static uint64_t siphash_k1 = 0x646f72616e646f6dULL;
+static int siphash_seeded = 0;
+
+#define SIP_ROTL(x, b)  (uint64_t)(((x) << (b)) | ((x) >> (64 - (b))))
+
+#define SIP_ROUND \
+    do { \
+        v0 += v1; v1 = SIP_ROTL(v1, 13); v1 ^= v0; v0 = SIP_ROTL(v0, 32); \
+        v2 += v3; v3 = SIP_ROTL(v3, 16); v3 ^= v2; \
+        v0 += v3; v3 = SIP_ROTL(v3, 21); v3 ^= v0; \
+        v2 += v1; v1 = SIP_ROTL(v1, 17); v1 ^= v2; v2 = SIP_ROTL(v2, 32); \
+    } while (0)
+
+/**
+ * Initializes the seed for hash_siphash() from the system's random source. The seed is only set once, as
+ * changing it would invalidate the cached hashes of existing strings.
+ */
+void hash_seed_init(void) {
+    uint64_t seed[2];
+
+    if (siphash_seeded) return;
+    siphash_seeded = 1;
+
+    FILE *f = fopen("/dev/urandom", "rb");
+    if (f && fread(seed, sizeof(seed), 1, f) == 1) {
+        siphash_k0 ^= seed[0];
+        siphash_k1 ^= seed[1];
+    } else {
+        siphash_k0 ^= (uint64_t)time(NULL);
+        siphash_k1 ^= (uint64_t)getpid();
+    }
+    if (f) fclose(f);
+}
+
+/**
+ * Returns the seeded 64bit SipHash-1-3 of the given (binary safe) string
+ */
+uint64_t hash_siphash(const char *key, size_t len) {
+    const unsigned char *p = (const unsigned char *)key;
+    const unsigned char *end = p + (len & ~7);
+    uint64_t v0 = siphash_k0 ^ 0x736f6d6570736575ULL;
+    uint64_t v1 = siphash_k1 ^ 0x646f72616e646f6dULL;
+    uint64_t v2 = siphash_k0 ^ 0x6c7967656e657261ULL;
+    uint64_t v3 = siphash_k1 ^ 0x7465646279746573ULL;
+    uint64_t m, b = ((uint64_t)len) << 56;
+
+    for (; p != end; p += 8) {
+        m = (uint64_t)p[0]       | (uint64_t)p[1] << 8  | (uint64_t)p[2] << 16 | (uint64_t)p[3] << 24 |
+            (uint64_t)p[4] << 32 | (uint64_t)p[5] << 40 | (uint64_t)p[6] << 48 | (uint64_t)p[7] << 56;
+        v3 ^= m;
+        SIP_ROUND;
+        v0 ^= m;
+    }
+
+    switch (len & 7) {
+        case 7: b |= (uint64_t)p[6] << 48;
+        case 6: b |= (uint64_t)p[5] << 40;
+        case 5: b |= (uint64_t)p[4] << 32;
+        case 4: b |= (uint64_t)p[3] << 24;
+        case 3: b |= (uint64_t)p[2] << 16;
+        case 2: b |= (uint64_t)p[1] << 8;
+        case 1: b |= (uint64_t)p[0];
+    }
+
+    v3 ^= b;
+    SIP_ROUND;
+    v0 ^= b;
+
+    v2 ^= 0xff;
+    SIP_ROUND;
+    SIP_ROUND;
+    SIP_ROUND;
+
+    return v0 ^ v1 ^ v2 ^ v3;
+}
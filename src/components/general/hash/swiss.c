@@ -0,0 +1,487 @@
+/*
+ Copyright (c) 2012-2015, The Saffire Group
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+     * Redistributions of source code must retain the above copyright
+       notice, this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of the Saffire Group the
+       names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <string.h>
+#include <stdint.h>
+#include <saffire/general/hashtable.h>
+#include <saffire/general/hash/swiss.h>
+#include <saffire/general/hash/hash_funcs.h>
+#include <saffire/memory/smm.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * Swiss tables are open addressed tables with a separate control byte for every slot. A control byte holds 7 bits
+ * of the hash of the element in the slot (or marks the slot as empty or deleted), so a whole group of slots can be
+ * matched against a key with a few SSE2 instructions, and the elements themselves are only touched on a (likely)
+ * match. Slots point into a dense entries array, so iteration still returns elements in insertion order.
+ *
+ * Storage is only allocated on the first add, as lots of these tables (attributes of attributes, mostly) stay empty.
+ *
+ * These hash tables are not reentrant, nor threadsafe!
+ */
+
+#define SWISS_MIN_CAPACITY      SWISS_GROUP_WIDTH
+
+#define CTRL_EMPTY              0x80        // Slot has never been used
+#define CTRL_DELETED            0xFE        // Slot held an element that has been removed
+
+#define ENTRY_REMOVED           127         // Key type of removed entries
+
+#define ENTRY_IS_REMOVED(e)     ((e)->key.type == ENTRY_REMOVED)
+
+// 7 bits that are stored in the control byte, and the remaining bits that select the first group to probe
+#define H1(hash)                ((hash) >> 7)
+#define H2(hash)                ((uint8_t)((hash) & 0x7F))
+
+// Number of elements that fit in a table with the given capacity (7/8 of the slots)
+#define MAX_LOAD(capacity)      ((capacity) - ((capacity) >> 3))
+
+
+#ifdef __SSE2__
+
+/**
+ * Returns a bitmask of the slots in the group that have the given control byte
+ */
+static inline unsigned int group_match(const uint8_t *group, uint8_t ctrl) {
+    __m128i g = _mm_loadu_si128((const __m128i *)group);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8(ctrl)));
+}
+
+/**
+ * Returns a bitmask of the slots in the group that are empty or deleted (high bit of the control byte set)
+ */
+static inline unsigned int group_match_free(const uint8_t *group) {
+    return _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+}
+
+#else
+
+static inline unsigned int group_match(const uint8_t *group, uint8_t ctrl) {
+    unsigned int mask = 0;
+    for (int i = 0; i != SWISS_GROUP_WIDTH; i++) {
+        if (group[i] == ctrl) mask |= 1 << i;
+    }
+    return mask;
+}
+
+static inline unsigned int group_match_free(const uint8_t *group) {
+    unsigned int mask = 0;
+    for (int i = 0; i != SWISS_GROUP_WIDTH; i++) {
+        if (group[i] & 0x80) mask |= 1 << i;
+    }
+    return mask;
+}
+
+#endif
+
+
+/**
+ * Spreads the hash of a key over all bits. Numerical and pointer keys are used as-is as their hash, and pointers
+ * would otherwise always end up with the same low bits.
+ */
+static inline hash_t mix_hash(hash_t hash) {
+    uint64_t h = (uint64_t)hash * 0x9E3779B97F4A7C15ULL;
+    return (hash_t)(h ^ (h >> 32));
+}
+
+/**
+ * Sets the control byte of a slot. The first group is mirrored after the last slot, so groups can always be
+ * loaded without wrapping around.
+ */
+static inline void set_ctrl(t_swiss_storage *ss, unsigned long slot, uint8_t ctrl) {
+    ss->ctrl[slot] = ctrl;
+    ss->ctrl[((slot - SWISS_GROUP_WIDTH) & (ss->capacity - 1)) + SWISS_GROUP_WIDTH] = ctrl;
+}
+
+
+/**
+ * Stores a copy of the key in the entry. Short string keys are stored inside the entry itself, so comparing them
+ * does not need another cache line.
+ */
+static void entry_set_key(t_swiss_entry *entry, t_hash_key *key) {
+    entry->key = *key;
+    if (key->type != HASH_KEY_STR || key->interned) return;
+
+    entry->key.val.s = key->len < HT_KEY_INLINE_SIZE ? entry->key_buf : smm_malloc(key->len + 1);
+    memcpy(entry->key.val.s, key->val.s, key->len);
+    entry->key.val.s[key->len] = '\0';
+}
+
+/**
+ * Frees the key of the entry (when it was not stored inline)
+ */
+static void entry_free_key(t_swiss_entry *entry) {
+    if (entry->key.type == HASH_KEY_STR && ! entry->key.interned && entry->key.val.s != entry->key_buf) {
+        smm_free(entry->key.val.s);
+    }
+}
+
+/**
+ * Moves an entry to another location, keeping inline keys pointing to their own entry
+ */
+static void entry_move(t_swiss_entry *dst, t_swiss_entry *src) {
+    *dst = *src;
+    if (src->key.type == HASH_KEY_STR && src->key.val.s == src->key_buf) {
+        dst->key.val.s = dst->key_buf;
+    }
+}
+
+
+/**
+ * Returns the slot that holds the given key, or -1 when not found
+ */
+static long find_slot(t_swiss_storage *ss, t_hash_key *key, hash_t hash_value) {
+    unsigned long mask = ss->capacity - 1;
+    unsigned long pos = H1(hash_value) & mask;
+    unsigned long stride = 0;
+    uint8_t h2 = H2(hash_value);
+
+    while (1) {
+        const uint8_t *group = ss->ctrl + pos;
+
+        unsigned int match = group_match(group, h2);
+        while (match) {
+            unsigned long slot = (pos + __builtin_ctz(match)) & mask;
+            t_swiss_entry *entry = &ss->entries[ss->slots[slot]];
+            if (entry->key.hash == hash_value && ht_key_equals(&entry->key, key)) return slot;
+            match &= match - 1;
+        }
+
+        // An empty slot in the group means the key would have been placed here
+        if (group_match(group, CTRL_EMPTY)) return -1;
+
+        // Triangular probing visits every group once
+        stride += SWISS_GROUP_WIDTH;
+        pos = (pos + stride) & mask;
+    }
+}
+
+/**
+ * Returns the first empty or deleted slot in the probe sequence of the given hash
+ */
+static unsigned long find_free_slot(t_swiss_storage *ss, hash_t hash_value) {
+    unsigned long mask = ss->capacity - 1;
+    unsigned long pos = H1(hash_value) & mask;
+    unsigned long stride = 0;
+
+    while (1) {
+        unsigned int match = group_match_free(ss->ctrl + pos);
+        if (match) return (pos + __builtin_ctz(match)) & mask;
+
+        stride += SWISS_GROUP_WIDTH;
+        pos = (pos + stride) & mask;
+    }
+}
+
+/**
+ * Returns the entry of the given key, or NULL when not found
+ */
+static t_swiss_entry *find_entry(t_hash_table *ht, t_hash_key *key) {
+    t_swiss_storage *ss = ht->storage;
+    if (! ss) return NULL;
+
+    long slot = find_slot(ss, key, mix_hash(ht_key_hash(ht, key)));
+    if (slot < 0) return NULL;
+    return &ss->entries[ss->slots[slot]];
+}
+
+
+/**
+ * Rehash the table into (at least) the given number of slots. Removed entries are compacted away.
+ */
+static void sf_resize(t_hash_table *ht, int new_bucket_count) {
+    t_swiss_storage *ss = ht->storage;
+
+    // Nothing allocated yet. Just remember the requested size for the first add.
+    if (! ss) {
+        ht->bucket_count = new_bucket_count;
+        return;
+    }
+
+    // Make sure we have room for at least twice the current elements
+    unsigned long capacity = SWISS_MIN_CAPACITY;
+    while (capacity < (unsigned long)new_bucket_count || MAX_LOAD(capacity) < (ht->element_count + 1) * 2) {
+        capacity <<= 1;
+    }
+
+    t_swiss_storage *new_ss = smm_malloc(sizeof(t_swiss_storage));
+    new_ss->capacity = capacity;
+    new_ss->growth_left = MAX_LOAD(capacity);
+
+    new_ss->ctrl = smm_malloc(capacity + SWISS_GROUP_WIDTH);
+    memset(new_ss->ctrl, CTRL_EMPTY, capacity + SWISS_GROUP_WIDTH);
+    new_ss->slots = smm_malloc(sizeof(uint32_t) * capacity);
+
+    new_ss->entries_size = MAX_LOAD(capacity);
+    new_ss->entries = smm_malloc(sizeof(t_swiss_entry) * new_ss->entries_size);
+    new_ss->entries_used = 0;
+
+    // Move over all elements that are still present
+    for (unsigned long i = 0; i != ss->entries_used; i++) {
+        t_swiss_entry *entry = &ss->entries[i];
+        if (ENTRY_IS_REMOVED(entry)) continue;
+
+        unsigned long slot = find_free_slot(new_ss, entry->key.hash);
+        set_ctrl(new_ss, slot, H2(entry->key.hash));
+        new_ss->slots[slot] = new_ss->entries_used;
+        entry_move(&new_ss->entries[new_ss->entries_used++], entry);
+        new_ss->growth_left--;
+    }
+
+    smm_free(ss->ctrl);
+    smm_free(ss->slots);
+    smm_free(ss->entries);
+    smm_free(ss);
+
+    ht->storage = new_ss;
+    ht->bucket_count = capacity;
+}
+
+
+/**
+ * Find key in hash table
+ */
+static void *sf_find(t_hash_table *ht, t_hash_key *key) {
+    if (! ht) return NULL;      // Not a hash table
+
+    t_swiss_entry *entry = find_entry(ht, key);
+    if (! entry) return NULL;
+
+    return entry->value;
+}
+
+
+/**
+ * Check if a key exists in a hashtable
+ */
+static int sf_exists(t_hash_table *ht, t_hash_key *key) {
+    if (! ht) return 0;      // Not a hash table
+
+    return find_entry(ht, key) != NULL;
+}
+
+
+/**
+ * Add key/value pair to the hash
+ */
+static int sf_add(t_hash_table *ht, t_hash_key *key, void *value) {
+    if (! ht) return 0;      // Not a hash table
+
+    t_swiss_storage *ss = ht->storage;
+
+    if (! ss) {
+        // First element, allocate an empty storage which gets sized by the resize below
+        ss = smm_malloc(sizeof(t_swiss_storage));
+        memset(ss, 0, sizeof(t_swiss_storage));
+        ht->storage = ss;
+        sf_resize(ht, ht->bucket_count);
+        ss = ht->storage;
+
+    } else if (ss->growth_left == 0 || ss->entries_used == ss->entries_size) {
+        // Out of empty slots or entries. When lots of elements were removed, this only compacts the table.
+        sf_resize(ht, 0);
+        ss = ht->storage;
+    }
+
+    hash_t hash_value = mix_hash(ht_key_hash(ht, key));
+
+    unsigned long slot = find_free_slot(ss, hash_value);
+    if (ss->ctrl[slot] == CTRL_EMPTY) ss->growth_left--;
+    set_ctrl(ss, slot, H2(hash_value));
+    ss->slots[slot] = ss->entries_used;
+
+    t_swiss_entry *entry = &ss->entries[ss->entries_used++];
+    entry_set_key(entry, key);
+    entry->key.hash = hash_value;
+    entry->value = value;
+
+    ht->element_count++;
+    return 1;
+}
+
+
+/**
+ * Replace value of key, or add the key/value pair when not found
+ */
+static void *sf_replace(t_hash_table *ht, t_hash_key *key, void *value) {
+    if (! ht) return 0;      // Not a hash table
+
+    t_swiss_entry *entry = find_entry(ht, key);
+    if (! entry) {
+        sf_add(ht, key, value);
+        return NULL;
+    }
+
+    void *val = entry->value;
+    entry->value = value;
+    return val;
+}
+
+
+/**
+ * Remove key from hash table
+ */
+static void *sf_remove(t_hash_table *ht, t_hash_key *key) {
+    if (! ht) return 0;      // Not a hash table
+
+    t_swiss_storage *ss = ht->storage;
+    if (! ss) return 0;
+
+    long slot = find_slot(ss, key, mix_hash(ht_key_hash(ht, key)));
+    if (slot < 0) return 0;
+
+    t_swiss_entry *entry = &ss->entries[ss->slots[slot]];
+    void *val = entry->value;
+
+    // Deleted slots keep the probe sequence of other keys intact
+    set_ctrl(ss, slot, CTRL_DELETED);
+
+    entry_free_key(entry);
+    entry->key.type = ENTRY_REMOVED;
+    entry->value = NULL;
+
+    ht->element_count--;
+    return val;
+}
+
+
+/**
+ * Make a copy of the storage, so the table does not share it anymore
+ */
+static void sf_deep_copy(t_hash_table *ht) {
+    ht->copy_on_write = 0;
+
+    t_swiss_storage *org = ht->storage;
+    if (! org) return;
+
+    t_swiss_storage *ss = smm_malloc(sizeof(t_swiss_storage));
+    memcpy(ss, org, sizeof(t_swiss_storage));
+
+    ss->ctrl = smm_malloc(ss->capacity + SWISS_GROUP_WIDTH);
+    memcpy(ss->ctrl, org->ctrl, ss->capacity + SWISS_GROUP_WIDTH);
+    ss->slots = smm_malloc(sizeof(uint32_t) * ss->capacity);
+    memcpy(ss->slots, org->slots, sizeof(uint32_t) * ss->capacity);
+
+    ss->entries = smm_malloc(sizeof(t_swiss_entry) * ss->entries_size);
+    for (unsigned long i = 0; i != ss->entries_used; i++) {
+        t_swiss_entry *entry = &ss->entries[i];
+        *entry = org->entries[i];
+        if (ENTRY_IS_REMOVED(entry)) continue;
+
+        entry_set_key(entry, &org->entries[i].key);
+    }
+
+    ht->storage = ss;
+}
+
+
+/**
+ * Free all keys and storage
+ */
+static void sf_destroy(t_hash_table *ht) {
+    t_swiss_storage *ss = ht->storage;
+    if (! ss) return;
+
+    for (unsigned long i = 0; i != ss->entries_used; i++) {
+        t_swiss_entry *entry = &ss->entries[i];
+        if (ENTRY_IS_REMOVED(entry)) continue;
+
+        entry_free_key(entry);
+    }
+
+    smm_free(ss->ctrl);
+    smm_free(ss->slots);
+    smm_free(ss->entries);
+    smm_free(ss);
+    ht->storage = NULL;
+}
+
+
+/*
+ * Iteration walks the entries array. The iterator's bucket_idx is the current entry, and is set past the end of
+ * the array when there are no more elements.
+ */
+#define ITER_END    ((unsigned long)-1)
+
+static void sf_iter_step(t_hash_iter *iter, int forward) {
+    t_swiss_storage *ss = iter->ht->storage;
+
+    do {
+        if (forward) {
+            iter->bucket_idx++;
+        } else {
+            iter->bucket_idx = iter->bucket_idx == 0 ? ITER_END : iter->bucket_idx - 1;
+        }
+    } while (iter->bucket_idx < ss->entries_used && ENTRY_IS_REMOVED(&ss->entries[iter->bucket_idx]));
+}
+
+static void sf_iter_seek(t_hash_iter *iter, int tail) {
+    t_swiss_storage *ss = iter->ht->storage;
+
+    if (! ss) {
+        iter->bucket_idx = ITER_END;
+    } else if (tail) {
+        iter->bucket_idx = ss->entries_used;
+        sf_iter_step(iter, 0);
+    } else {
+        iter->bucket_idx = ITER_END;
+        sf_iter_step(iter, 1);
+    }
+}
+
+static t_hash_key *sf_iter_key(t_hash_iter *iter) {
+    t_swiss_storage *ss = iter->ht->storage;
+
+    if (! ss || iter->bucket_idx >= ss->entries_used) return NULL;
+    t_swiss_entry *entry = &ss->entries[iter->bucket_idx];
+    return ENTRY_IS_REMOVED(entry) ? NULL : &entry->key;
+}
+
+static void *sf_iter_value(t_hash_iter *iter) {
+    t_swiss_storage *ss = iter->ht->storage;
+    return ss->entries[iter->bucket_idx].value;
+}
+
+
+// Hash structure with our function definitions
+t_hashfuncs swiss_hf = {
+    hash_fx,                    // Word at a time string hash, mixed further by mix_hash()
+    sf_find,
+    sf_exists,
+    sf_add,
+    sf_replace,
+    sf_remove,
+    sf_resize,
+    sf_deep_copy,
+    sf_destroy,
+    sf_iter_seek,
+    sf_iter_step,
+    sf_iter_key,
+    sf_iter_value,
+};
@@ -28,6 +28,9 @@
 #include <string.h>
 #include <stdlib.h>
 #include <saffire/general/hashtable.h>
+#include <saffire/general/hash/swiss.h>
+#include <saffire/general/hash/hash_funcs.h>
+#include <saffire/general/symbol.h>
 #include <saffire/memory/smm.h>
 #include <saffire/general/string.h>
 #include <saffire/objects/object.h>
@@ -59,6 +62,11 @@ static t_hash_table *_ht_create(int bucket_count, float load_factor, float resiz
     ht->hashfuncs = hashfuncs;
     ht->head = NULL;
     ht->tail = NULL;
+    ht->bucket_list = NULL;
+    ht->old_bucket_list = NULL;
+    ht->old_bucket_count = 0;
+    ht->rehash_idx = 0;
+    ht->storage = NULL;
 
     ht->hashfuncs->resize(ht, bucket_count);
     return ht;
@@ -71,6 +79,13 @@ t_hash_table *ht_create(void) {
     return _ht_create(HT_INITIAL_BUCKET_COUNT, HT_LOAD_FACTOR, HT_RESIZE_FACTOR, DEFAULT_HASHFUNCS);
 }
 
+/**
+ * Create a new hash table for the runtime's lookup heavy tables (attributes, identifiers and class/module mappings)
+ */
+t_hash_table *ht_create_lookup(void) {
+    return _ht_create(HT_INITIAL_BUCKET_COUNT, HT_LOAD_FACTOR, HT_RESIZE_FACTOR, &swiss_hf);
+}
+
 /**
  * Create a new hash table with customized values
  */
@@ -102,28 +117,11 @@ t_hash_table *ht_copy(t_hash_table *ht, int copy_on_write) {
  * Free a hash table
  */
 void ht_destroy(t_hash_table *ht) {
-    t_hash_table_bucket *bucket, *next_bucket;
-
     // Nothing to free
     if (!ht) return;
 
     if (!ht->copy_on_write) {
-        // Destroy buckets
-        bucket = ht->head;
-        while (bucket) {
-            // Find next bucket
-            next_bucket = bucket->next_element;
-
-            // Now, we can safely remove bucket
-            ht_key_free(bucket->key);
-            smm_free(bucket);
-
-            // goto next bucket
-            bucket = next_bucket;
-        }
-
-        // Free bucket list array
-        smm_free(ht->bucket_list);
+        ht->hashfuncs->destroy(ht);
     }
 
 
@@ -142,29 +140,30 @@ void *ht_find(t_hash_table *ht, t_hash_key *key) {
     return ht->hashfuncs->find(ht, key);
 }
 void *ht_find_str(t_hash_table *ht, char *key) {
-    t_hash_key *hkey = ht_key_create(HASH_KEY_STR, (void *)key);
-    void *ret = ht_find(ht, hkey);
-    ht_key_free(hkey);
-    return ret;
+    t_hash_key hkey;
+    ht_key_borrow_str(&hkey, key, strlen(key));
+    return ht_find(ht, &hkey);
 }
 void *ht_find_num(t_hash_table *ht, long key) {
-    t_hash_key *hkey = ht_key_create(HASH_KEY_NUM, (void *)key);
-    void *ret = ht_find(ht, hkey);
-    ht_key_free(hkey);
-    return ret;
+    t_hash_key hkey;
+    ht_key_borrow(&hkey, HASH_KEY_NUM, (void *)key);
+    return ht_find(ht, &hkey);
 }
 void *ht_find_obj(t_hash_table *ht, t_object *key) {
-    t_hash_key *hkey = ht_key_create(HASH_KEY_OBJ, key);
-    void *ret = ht_find(ht, hkey);
-    ht_key_free(hkey);
-    return ret;
+    t_hash_key hkey;
+    ht_key_borrow(&hkey, HASH_KEY_OBJ, key);
+    return ht_find(ht, &hkey);
 }
 
 void *ht_find_ptr(t_hash_table *ht, void *key) {
-    t_hash_key *hkey = ht_key_create(HASH_KEY_PTR, key);
-    void *ret = ht_find(ht, hkey);
-    ht_key_free(hkey);
-    return ret;
+    t_hash_key hkey;
+    ht_key_borrow(&hkey, HASH_KEY_PTR, key);
+    return ht_find(ht, &hkey);
+}
+void *ht_find_sym(t_hash_table *ht, t_symbol *key) {
+    t_hash_key hkey;
+    ht_key_borrow_sym(&hkey, key);
+    return ht_find(ht, &hkey);
 }
 
 /**
@@ -174,56 +173,75 @@ int ht_exists(t_hash_table *ht, t_hash_key *key) {
     return ht->hashfuncs->exists(ht, key);
 }
 int ht_exists_str(t_hash_table *ht, char *key) {
-    t_hash_key *hkey = ht_key_create(HASH_KEY_STR, (void *)key);
-    int ret = ht_exists(ht, hkey);
-    ht_key_free(hkey);
-    return ret;
+    t_hash_key hkey;
+    ht_key_borrow_str(&hkey, key, strlen(key));
+    return ht_exists(ht, &hkey);
 }
 int ht_exists_num(t_hash_table *ht, long key) {
-    t_hash_key *hkey = ht_key_create(HASH_KEY_NUM, (void *)key);
-    int ret = ht_exists(ht, hkey);
-    ht_key_free(hkey);
-    return ret;
+    t_hash_key hkey;
+    ht_key_borrow(&hkey, HASH_KEY_NUM, (void *)key);
+    return ht_exists(ht, &hkey);
 }
 int ht_exists_obj(t_hash_table *ht, t_object *key) {
-    t_hash_key *hkey = ht_key_create(HASH_KEY_OBJ, key);
-    int ret = ht_exists(ht, hkey);
-    ht_key_free(hkey);
-    return ret;
+    t_hash_key hkey;
+    ht_key_borrow(&hkey, HASH_KEY_OBJ, key);
+    return ht_exists(ht, &hkey);
 }
 int ht_exists_ptr(t_hash_table *ht, void *key) {
-    t_hash_key *hkey = ht_key_create(HASH_KEY_PTR, key);
-    int ret = ht_exists(ht, hkey);
-    ht_key_free(hkey);
-    return ret;
+    t_hash_key hkey;
+    ht_key_borrow(&hkey, HASH_KEY_PTR, key);
+    return ht_exists(ht, &hkey);
+}
+int ht_exists_sym(t_hash_table *ht, t_symbol *key) {
+    t_hash_key hkey;
+    ht_key_borrow_sym(&hkey, key);
+    return ht_exists(ht, &hkey);
 }
 
 /**
  * Adds ht[key] = value;
- * Note that key is not duplicated.
+ * Note that the key is copied into the hash table, and the given key is freed.
  *
  * @param ht
  * @param key
  * @param value
  * @return
  */
-int ht_add(t_hash_table *ht, t_hash_key *key, void *value) {
+static int _ht_add(t_hash_table *ht, t_hash_key *key, void *value) {
     if (ht->copy_on_write) {
         ht->hashfuncs->deep_copy(ht);
     }
     return ht->hashfuncs->add(ht, key, value);
 }
+int ht_add(t_hash_table *ht, t_hash_key *key, void *value) {
+    int ret = _ht_add(ht, key, value);
+    ht_key_free(key);
+    return ret;
+}
 int ht_add_str(t_hash_table *ht, char *key, void *value) {
-    return ht_add(ht, ht_key_create(HASH_KEY_STR, (void *)key), value);
+    t_hash_key hkey;
+    ht_key_borrow_str(&hkey, key, strlen(key));
+    return _ht_add(ht, &hkey, value);
 }
 int ht_add_num(t_hash_table *ht, long key, void *value) {
-    return ht_add(ht, ht_key_create(HASH_KEY_NUM, (void *)key), value);
+    t_hash_key hkey;
+    ht_key_borrow(&hkey, HASH_KEY_NUM, (void *)key);
+    return _ht_add(ht, &hkey, value);
 }
 int ht_add_obj(t_hash_table *ht, t_object *key, void *value) {
-    return ht_add(ht, ht_key_create(HASH_KEY_OBJ, key), value);
+    t_hash_key hkey;
+    ht_key_borrow(&hkey, HASH_KEY_OBJ, key);
+    return _ht_add(ht, &hkey, value);
 }
 int ht_add_ptr(t_hash_table *ht, void *key, void *value) {
-    return ht_add(ht, ht_key_create(HASH_KEY_PTR, key), value);
+    t_hash_key hkey;
+    ht_key_borrow(&hkey, HASH_KEY_PTR, key);
+    return _ht_add(ht, &hkey, value);
+}
+int ht_add_sym(t_hash_table *ht, t_symbol *key, void *value) {
+    t_hash_key hkey;
+    ht_key_borrow_sym(&hkey, key);
+    return _ht_add(ht, &hkey, value);
 }
 
 int ht_append_num(t_hash_table *ht, void *value) {
@@ -233,7 +251,7 @@ int ht_append_num(t_hash_table *ht, void *value) {
 /**
  * Replace key/value into hashtable
  */
-void *ht_replace(t_hash_table *ht, t_hash_key *key, void *value) {
+static void *_ht_replace(t_hash_table *ht, t_hash_key *key, void *value) {
     if (ht->copy_on_write) {
         ht->hashfuncs->deep_copy(ht);
     }
@@ -250,22 +268,35 @@ void *ht_replace(t_hash_table *ht, t_hash_key *key, void *value) {
 
     return ht->hashfuncs->replace(ht, key, value);
 }
+void *ht_replace(t_hash_table *ht, t_hash_key *key, void *value) {
+    void *ret = _ht_replace(ht, key, value);
+    ht_key_free(key);
+    return ret;
+}
 void *ht_replace_str(t_hash_table *ht, char *key, void *value) {
-    t_hash_key *hkey = ht_key_create(HASH_KEY_STR, key);
-    return ht_replace(ht, hkey, value);
+    t_hash_key hkey;
+    ht_key_borrow_str(&hkey, key, strlen(key));
+    return _ht_replace(ht, &hkey, value);
 }
 void *ht_replace_num(t_hash_table *ht, long key, void *value) {
-    t_hash_key *hkey = ht_key_create(HASH_KEY_NUM, (void *)key);
-    return ht_replace(ht, hkey, value);
-
+    t_hash_key hkey;
+    ht_key_borrow(&hkey, HASH_KEY_NUM, (void *)key);
+    return _ht_replace(ht, &hkey, value);
 }
 void *ht_replace_obj(t_hash_table *ht, t_object *key, void *value) {
-    t_hash_key *hkey = ht_key_create(HASH_KEY_OBJ, key);
-    return ht_replace(ht, hkey, value);
+    t_hash_key hkey;
+    ht_key_borrow(&hkey, HASH_KEY_OBJ, key);
+    return _ht_replace(ht, &hkey, value);
 }
 void *ht_replace_ptr(t_hash_table *ht, void *key, void *value) {
-    t_hash_key *hkey = ht_key_create(HASH_KEY_PTR, key);
-    return ht_replace(ht, hkey, value);
+    t_hash_key hkey;
+    ht_key_borrow(&hkey, HASH_KEY_PTR, key);
+    return _ht_replace(ht, &hkey, value);
+}
+void *ht_replace_sym(t_hash_table *ht, t_symbol *key, void *value) {
+    t_hash_key hkey;
+    ht_key_borrow_sym(&hkey, key);
+    return _ht_replace(ht, &hkey, value);
 }
 
 /**
@@ -278,28 +309,29 @@ void *ht_remove(t_hash_table *ht, t_hash_key *key) {
     return ht->hashfuncs->remove(ht, key);
 }
 void *ht_remove_str(t_hash_table *ht, char *key) {
-    t_hash_key *hkey = ht_key_create(HASH_KEY_STR, key);
-    void *ret = ht_remove(ht, hkey);
-    ht_key_free(hkey);
-    return ret;
+    t_hash_key hkey;
+    ht_key_borrow_str(&hkey, key, strlen(key));
+    return ht_remove(ht, &hkey);
 }
 void *ht_remove_num(t_hash_table *ht, long key) {
-    t_hash_key *hkey = ht_key_create(HASH_KEY_NUM, (void *)key);
-    void *ret = ht_remove(ht, hkey);
-    ht_key_free(hkey);
-    return ret;
+    t_hash_key hkey;
+    ht_key_borrow(&hkey, HASH_KEY_NUM, (void *)key);
+    return ht_remove(ht, &hkey);
 }
 void *ht_remove_obj(t_hash_table *ht, t_object *key) {
-    t_hash_key *hkey = ht_key_create(HASH_KEY_OBJ, key);
-    void *ret = ht_remove(ht, hkey);
-    ht_key_free(hkey);
-    return ret;
+    t_hash_key hkey;
+    ht_key_borrow(&hkey, HASH_KEY_OBJ, key);
+    return ht_remove(ht, &hkey);
 }
 void *ht_remove_ptr(t_hash_table *ht, void *key) {
-    t_hash_key *hkey = ht_key_create(HASH_KEY_PTR, key);
-    void *ret = ht_remove(ht, hkey);
-    ht_key_free(hkey);
-    return ret;
+    t_hash_key hkey;
+    ht_key_borrow(&hkey, HASH_KEY_PTR, key);
+    return ht_remove(ht, &hkey);
+}
+void *ht_remove_sym(t_hash_table *ht, t_symbol *key) {
+    t_hash_key hkey;
+    ht_key_borrow_sym(&hkey, key);
+    return ht_remove(ht, &hkey);
 }
 
 /*
@@ -310,14 +342,16 @@ void *ht_remove_ptr(t_hash_table *ht, void *key) {
 int ht_iter_init(t_hash_iter *iter, t_hash_table *ht) {
     iter->ht = ht;
     iter->bucket_idx = 0;
-    iter->bucket = ht ? ht->head : NULL;
+    iter->bucket = NULL;
+    if (ht) ht->hashfuncs->iter_seek(iter, 0);
     return 1;
 }
 
 int ht_iter_init_tail(t_hash_iter *iter, t_hash_table *ht) {
     iter->ht = ht;
     iter->bucket_idx = 0;
-    iter->bucket = ht ? ht->tail : NULL;
+    iter->bucket = NULL;
+    if (ht) ht->hashfuncs->iter_seek(iter, 1);
     return 1;
 }
 
@@ -333,8 +367,7 @@ int ht_iter_rewind(t_hash_iter *iter, t_hash_table *ht) {
     // Set hash table
     if (ht != NULL) iter->ht = ht;
 
-    iter->bucket_idx = 0;
-    iter->bucket = ht->head;
+    iter->ht->hashfuncs->iter_seek(iter, 0);
 
     return 1;
 }
@@ -343,26 +376,26 @@ int ht_iter_rewind(t_hash_iter *iter, t_hash_table *ht) {
  * Return 0 when iterator is not valid (no more elements)
  */
 int ht_iter_valid(t_hash_iter *iter) {
-    return (iter->bucket != NULL);
+    return iter->ht && iter->ht->hashfuncs->iter_key(iter) != NULL;
 }
 
 /**
- * Goto next element (either inside the bucket, or the next bucket)
+ * Goto next element
  */
 int ht_iter_next(t_hash_iter *iter) {
     // Nothing found (or no more items)
-    if (iter->bucket == NULL) return 0;
+    if (! ht_iter_valid(iter)) return 0;
 
-    iter->bucket = iter->bucket->next_element;
-    return (iter->bucket != NULL);
+    iter->ht->hashfuncs->iter_step(iter, 1);
+    return ht_iter_valid(iter);
 }
 
 int ht_iter_prev(t_hash_iter *iter) {
     // Nothing found (or no more items)
-    if (iter->bucket == NULL) return 0;
+    if (! ht_iter_valid(iter)) return 0;
 
-    iter->bucket = iter->bucket->prev_element;
-    return (iter->bucket != NULL);
+    iter->ht->hashfuncs->iter_step(iter, 0);
+    return ht_iter_valid(iter);
 }
 
 
@@ -370,28 +403,36 @@ int ht_iter_prev(t_hash_iter *iter) {
  * Fetch key from current element
  */
 t_hash_key *ht_iter_key(t_hash_iter *iter) {
-    if (iter->bucket == NULL) return NULL;
-    return iter->bucket->key;
+    if (iter->ht == NULL) return NULL;
+    return iter->ht->hashfuncs->iter_key(iter);
 }
 
 char *ht_iter_key_str(t_hash_iter *iter) {
-    if (iter->bucket == NULL) return NULL;
-    return iter->bucket->key->val.s;
+    t_hash_key *key = ht_iter_key(iter);
+    return key ? key->val.s : NULL;
 }
 
 long ht_iter_key_num(t_hash_iter *iter) {
-    if (iter->bucket == NULL) return 0;
-    return iter->bucket->key->val.n;
+    t_hash_key *key = ht_iter_key(iter);
+    return key ? key->val.n : 0;
 }
 
 t_object *ht_iter_key_obj(t_hash_iter *iter) {
-    if (iter->bucket == NULL) return NULL;
-    return iter->bucket->key->val.o;
+    t_hash_key *key = ht_iter_key(iter);
+    return key ? key->val.o : NULL;
 }
 
 void *ht_iter_key_ptr(t_hash_iter *iter) {
-    if (iter->bucket == NULL) return NULL;
-    return (void *)iter->bucket->key->val.p;
+    t_hash_key *key = ht_iter_key(iter);
+    return key ? (void *)key->val.p : NULL;
+}
+
+/**
+ * Returns the symbol of the current key, or NULL when the key is not a symbol
+ */
+t_symbol *ht_iter_key_sym(t_hash_iter *iter) {
+    t_hash_key *key = ht_iter_key(iter);
+    return key && key->interned ? SYMBOL_FROM_STR(key->val.s) : NULL;
 }
 
 
@@ -399,20 +440,26 @@ void *ht_iter_key_ptr(t_hash_iter *iter) {
  * Fetch value from current element
  */
 void *ht_iter_value(t_hash_iter *iter) {
-    if (iter->bucket == NULL) return NULL;
-    return iter->bucket->value;
+    if (iter->ht == NULL || iter->ht->hashfuncs->iter_key(iter) == NULL) return NULL;
+    return iter->ht->hashfuncs->iter_value(iter);
 }
 
 
 /**
- *
+ * Initializes a key that borrows its value from the caller. The key does not need to be freed, but
+ * is only valid as long as the value it points to.
  */
-t_hash_key *ht_key_create(int type, void *val) {
-    t_hash_key *hk = (t_hash_key *)malloc(sizeof(t_hash_key));
+void ht_key_borrow(t_hash_key *hk, int type, void *val) {
+    hk->interned = 0;
+    hk->len = 0;
+    hk->hash = 0;
+    hk->hashed_by = NULL;
+
     switch (type) {
         case HASH_KEY_STR :
             hk->type = HASH_KEY_STR;
-            hk->val.s = string_strdup0((char *)val);
+            hk->val.s = (char *)val;
+            hk->len = strlen((char *)val);
             break;
         case HASH_KEY_NUM :
             hk->type = HASH_KEY_NUM;
@@ -427,7 +474,65 @@ t_hash_key *ht_key_create(int type, void *val) {
             hk->type = HASH_KEY_OBJ;
             hk->val.o = (t_object *)val;
             break;
+    }
+}
+
+/**
+ * Initializes a borrowed string key. The string does not need to be zero-terminated.
+ */
+void ht_key_borrow_str(t_hash_key *hk, const char *s, size_t len) {
+    hk->type = HASH_KEY_STR;
+    hk->interned = 0;
+    hk->val.s = (char *)s;
+    hk->len = len;
+    hk->hash = 0;
+    hk->hashed_by = NULL;
+}
+
+/**
+ * Initializes a key for a symbol. The hash of a symbol is already known, and tables store the symbol's name
+ * instead of a copy, so keys of the same symbol can be compared by pointer.
+ */
+void ht_key_borrow_sym(t_hash_key *hk, t_symbol *symbol) {
+    hk->type = HASH_KEY_STR;
+    hk->interned = 1;
+    hk->val.s = symbol->s;
+    hk->len = symbol->len;
+    hk->hash = symbol->hash;
+    hk->hashed_by = hash_fx;
+}
+
+/**
+ * Returns the hash of a key. The hash is cached inside the key, so a key that is used for looking up
+ * multiple tables (like attributes in a class hierarchy) is only hashed once.
+ */
+hash_t ht_key_hash(t_hash_table *ht, t_hash_key *hk) {
+    switch (hk->type) {
+        case HASH_KEY_NUM :
+            return hk->val.n;
+        case HASH_KEY_PTR :
+            return (uintptr_t)hk->val.p;
+        case HASH_KEY_OBJ :
+            // Objects cache their own hash
+            return (hash_t)object_get_hash(hk->val.o);
+    }
+
+    if (hk->hashed_by != ht->hashfuncs->hash) {
+        hk->hash = ht->hashfuncs->hash(ht, hk->val.s, hk->len);
+        hk->hashed_by = ht->hashfuncs->hash;
+    }
 
+    return hk->hash;
+}
+
+/**
+ *
+ */
+t_hash_key *ht_key_create(int type, void *val) {
+    t_hash_key *hk = (t_hash_key *)smm_malloc(sizeof(t_hash_key));
+    ht_key_borrow(hk, type, val);
+    if (hk->type == HASH_KEY_STR) {
+        hk->val.s = string_strdup0((char *)val);
     }
     return hk;
 }
@@ -436,12 +541,8 @@ t_hash_key *ht_key_create(int type, void *val) {
  * Creates a copy of a key
  */
 t_hash_key *ht_key_copy(t_hash_key *org) {
-    t_hash_key *cpy = (t_hash_key *)malloc(sizeof(t_hash_key));
-    memcpy(cpy, org, sizeof(t_hash_key));
-
-    if (cpy->type == HASH_KEY_STR) {
-        cpy->val.s = string_strdup0(org->val.s);
-    }
+    t_hash_key *cpy = (t_hash_key *)smm_malloc(sizeof(t_hash_key));
+    ht_key_store(cpy, org);
     return cpy;
 }
 
@@ -451,10 +552,112 @@ t_hash_key *ht_key_copy(t_hash_key *org) {
 void ht_key_free(t_hash_key *hk) {
     if (!hk) return;
 
-    if (hk->type == HASH_KEY_STR) {
+    ht_key_release(hk);
+    smm_free(hk);
+}
+
+/**
+ * Returns 1 when both keys are equal. Callers should compare the hashes of the keys first.
+ */
+int ht_key_equals(t_hash_key *hk1, t_hash_key *hk2) {
+    if (hk1->type != hk2->type) return 0;
+
+    switch (hk1->type) {
+        case HASH_KEY_STR :
+            // Different symbols always have different names
+            if (hk1->val.s == hk2->val.s) return 1;
+            if (hk1->interned && hk2->interned) return 0;
+            return hk1->len == hk2->len && memcmp(hk1->val.s, hk2->val.s, hk1->len) == 0;
+        case HASH_KEY_NUM :
+            return hk1->val.n == hk2->val.n;
+        case HASH_KEY_OBJ :
+            return object_equals(hk1->val.o, hk2->val.o);
+        case HASH_KEY_PTR :
+            return hk1->val.p == hk2->val.p;
+    }
+    return 0;
+}
+
+/**
+ * Copies a (borrowed) key into storage owned by a hash table. String values are duplicated.
+ */
+void ht_key_store(t_hash_key *dst, t_hash_key *src) {
+    *dst = *src;
+    if (src->type != HASH_KEY_STR || src->interned) return;
+
+    dst->val.s = smm_malloc(src->len + 1);
+    memcpy(dst->val.s, src->val.s, src->len);
+    dst->val.s[src->len] = '\0';
+}
+
+/**
+ * Releases the value of a key that was stored with ht_key_store()
+ */
+void ht_key_release(t_hash_key *hk) {
+    if (hk->type == HASH_KEY_STR && ! hk->interned) {
         smm_free(hk->val.s);
     }
-    smm_free(hk);
+}
+
+
+/*
+ * BUCKET ALLOCATION
+ */
+
+#define HT_SLAB_BUCKETS         256         // Number of buckets allocated at once
+
+/*
+ * Buckets are allocated in slabs and are never given back to the system, but recycled through
+ * the free-list. Hash tables are not threadsafe, and neither is this list.
+ */
+static t_hash_table_bucket *bucket_free_list = NULL;
+
+/**
+ * Returns a new (uninitialized) bucket
+ */
+t_hash_table_bucket *ht_bucket_alloc(void) {
+    t_hash_table_bucket *htb;
+
+    if (bucket_free_list == NULL) {
+        t_hash_table_bucket *slab = smm_malloc(sizeof(t_hash_table_bucket) * HT_SLAB_BUCKETS);
+        for (int i=0; i!=HT_SLAB_BUCKETS; i++) {
+            slab[i].next_element = bucket_free_list;
+            bucket_free_list = &slab[i];
+        }
+    }
+
+    htb = bucket_free_list;
+    bucket_free_list = htb->next_element;
+    return htb;
+}
+
+/**
+ * Returns a bucket to the free-list. Its key must have been freed already.
+ */
+void ht_bucket_free(t_hash_table_bucket *htb) {
+    htb->next_element = bucket_free_list;
+    bucket_free_list = htb;
+}
+
+/**
+ * Copies the key into the bucket. Short string keys are stored inline, longer ones are duplicated.
+ */
+void ht_bucket_set_key(t_hash_table_bucket *htb, t_hash_key *key) {
+    htb->key = *key;
+    if (key->type != HASH_KEY_STR || key->interned) return;
+
+    htb->key.val.s = key->len < HT_KEY_INLINE_SIZE ? htb->key_buf : smm_malloc(key->len + 1);
+    memcpy(htb->key.val.s, key->val.s, key->len);
+    htb->key.val.s[key->len] = '\0';
+}
+
+/**
+ * Frees the key of the bucket (when it was not stored inline)
+ */
+void ht_bucket_free_key(t_hash_table_bucket *htb) {
+    if (htb->key.type == HASH_KEY_STR && ! htb->key.interned && htb->key.val.s != htb->key_buf) {
+        smm_free(htb->key.val.s);
+    }
 }
 
 
@@ -182,8 +182,8 @@ void fatal_error(int exitcode, char *format, ...) {
 /**
  * Printf's a string to stdout
  */
-void output_string_printf(t_string *format, t_dll *args) {
-    arg_printf_string(stdout, format, args, output_char_helper);
+void output_string_printf(t_string *format, struct _object **argv, int argc) {
+    arg_printf_string(stdout, format, argv, argc, output_char_helper);
 }
 
 
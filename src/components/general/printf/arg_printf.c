@@ -37,15 +37,18 @@
 /**
  *
  */
-static long _get_long(t_dll_element **e) {
-    t_object *obj = (t_object *)DLL_DATA_PTR((*e));
+static long _get_long(t_object ***argv, t_object **argv_end) {
+    // Missing arguments are printed as 0
+    if (*argv == argv_end) return 0;
+
+    t_object *obj = **argv;
 
     if (! OBJECT_IS_NUMERICAL(obj)) {
         t_attrib_object *numerical_method = object_attrib_find(obj, "__numerical");
         obj = call_saffire_method(obj, numerical_method, 0);
     }
 
-    (*e) = DLL_NEXT((*e));
+    (*argv)++;
 
     return ((t_numerical_object *)obj)->data.value;
 }
@@ -54,8 +57,11 @@ static long _get_long(t_dll_element **e) {
 /**
  *
  */
-static t_string *_get_string(t_dll_element **e) {
-    t_object *obj = DLL_DATA_PTR((*e));
+static t_string *_get_string(t_object ***argv, t_object **argv_end) {
+    // Missing arguments are printed as an empty string
+    if (*argv == argv_end) return char0_to_string("");
+
+    t_object *obj = **argv;
 
     if (! OBJECT_IS_STRING(obj)) {
         t_attrib_object *string_method = object_attrib_find(obj, "__string");
@@ -63,7 +69,7 @@ static t_string *_get_string(t_dll_element **e) {
         if (! obj) return char0_to_string("");
     }
 
-    (*e) = DLL_NEXT((*e));
+    (*argv)++;
 
     return ((t_string_object *)obj)->data.value;
 }
@@ -72,14 +78,14 @@ static t_string *_get_string(t_dll_element **e) {
 /**
  *
  */
-int arg_printf_string(FILE *f, t_string *fmt, t_dll *args, fnptr output) {
+int arg_printf_string(FILE *f, t_string *fmt, t_object **argv, int argc, fnptr output) {
     unsigned flags, actual_wd, count, given_wd;
     unsigned char *where_char, buf[PR_BUFLEN];
     unsigned char state, radix;
     t_string *where = NULL;
     long num;
-    t_dll_element *e = DLL_HEAD(args);
     char *fmt_char = STRING_CHAR0(fmt);
+    t_object **argv_end = argv + argc;
 
     state = flags = count = given_wd = 0;
 
@@ -176,21 +182,21 @@ int arg_printf_string(FILE *f, t_string *fmt, t_dll *args, fnptr output) {
 /* load the value to be printed. l=long=32 bits: */
 DO_NUM:
                 if (flags & PR_32) {
-                    num = _get_long(&e);
+                    num = _get_long(&argv, argv_end);
                 }
 /* h=short=16 bits (signed or unsigned) */
                 else if (flags & PR_16) {
                     if (flags & PR_SG) {
-                        num = _get_long(&e);
+                        num = _get_long(&argv, argv_end);
                     } else {
-                        num = _get_long(&e);
+                        num = _get_long(&argv, argv_end);
                     }
                 } else {
 /* no h nor l: sizeof(int) bits (signed or unsigned) */
                     if (flags & PR_SG) {
-                        num = _get_long(&e);
+                        num = _get_long(&argv, argv_end);
                     } else {
-                        num = _get_long(&e);
+                        num = _get_long(&argv, argv_end);
                     }
                 }
 /* take care of sign */
@@ -221,14 +227,14 @@ OK, I found my mistake. The math here is _always_ unsigned */
 /* disallow pad-left-with-zeroes for %c */
                 flags &= ~PR_LZ;
                 where_char--;
-                t_string *tmp = _get_string(&e);
+                t_string *tmp = _get_string(&argv, argv_end);
                 *where_char = STRING_CHAR0(tmp)[0];
                 actual_wd = 1;
                 goto EMIT2;
             case 's':
 /* disallow pad-left-with-zeroes for %s */
                 flags &= ~PR_LZ;
-                where = _get_string(&e);
+                where = _get_string(&argv, argv_end);
                 where_char = (unsigned char *)STRING_CHAR0(where);
 EMIT:
                 actual_wd = STRING_LEN(where);
@@ -25,7 +25,11 @@
  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include <stdio.h>
+#include <stdint.h>
 #include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include <saffire/general/string.h>
 #include <saffire/memory/smm.h>
@@ -96,6 +100,7 @@ t_string *string_new(void) {
     STRING_CHAR0(str) = NULL;
     STRING_LEN(str) = 0;
     STRING_UNICODE(str) = NULL;
+    str->charset = STRING_CHARSET_UNKNOWN;
     return str;
 }
 
@@ -186,8 +191,9 @@ int string_strcmp(const t_string *s1, const t_string *s2) {
     if (len > STRING_LEN(s2)) len = STRING_LEN(s2);
 
     res = memcmp(STRING_CHAR0(s1), STRING_CHAR0(s2), len);
-    if (! res) return res;
+    if (res) return res < 0 ? -1 : 1;
 
+    if (STRING_LEN(s1) == STRING_LEN(s2)) return 0;
     return STRING_LEN(s1) > STRING_LEN(s2) ? 1 : -1;
 }
 
@@ -235,3 +241,145 @@ char *string_strncpy0(const char *s, size_t len) {
 
     return dst;
 }
+
+
+/**
+ * Returns the offset of the first byte with the high bit set, or len when the string is pure ASCII. Scans 16 bytes
+ * at a time with SSE2, or a word at a time otherwise.
+ */
+static size_t _string_ascii_prefix(const unsigned char *s, size_t len) {
+    size_t i = 0;
+
+#ifdef __SSE2__
+    for (; i + 16 <= len; i += 16) {
+        unsigned int mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(s + i)));
+        if (mask) return i + __builtin_ctz(mask);
+    }
+#endif
+
+    for (; i + 8 <= len; i += 8) {
+        uint64_t w;
+        memcpy(&w, s + i, 8);
+        if (w & 0x8080808080808080ULL) break;
+    }
+
+    for (; i < len; i++) {
+        if (s[i] & 0x80) return i;
+    }
+    return len;
+}
+
+/**
+ * Returns 1 when the string is valid UTF-8 (no overlong forms, surrogates or code points above U+10FFFF).
+ */
+static int _string_valid_utf8(const unsigned char *s, size_t len) {
+    size_t i = 0;
+
+    while (i < len) {
+        i += _string_ascii_prefix(s + i, len - i);
+        if (i == len) break;
+
+        unsigned char c = s[i];
+        int n;
+        unsigned int min, cp;
+        if (c >= 0xC2 && c <= 0xDF) {
+            n = 1; min = 0x80; cp = c & 0x1F;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+            n = 2; min = 0x800; cp = c & 0x0F;
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            n = 3; min = 0x10000; cp = c & 0x07;
+        } else {
+            return 0;
+        }
+        if (len - i <= n) return 0;
+
+        for (int j = 1; j <= n; j++) {
+            if ((s[i + j] & 0xC0) != 0x80) return 0;
+            cp = (cp << 6) | (s[i + j] & 0x3F);
+        }
+        if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) return 0;
+
+        i += n + 1;
+    }
+
+    return 1;
+}
+
+/**
+ * Returns the character set of the string. It is found on first use, and stored in the string.
+ */
+int string_charset(t_string *str) {
+    if (str->charset != STRING_CHARSET_UNKNOWN) return str->charset;
+
+    const unsigned char *s = (const unsigned char *)STRING_CHAR0(str);
+    size_t ascii = _string_ascii_prefix(s, STRING_LEN(str));
+
+    if (ascii == STRING_LEN(str)) {
+        str->charset = STRING_CHARSET_ASCII;
+    } else if (_string_valid_utf8(s + ascii, STRING_LEN(str) - ascii)) {
+        str->charset = STRING_CHARSET_UTF8;
+    } else {
+        str->charset = STRING_CHARSET_BINARY;
+    }
+
+    return str->charset;
+}
+
+
+/*
+ * Case mapping tables for ASCII strings. These don't depend on the locale, except for Turkish and Azerbaijani
+ * (dotted and dotless i), which callers must leave to ICU.
+ */
+#define ASCII_UPPER(c)          ((c) >= 'a' && (c) <= 'z' ? (c) - 32 : (c))
+#define ASCII_LOWER(c)          ((c) >= 'A' && (c) <= 'Z' ? (c) + 32 : (c))
+#define ASCII_ROW(f, c)         f(c), f(c+1), f(c+2), f(c+3), f(c+4), f(c+5), f(c+6), f(c+7), \
+                                f(c+8), f(c+9), f(c+10), f(c+11), f(c+12), f(c+13), f(c+14), f(c+15)
+#define ASCII_TABLE(f)          ASCII_ROW(f, 0), ASCII_ROW(f, 16), ASCII_ROW(f, 32), ASCII_ROW(f, 48), \
+                                ASCII_ROW(f, 64), ASCII_ROW(f, 80), ASCII_ROW(f, 96), ASCII_ROW(f, 112)
+
+static const char ascii_upper[128] = { ASCII_TABLE(ASCII_UPPER) };
+static const char ascii_lower[128] = { ASCII_TABLE(ASCII_LOWER) };
+
+
+/**
+ * Returns a new string with all characters of an ASCII string mapped through the table
+ */
+static t_string *_string_ascii_map(const t_string *src, const char *table) {
+    t_string *dst = string_new();
+
+    char *c = smm_malloc(STRING_LEN(src) + 1);
+    for (size_t i = 0; i != STRING_LEN(src); i++) {
+        c[i] = table[(unsigned char)STRING_CHAR0(src)[i]];
+    }
+    c[STRING_LEN(src)] = '\0';
+
+    STRING_CHAR0(dst) = c;
+    STRING_LEN(dst) = STRING_LEN(src);
+    dst->charset = STRING_CHARSET_ASCII;
+    return dst;
+}
+
+/**
+ * Returns an upper cased copy of an ASCII string
+ */
+t_string *string_ascii_toupper(const t_string *src) {
+    return _string_ascii_map(src, ascii_upper);
+}
+
+/**
+ * Returns a lower cased copy of an ASCII string
+ */
+t_string *string_ascii_tolower(const t_string *src) {
+    return _string_ascii_map(src, ascii_lower);
+}
+
+/**
+ * Returns a lower cased copy of an ASCII string, with the first character upper cased
+ */
+t_string *string_ascii_ucfirst(const t_string *src) {
+    t_string *dst = _string_ascii_map(src, ascii_lower);
+    if (STRING_LEN(dst)) {
+        STRING_CHAR0(dst)[0] = ascii_upper[(unsigned char)STRING_CHAR0(dst)[0]];
+    }
+    return dst;
+}
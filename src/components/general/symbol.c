@@ -0,0 +1,96 @@
+/*
+ Copyright (c) 2012-2015, The Saffire Group
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+     * Redistributions of source code must retain the above copyright
+       notice, this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of the Saffire Group the
+       names of its contributors may be used to endorse or promote products
+       derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <string.h>
+#include <saffire/general/symbol.h>
+#include <saffire/general/hashtable.h>
+#include <saffire/general/hash/hash_funcs.h>
+#include <saffire/memory/smm.h>
+
+/**
+ * The intern table, keyed by the names of the symbols themselves. It is created on the first intern, as names
+ * are already interned while objects and modules are initialized.
+ */
+static t_hash_table *symbol_table = NULL;
+
+
+/**
+ * Returns the symbol for the given (binary safe) name, and creates it when it does not exist yet
+ */
+t_symbol *symbol_intern(const char *s, size_t len) {
+    t_hash_key key;
+
+    if (! symbol_table) {
+        symbol_table = ht_create_lookup();
+    }
+
+    ht_key_borrow_str(&key, s, len);
+    t_symbol *symbol = ht_find(symbol_table, &key);
+    if (symbol) return symbol;
+
+    symbol = smm_malloc(sizeof(t_symbol) + len + 1);
+    symbol->len = len;
+    memcpy(symbol->s, s, len);
+    symbol->s[len] = '\0';
+    symbol->hash = hash_fx(NULL, symbol->s, len);
+
+    ht_add_sym(symbol_table, symbol, symbol);
+    return symbol;
+}
+
+/**
+ * Returns the symbol for the given \0 terminated name
+ */
+t_symbol *symbol_intern0(const char *s) {
+    return symbol_intern(s, strlen(s));
+}
+
+
+/**
+ * Frees all symbols. Tables that still hold symbols as keys can be destroyed afterwards, but not used anymore.
+ */
+void symbol_fini(void) {
+    if (! symbol_table) return;
+
+    // The keys of the intern table point into the symbols, so the table must be gone before they are freed
+    t_symbol **symbols = smm_malloc(sizeof(t_symbol *) * (symbol_table->element_count + 1));
+    long count = 0;
+
+    t_hash_iter iter;
+    ht_iter_init(&iter, symbol_table);
+    while (ht_iter_valid(&iter)) {
+        symbols[count++] = ht_iter_value(&iter);
+        ht_iter_next(&iter);
+    }
+
+    ht_destroy(symbol_table);
+    symbol_table = NULL;
+
+    while (count--) {
+        smm_free(symbols[count]);
+    }
+    smm_free(symbols);
+}
@@ -67,6 +67,9 @@ void create_utf8_from_string(t_string *str) {
     // Create unicode from string, and store this in string
     STRING_UNICODE(str) = (UChar *)smm_malloc(sizeof(UChar) * (STRING_LEN(str) + 1));
     u_uastrncpy(STRING_UNICODE(str), STRING_CHAR0(str), STRING_LEN(str));
+
+    // Only terminated by u_uastrncpy() when there is room left
+    STRING_UNICODE(str)[STRING_LEN(str)] = 0;
 }
 
 
@@ -136,15 +139,10 @@ size_t utf8_strstr(const t_string *haystack, const t_string *needle, size_t offs
 }
 
 /**
- * Compares s1 against s2. Returns 0 when equal, -1 when s1 if "larger" and 1 when s2 is "larger".
+ * Compares s1 against s2 in code point order. Returns 0 when equal, <0 when s1 sorts before s2 and >0 otherwise.
  */
 int utf8_strcmp(const t_string *s1, const t_string *s2) {
-    int res, len = STRING_LEN(s1);
-    if (len > STRING_LEN(s2)) len = STRING_LEN(s2);
-
-    res = u_memcmp(STRING_UNICODE(s1), STRING_UNICODE(s2), len);
-    if (! res) return res;
-    return STRING_LEN(s1) > STRING_LEN(s2) ? 1 : -1;
+    return u_strcmpCodePointOrder(STRING_UNICODE(s1), STRING_UNICODE(s2));
 }
 
 //t_string *utf8_strdup(t_string *src) {
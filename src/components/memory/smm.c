@@ -45,9 +45,13 @@ void *smm_malloc(size_t size) {
 }
 
 void *smm_zalloc(size_t size) {
-    void *p = smm_malloc(size);
-    bzero(p, size);
-    return p;
+    smm_malloc_calls++;
+    // calloc() can hand out fresh pages for large blocks without having to clear them first
+    void *ptr = calloc(1, size);
+    if (ptr == NULL) {
+        fatal_error(1, "Error while allocating memory (%lu bytes)!\n", (unsigned long)size);        /* LCOV_EXCL_LINE */
+    }
+    return ptr;
 }
 
 void *smm_realloc(void *ptr, size_t size) {
@@ -37,6 +37,8 @@
 #include <saffire/vm/vm.h>
 #include <saffire/vm/thread.h>
 #include <saffire/memory/smm.h>
+#include <saffire/gc/gc.h>
+#include <saffire/general/symbol.h>
 #include <string.h>
 
 SAFFIRE_MODULE_METHOD(saffire, get_locale) {
@@ -54,7 +56,7 @@ SAFFIRE_MODULE_METHOD(saffire, set_locale) {
 
     // Set locale
     t_thread *thread = thread_get_current();
-    thread->locale = string_strdup0(STRING_CHAR0(locale));
+    thread->locale = symbol_intern(STRING_CHAR0(locale), STRING_LEN(locale))->s;
 
     RETURN_SELF;
 }
@@ -194,10 +196,29 @@ SAFFIRE_MODULE_METHOD(saffire, modules) {
     RETURN_HASH(modules_ht);
 }
 
+/**
+ * Collects reference cycles, and returns a hash with the collector statistics
+ */
+SAFFIRE_MODULE_METHOD(saffire, gc) {
+    long collected = gc_collect();
+
+    t_gc_stats stats;
+    gc_get_stats(&stats);
+
+    t_hash_table *ht = ht_create();
+    ht_add_obj(ht, STR02OBJ("collected"), NUM2OBJ(collected));
+    ht_add_obj(ht, STR02OBJ("pause"), NUM2OBJ(stats.last_pause));
+    ht_add_obj(ht, STR02OBJ("runs"), NUM2OBJ(stats.runs));
+    ht_add_obj(ht, STR02OBJ("total_collected"), NUM2OBJ(stats.collected));
+    ht_add_obj(ht, STR02OBJ("total_pause"), NUM2OBJ(stats.total_pause));
+
+    RETURN_HASH(ht);
+}
+
 t_object saffire_struct = { OBJECT_HEAD_INIT("saffire", objectTypeBase, OBJECT_TYPE_CLASS, NULL, 0), OBJECT_FOOTER };
 
 static void _init(void) {
-    saffire_struct.attributes = ht_create();
+    saffire_struct.attributes = ht_create_lookup();
 
     object_add_internal_method((t_object *)&saffire_struct, "version",      ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_saffire_method_version);
     object_add_internal_method((t_object *)&saffire_struct, "git_revision", ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_saffire_method_gitrev);
@@ -210,6 +231,7 @@ static void _init(void) {
     object_add_internal_method((t_object *)&saffire_struct, "args",         ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_saffire_method_args);
 
     object_add_internal_method((t_object *)&saffire_struct, "modules",      ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_saffire_method_modules);
+    object_add_internal_method((t_object *)&saffire_struct, "gc",           ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_saffire_method_gc);
 
     object_add_property((t_object *)&saffire_struct, "fastcgi",    ATTRIB_VISIBILITY_PUBLIC, Object_Null);
     object_add_property((t_object *)&saffire_struct, "cli",        ATTRIB_VISIBILITY_PUBLIC, Object_Null);
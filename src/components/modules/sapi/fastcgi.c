@@ -65,7 +65,7 @@ SAFFIRE_MODULE_METHOD(fastcgi, environment) {
 t_object fastcgi_struct = { OBJECT_HEAD_INIT("fastcgi", objectTypeBase, OBJECT_TYPE_CLASS, NULL, 0), OBJECT_FOOTER };
 
 static void _init(void) {
-    fastcgi_struct.attributes = ht_create();
+    fastcgi_struct.attributes = ht_create_lookup();
 
     object_add_internal_method((t_object *)&fastcgi_struct, "environment",  ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_fastcgi_method_environment);
 }
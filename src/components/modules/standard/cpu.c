@@ -74,7 +74,7 @@ SAFFIRE_MODULE_METHOD(cpu, vendor) {
 
     if (cpu_data == NULL) {
         // @TODO: MEDIUM: Throw exception ?
-           RETURN_STRING("");
+           RETURN_STRING_FROM_CHAR("");
     }
 
     RETURN_STRING_FROM_CHAR(cpu_data->vendor_str);
@@ -100,7 +100,7 @@ SAFFIRE_MODULE_METHOD(cpu, brand) {
 
     if (cpu_data == NULL) {
         // @TODO: MEDIUM: Throw exception ?
-           RETURN_STRING("");
+           RETURN_STRING_FROM_CHAR("");
     }
 
     RETURN_STRING_FROM_CHAR(cpu_data->brand_str);
@@ -167,7 +167,7 @@ SAFFIRE_MODULE_METHOD(cpu, codename) {
 
     if (cpu_data == NULL) {
         // @TODO: MEDIUM: Throw exception ?
-           RETURN_STRING("");
+           RETURN_STRING_FROM_CHAR("");
     }
 
     RETURN_STRING_FROM_CHAR(cpu_data->cpu_codename);
@@ -230,7 +230,7 @@ t_object cpu_struct = { OBJECT_HEAD_INIT("cpu", objectTypeBase, OBJECT_TYPE_CLAS
 
 
 static void _init(void) {
-    cpu_struct.attributes = ht_create();
+    cpu_struct.attributes = ht_create_lookup();
     object_add_internal_method((t_object *)&cpu_struct, "vendor",               ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_cpu_method_vendor);
     object_add_internal_method((t_object *)&cpu_struct, "vendorId",               ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_cpu_method_vendor_id);
     object_add_internal_method((t_object *)&cpu_struct, "brand",                ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_cpu_method_brand);
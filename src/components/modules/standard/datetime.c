@@ -124,7 +124,7 @@ t_object_funcs datetime_funcs = {
 t_object datetime_struct       = { OBJECT_HEAD_INIT("datetime", objectTypeBase, OBJECT_TYPE_CLASS, &datetime_funcs, sizeof(t_datetime_data)), OBJECT_FOOTER };
 
 static void _init(void) {
-    datetime_struct.attributes = ht_create();
+    datetime_struct.attributes = ht_create_lookup();
     object_add_internal_method((t_object *)&datetime_struct, "now",  ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_datetime_method_now);
 
     object_add_internal_method((t_object *)&datetime_struct, "format",    ATTRIB_METHOD_NONE, ATTRIB_VISIBILITY_PUBLIC, module_datetime_method_format);
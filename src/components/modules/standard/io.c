@@ -39,12 +39,11 @@
 /**
  *
  */
-static t_object *_saffire_print(t_object *self, t_dll *arguments, int newline) {
+static t_object *_saffire_print(t_object *self, t_object **argv, int argc, int newline) {
     t_object *obj;
 
-    t_dll_element *e = DLL_HEAD(SAFFIRE_METHOD_ARGS);
-    while (e) {
-        obj = DLL_DATA_PTR(e);
+    for (int i=0; i!=argc; i++) {
+        obj = argv[i];
 
         // Implied conversion to string
         if (! OBJECT_IS_STRING(obj)) {
@@ -57,8 +56,6 @@ static t_object *_saffire_print(t_object *self, t_dll *arguments, int newline) {
         } else {
             output_char("");
         }
-
-        e = DLL_NEXT(e);
     }
 
     if (newline) {
@@ -158,22 +155,21 @@ static void _io_dump(t_object *obj, int depth) {
  *
  */
 SAFFIRE_MODULE_METHOD(io, print) {
-    return _saffire_print(self, arguments, 0);
+    return _saffire_print(self, SAFFIRE_METHOD_ARGS, 0);
 }
 
 /**
  *
  */
 SAFFIRE_MODULE_METHOD(io, println) {
-    return _saffire_print(self, arguments, 1);
+    return _saffire_print(self, SAFFIRE_METHOD_ARGS, 1);
 }
 
 /**
  *
  */
 SAFFIRE_MODULE_METHOD(io, printf) {
-    t_dll_element *e = DLL_HEAD(SAFFIRE_METHOD_ARGS);
-    t_object *obj = DLL_DATA_PTR(e);
+    t_object *obj = argv[0];
     if (! OBJECT_IS_STRING(obj)) {
         t_attrib_object *string_method = object_attrib_find(obj, "__string");
         obj = call_saffire_method(obj, string_method, 0);
@@ -181,14 +177,11 @@ SAFFIRE_MODULE_METHOD(io, printf) {
 
     t_string *format = ((t_string_object *)obj)->data.value;
 
-    // @TODO: Don't change the args DLL!
-    e = DLL_HEAD(SAFFIRE_METHOD_ARGS);
-    dll_remove(SAFFIRE_METHOD_ARGS, e);
-
+    // The format itself is not an argument
 #ifdef __DEBUG
     output_char(ANSI_BRIGHTYELLOW);
 #endif
-    output_string_printf(format, SAFFIRE_METHOD_ARGS);
+    output_string_printf(format, argv + 1, argc - 1);
 #ifdef __DEBUG
     output_char(ANSI_RESET);
 #endif
@@ -228,7 +221,7 @@ SAFFIRE_MODULE_METHOD(io, dump) {
  *
  */
 SAFFIRE_MODULE_METHOD(console, print) {
-    output_char("console.print: %ld arguments\n", SAFFIRE_METHOD_ARGS->size);
+    output_char("console.print: %d arguments\n", argc);
     RETURN_SELF;
 }
 
@@ -236,7 +229,7 @@ SAFFIRE_MODULE_METHOD(console, print) {
  *
  */
 SAFFIRE_MODULE_METHOD(console, printf) {
-    output_char("console.printf: %ld arguments\n", SAFFIRE_METHOD_ARGS->size);
+    output_char("console.printf: %d arguments\n", argc);
     RETURN_SELF;
 }
 
@@ -254,14 +247,14 @@ t_object console_struct  = { OBJECT_HEAD_INIT("console", objectTypeBase, OBJECT_
 
 
 static void _init(void) {
-    io_struct.attributes = ht_create();
+    io_struct.attributes = ht_create_lookup();
     object_add_internal_method((t_object *)&io_struct, "print",     ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_io_method_print);
     object_add_internal_method((t_object *)&io_struct, "println",   ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_io_method_println);
     object_add_internal_method((t_object *)&io_struct, "printf",    ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_io_method_printf);
     object_add_internal_method((t_object *)&io_struct, "sprintf",   ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_io_method_sprintf);
     object_add_internal_method((t_object *)&io_struct, "dump",      ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_io_method_dump);
 
-    console_struct.attributes = ht_create();
+    console_struct.attributes = ht_create_lookup();
     object_add_internal_method((t_object *)&console_struct, "print",    ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_console_method_print);
     object_add_internal_method((t_object *)&console_struct, "printf",   ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_console_method_printf);
     object_add_internal_method((t_object *)&console_struct, "sprintf",  ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_console_method_sprintf);
@@ -297,8 +290,6 @@ t_module module_io = {
  * @return
  */
 t_object *module_io_print(char *format, ...) {
-    t_dll *dll_args = dll_init();
-
     va_list args;
     va_start(args, format);
 
@@ -311,10 +302,10 @@ t_object *module_io_print(char *format, ...) {
     va_end(args);
 
     t_string_object *str_obj = (t_string_object *)object_alloc_instance(Object_String, 2, strlen(s), s);
-    dll_append(dll_args, str_obj);
     object_inc_ref((t_object *)str_obj);
 
-    module_io_method_print(&io_struct, dll_args);
+    t_object *argv[1] = { (t_object *)str_obj };
+    module_io_method_print(&io_struct, argv, 1);
 
     object_release((t_object *)str_obj);
     smm_free(s);
@@ -132,33 +132,31 @@ SAFFIRE_MODULE_METHOD(io_file, path) {
 SAFFIRE_MODULE_METHOD(io_file, stat) {
     t_file_object *file_obj = (t_file_object *)self;
 
-    if (! file_obj->data.stat) {
-        struct stat filestat;
-        int ret = fstat(fileno(file_obj->data.fp), &filestat);
+    struct stat filestat;
+    int ret = fstat(fileno(file_obj->data.fp), &filestat);
 
-        if (ret < 0) {
-            object_raise_exception(Object_FileNotFoundException, 1, "Cannot stat file '%s'", file_obj->data.path);
-            return NULL;
-        }
+    if (ret < 0) {
+        object_raise_exception(Object_FileNotFoundException, 1, "Cannot stat file '%s'", file_obj->data.path);
+        return NULL;
+    }
 
-        // Create hash table
-        file_obj->data.stat = ht_create();
+    // Create hash table. The hash object takes over the table, so we cannot keep it inside the file object.
+    t_hash_table *stat = ht_create();
 
-        ht_add_obj(file_obj->data.stat, STR02OBJ("st_mode"), NUM2OBJ(filestat.st_mode));
-        ht_add_obj(file_obj->data.stat, STR02OBJ("st_ino"), NUM2OBJ(filestat.st_ino));
-        ht_add_obj(file_obj->data.stat, STR02OBJ("st_dev"), NUM2OBJ(filestat.st_dev));
-        ht_add_obj(file_obj->data.stat, STR02OBJ("st_uid"), NUM2OBJ(filestat.st_uid));
-        ht_add_obj(file_obj->data.stat, STR02OBJ("st_gid"), NUM2OBJ(filestat.st_gid));
+    ht_add_obj(stat, STR02OBJ("st_mode"), NUM2OBJ(filestat.st_mode));
+    ht_add_obj(stat, STR02OBJ("st_ino"), NUM2OBJ(filestat.st_ino));
+    ht_add_obj(stat, STR02OBJ("st_dev"), NUM2OBJ(filestat.st_dev));
+    ht_add_obj(stat, STR02OBJ("st_uid"), NUM2OBJ(filestat.st_uid));
+    ht_add_obj(stat, STR02OBJ("st_gid"), NUM2OBJ(filestat.st_gid));
 
-        ht_add_obj(file_obj->data.stat, STR02OBJ("st_atime"), NUM2OBJ(filestat.st_atime));
-        ht_add_obj(file_obj->data.stat, STR02OBJ("st_ctime"), NUM2OBJ(filestat.st_ctime));
-        ht_add_obj(file_obj->data.stat, STR02OBJ("st_mtime"), NUM2OBJ(filestat.st_mtime));
+    ht_add_obj(stat, STR02OBJ("st_atime"), NUM2OBJ(filestat.st_atime));
+    ht_add_obj(stat, STR02OBJ("st_ctime"), NUM2OBJ(filestat.st_ctime));
+    ht_add_obj(stat, STR02OBJ("st_mtime"), NUM2OBJ(filestat.st_mtime));
 
-        ht_add_obj(file_obj->data.stat, STR02OBJ("st_nlink"), NUM2OBJ(filestat.st_nlink));
-        ht_add_obj(file_obj->data.stat, STR02OBJ("st_size"), NUM2OBJ(filestat.st_size));
-    }
+    ht_add_obj(stat, STR02OBJ("st_nlink"), NUM2OBJ(filestat.st_nlink));
+    ht_add_obj(stat, STR02OBJ("st_size"), NUM2OBJ(filestat.st_size));
 
-    RETURN_HASH(file_obj->data.stat);
+    RETURN_HASH(stat);
 }
 
 
@@ -287,7 +285,7 @@ SAFFIRE_MODULE_METHOD(io_file, contents) {
  */
 
 static void _init(void) {
-    Object_File_struct.attributes = ht_create();
+    Object_File_struct.attributes = ht_create_lookup();
     object_add_internal_method((t_object *)&Object_File_struct, "open",      ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_io_file_method_open);
     object_add_internal_method((t_object *)&Object_File_struct, "fileNo",    ATTRIB_METHOD_NONE, ATTRIB_VISIBILITY_PUBLIC, module_io_file_method_fileno);
     object_add_internal_method((t_object *)&Object_File_struct, "close",     ATTRIB_METHOD_NONE, ATTRIB_VISIBILITY_PUBLIC, module_io_file_method_close);
@@ -340,7 +340,7 @@ t_socket_object io_socket_struct = {
 };
 
 static void _init(void) {
-    io_socket_struct.attributes = ht_create();
+    io_socket_struct.attributes = ht_create_lookup();
 
     object_add_internal_method((t_object *)&io_socket_struct, "__ctor",     ATTRIB_METHOD_CTOR, ATTRIB_VISIBILITY_PUBLIC, module_io_socket_method_ctor);
     object_add_internal_method((t_object *)&io_socket_struct, "setOption",  ATTRIB_METHOD_NONE, ATTRIB_VISIBILITY_PUBLIC, module_io_socket_method_setOption);
@@ -108,7 +108,7 @@ SAFFIRE_MODULE_METHOD(math, seed) {
 t_object math_struct       = { OBJECT_HEAD_INIT("math", objectTypeBase, OBJECT_TYPE_CLASS, NULL, 0), OBJECT_FOOTER };
 
 static void _init(void) {
-    math_struct.attributes = ht_create();
+    math_struct.attributes = ht_create_lookup();
     object_add_internal_method((t_object *)&math_struct, "random",  ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_math_method_random);
     object_add_internal_method((t_object *)&math_struct, "seed",    ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_math_method_seed);
 }
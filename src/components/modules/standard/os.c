@@ -200,13 +200,13 @@ t_stat_object Object_Stat_struct = {
 t_object os_struct = { OBJECT_HEAD_INIT("os", objectTypeBase, OBJECT_TYPE_CLASS, NULL, 0), OBJECT_FOOTER };
 
 static void _init(void) {
-    os_struct.attributes = ht_create();
+    os_struct.attributes = ht_create_lookup();
     object_add_internal_method((t_object *)&os_struct, "cwd",  ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_os_method_cwd);
     object_add_internal_method((t_object *)&os_struct, "usleep",  ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_os_method_usleep);
     object_add_internal_method((t_object *)&os_struct, "realpath",  ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_os_method_realpath);
     object_add_internal_method((t_object *)&os_struct, "stat",  ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_os_method_stat);
 
-    Object_Stat_struct.attributes = ht_create();
+    Object_Stat_struct.attributes = ht_create_lookup();
     object_add_internal_method((t_object *)&Object_Stat_struct, "dev",  ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_stat_method_dev);
     object_add_internal_method((t_object *)&Object_Stat_struct, "inode",  ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_stat_method_inode);
     object_add_internal_method((t_object *)&Object_Stat_struct, "links",  ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, module_stat_method_links);
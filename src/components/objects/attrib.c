@@ -34,6 +34,7 @@
 #include <saffire/debug.h>
 #include <saffire/general/dll.h>
 
+unsigned long object_attrib_generation = 0;
 
 /**
  * Additional values:
@@ -78,18 +79,19 @@ t_attrib_object *object_attrib_duplicate(t_attrib_object *attrib, t_object *self
 //    DEBUG_PRINT_CHAR("duplicating attrib %08X into %s\n", (intptr_t)attrib, self->name);
 
     // Create a simple duplicate object and copy everything over
-    t_attrib_object *dup = smm_malloc(sizeof (Object_Attrib_struct));
+    t_attrib_object *dup = (t_attrib_object *)object_alloc_memory(objectTypeAttribute, Object_Attrib_struct.data_size);
     memcpy(dup, attrib, sizeof (Object_Attrib_struct));
 
     // Set refcount to zero, we don't care about the original reference count
     dup->ref_count = 0;
+    dup->flags &= ~OBJECT_GC_MASK;
 
     // As there are now two attributes referencing the same attribute-value, increase the value as well.
     object_inc_ref(dup->data.attribute);
 
     // Since an attribute object doesn't have attributes to begin with, we just create a (dummy) hashtable. If attributes happen to get
     // attributes later on (i don't see how or why, then this should change as well)..
-    dup->attributes = ht_create();
+    dup->attributes = ht_create_lookup();
 
     // Self object is used in this attribute as bound instance
     dup->data.bound_instance = self;
@@ -110,24 +112,27 @@ t_attrib_object *object_attrib_duplicate(t_attrib_object *attrib, t_object *self
 }
 
 /**
- * find attribute inside a object. return either NULL or the actual attribute
+ * find attribute inside a object. The key (and its hash) is reused for every object in the hierarchy.
  */
-t_attrib_object *object_attrib_find(t_object *self, char *name) {
+static t_attrib_object *_object_attrib_find(t_object *self, t_hash_key *key) {
     t_attrib_object *attr = NULL;
     t_object *cur_obj = self;
 
-    if (!self) return NULL;
+    // Meta objects only create their attributes when they are read
+    if (OBJECT_IS_META(self)) {
+        object_meta_populate_attributes((t_meta_object *)self);
+    }
 
     while (attr == NULL) {
-        DEBUG_PRINT_CHAR(">>> Finding attribute '%s' on object %s\n", name, cur_obj->name);
+        DEBUG_PRINT_CHAR(">>> Finding attribute '%s' on object %s\n", key->val.s, cur_obj->name);
 
         // Find the attribute in the current object
-        attr = ht_find_str(cur_obj->attributes, name);
+        attr = ht_find(cur_obj->attributes, key);
         if (attr != NULL) break;
 
         // Not found and there is no parent, we're done!
         if (cur_obj->parent == NULL) {
-            DEBUG_PRINT_CHAR(">>> Cannot find attribute '%s' in object %s:\n", name, self->name);
+            DEBUG_PRINT_CHAR(">>> Cannot find attribute '%s' in object %s:\n", key->val.s, self->name);
             return NULL;
         }
 
@@ -135,10 +140,34 @@ t_attrib_object *object_attrib_find(t_object *self, char *name) {
         cur_obj = cur_obj->parent;
     }
 
-    DEBUG_PRINT_CHAR(">>> Found attribute '%s' in object %s (actually found in object %s)\n", name, self->name, cur_obj->name);
+    DEBUG_PRINT_CHAR(">>> Found attribute '%s' in object %s (actually found in object %s)\n", key->val.s, self->name, cur_obj->name);
     return attr;
 }
 
+/**
+ * find attribute inside a object. return either NULL or the actual attribute
+ */
+t_attrib_object *object_attrib_find(t_object *self, char *name) {
+    t_hash_key key;
+
+    if (!self) return NULL;
+
+    ht_key_borrow_str(&key, name, strlen(name));
+    return _object_attrib_find(self, &key);
+}
+
+/**
+ * find attribute by its interned name. Attributes are stored under symbols as well, so keys compare by pointer.
+ */
+t_attrib_object *object_attrib_find_sym(t_object *self, t_symbol *name) {
+    t_hash_key key;
+
+    if (!self) return NULL;
+
+    ht_key_borrow_sym(&key, name);
+    return _object_attrib_find(self, &key);
+}
+
 /* ======================================================================
  *   Supporting functions
  * ======================================================================
@@ -159,7 +188,7 @@ t_attrib_object *object_attrib_find(t_object *self, char *name) {
  * Initializes attribs and properties, these are used
  */
 void object_attrib_init(void) {
-    Object_Attrib_struct.attributes = ht_create();
+    Object_Attrib_struct.attributes = ht_create_lookup();
 }
 
 /**
@@ -236,6 +265,17 @@ static void obj_free(t_object *obj) {
     }
 }
 
+static void obj_traverse(t_object *obj, t_object_visit visit, void *arg) {
+    t_attrib_object *attr_obj = (t_attrib_object *) obj;
+
+    if (attr_obj->data.attribute) {
+        visit(attr_obj->data.attribute, arg);
+    }
+    if (attr_obj->data.bound_instance && attr_obj->data.bound_instance_decref) {
+        visit(attr_obj->data.bound_instance, arg);
+    }
+}
+
 static void obj_destroy(t_object *obj) {
     smm_free(obj);
 }
@@ -273,6 +313,7 @@ t_object_funcs attrib_funcs = {
 #else
     NULL,
 #endif
+    obj_traverse, // Traverse referenced objects
 };
 
 // Initial object
@@ -352,7 +352,7 @@ SAFFIRE_OPERATOR_METHOD(base, not) {
  * Initializes base methods and properties
  */
 void object_base_init() {
-    Object_Base_struct.attributes = ht_create();
+    Object_Base_struct.attributes = ht_create_lookup();
 
     object_add_internal_method((t_object *)&Object_Base_struct, "__ctor",         ATTRIB_METHOD_CTOR, ATTRIB_VISIBILITY_PUBLIC, object_base_method_ctor);
     object_add_internal_method((t_object *)&Object_Base_struct, "__dtor",         ATTRIB_METHOD_DTOR, ATTRIB_VISIBILITY_PUBLIC, object_base_method_dtor);
@@ -248,7 +248,7 @@ SAFFIRE_COMPARISON_METHOD(boolean, ge) {
  * Initializes string methods and properties, these are used
  */
 void object_boolean_init(void) {
-    Object_Boolean_struct.attributes = ht_create();
+    Object_Boolean_struct.attributes = ht_create_lookup();
 
     object_add_internal_method((t_object *)&Object_Boolean_struct, "__boolean",   ATTRIB_METHOD_NONE, ATTRIB_VISIBILITY_PUBLIC, object_boolean_method_conv_boolean);
     object_add_internal_method((t_object *)&Object_Boolean_struct, "__null",      ATTRIB_METHOD_NONE, ATTRIB_VISIBILITY_PUBLIC, object_boolean_method_conv_null);
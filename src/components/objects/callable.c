@@ -158,7 +158,7 @@ void object_callable_init(void) {
      *
      * @TODO: This will probably make us run into other problems i'm not 100% forseeing right now.. :(
      */
-    t_hash_table *attributes = ht_create();
+    t_hash_table *attributes = ht_create_lookup();
     object_add_internal_method_attributes(attributes, (t_object *)&Object_Callable_struct, "__ctor",         ATTRIB_METHOD_CTOR, ATTRIB_VISIBILITY_PUBLIC, object_callable_method_ctor);
 
     object_add_internal_method_attributes(attributes, (t_object *)&Object_Callable_struct, "__dtor",         ATTRIB_METHOD_DTOR, ATTRIB_VISIBILITY_PUBLIC, object_callable_method_dtor);
@@ -196,7 +196,10 @@ static void obj_populate(t_object *obj, t_dll *arg_list) {
     callable_obj->data.routing = DLL_DATA_LONG(e);
     e = DLL_NEXT(e);
 
-    if (CALLABLE_IS_CODE_INTERNAL(callable_obj)) {
+    if (CALLABLE_IS_CODE_DLL(callable_obj)) {
+        // internal code that still receives its arguments inside a DLL
+        callable_obj->data.code.internal.native_dll_func = DLL_DATA_PTR(e);
+    } else if (CALLABLE_IS_CODE_INTERNAL(callable_obj)) {
         // internal code is just a pointer to the code
         callable_obj->data.code.internal.native_func = DLL_DATA_PTR(e);
     } else {
@@ -214,6 +217,25 @@ static void obj_destroy(t_object *obj) {
     smm_free(obj);
 }
 
+static void obj_traverse(t_object *obj, t_object_visit visit, void *arg) {
+    t_callable_object *callable_obj = (t_callable_object *)obj;
+
+    if (callable_obj->data.binding) {
+        visit(callable_obj->data.binding, arg);
+    }
+
+    if (callable_obj->data.arguments) {
+        t_hash_iter iter;
+        ht_iter_init(&iter, callable_obj->data.arguments);
+        while (ht_iter_valid(&iter)) {
+            t_method_arg *arg_info = ht_iter_value(&iter);
+            if (arg_info->value) visit(arg_info->value, arg);
+            if (arg_info->typehint) visit((t_object *)arg_info->typehint, arg);
+            ht_iter_next(&iter);
+        }
+    }
+}
+
 static void obj_free(t_object *obj) {
     t_callable_object *callable_obj = (t_callable_object *)obj;
 
@@ -276,6 +298,7 @@ t_object_funcs callable_funcs = {
 #else
         NULL,
 #endif
+        obj_traverse,         // Traverse referenced objects
 };
 
 // Initial object
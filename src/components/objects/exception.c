@@ -65,11 +65,11 @@ SAFFIRE_METHOD(exception, conv_numerical) {
 }
 
 SAFFIRE_METHOD(exception, conv_string) {
-    RETURN_STRING(self->data.message);
+    RETURN_STRING(string_strdup(self->data.message));
 }
 
 SAFFIRE_METHOD(exception, getmessage) {
-    RETURN_STRING(self->data.message);
+    RETURN_STRING(string_strdup(self->data.message));
 }
 
 SAFFIRE_METHOD(exception, setmessage) {
@@ -104,7 +104,16 @@ SAFFIRE_METHOD(exception, getstacktrace) {
         RETURN_EMPTY_LIST();
     }
 
-    RETURN_LIST(self->data.stacktrace);
+    // The list holds its own elements, so don't hand over the stacktrace of the exception itself
+    t_hash_table *ht = ht_create();
+    t_hash_iter iter;
+    ht_iter_init(&iter, self->data.stacktrace);
+    while (ht_iter_valid(&iter)) {
+        ht_append_num(ht, ht_iter_value(&iter));
+        ht_iter_next(&iter);
+    }
+
+    RETURN_LIST(ht);
 }
 
 
@@ -149,7 +158,7 @@ void object_exception_add_generated_exceptions(void);
  * Initializes string methods and properties, these are used
  */
 void object_exception_init(void) {
-    Object_Exception_struct.attributes = ht_create();
+    Object_Exception_struct.attributes = ht_create_lookup();
 
     object_add_internal_method((t_object *)&Object_Exception_struct, "__ctor",   ATTRIB_METHOD_CTOR, ATTRIB_VISIBILITY_PUBLIC, object_exception_method_ctor);
 
@@ -32,6 +32,7 @@
 #include <saffire/objects/objects.h>
 #include <saffire/memory/smm.h>
 #include <saffire/general/md5.h>
+#include <saffire/general/hash/compact.h>
 #include <saffire/debug.h>
 #include <saffire/general/output.h>
 
@@ -40,6 +41,12 @@
  * ======================================================================
  */
 
+/**
+ * Creates the (insertion ordered) table that backs a hash object
+ */
+static t_hash_table *_hash_create_table(void) {
+    return ht_create_custom(8, 0.0, 0.0, &compact_hf);
+}
 
 
 /* ======================================================================
@@ -114,7 +121,7 @@ SAFFIRE_METHOD(hash, populate) {
     }
 
     if (! self->data.ht) {
-        self->data.ht = ht_create();
+        self->data.ht = _hash_create_table();
     }
 
     t_hash_iter iter;
@@ -306,7 +313,7 @@ SAFFIRE_METHOD(hash, conv_string) {
  * Initializes hash methods and properties, these are used
  */
 void object_hash_init(void) {
-    Object_Hash_struct.attributes = ht_create();
+    Object_Hash_struct.attributes = ht_create_lookup();
     object_add_internal_method((t_object *)&Object_Hash_struct, "__ctor",         ATTRIB_METHOD_CTOR, ATTRIB_VISIBILITY_PUBLIC, object_hash_method_ctor);
     object_add_internal_method((t_object *)&Object_Hash_struct, "__dtor",         ATTRIB_METHOD_DTOR, ATTRIB_VISIBILITY_PUBLIC, object_hash_method_dtor);
 
@@ -377,19 +384,29 @@ static void obj_populate(t_object *obj, t_dll *arg_list) {
 
     // No arguments
     if (arg_list->size == 0) {
-        hash_obj->data.ht = ht_create();
+        hash_obj->data.ht = _hash_create_table();
         return;
     }
 
     if (arg_list->size == 1) {
-        // Simple hash table. Direct copy
+        // Simple hash table. Direct copy, but the hash holds a reference to all its object keys and values
         t_dll_element *e = DLL_HEAD(arg_list);
         hash_obj->data.ht = DLL_DATA_PTR(e);
+
+        t_hash_iter iter;
+        ht_iter_init(&iter, hash_obj->data.ht);
+        while (ht_iter_valid(&iter)) {
+            if (ht_iter_key(&iter)->type == HASH_KEY_OBJ) {
+                object_inc_ref(ht_iter_key_obj(&iter));
+                object_inc_ref(ht_iter_value(&iter));
+            }
+            ht_iter_next(&iter);
+        }
         return;
     }
 
     // 2 (or higher). Use the DLL in arg2
-    hash_obj->data.ht = ht_create();
+    hash_obj->data.ht = _hash_create_table();
     t_dll_element *e = DLL_HEAD(arg_list);
     e = DLL_NEXT(e);
     t_dll *dll = DLL_DATA_PTR(e);
@@ -415,23 +432,35 @@ static void obj_free(t_object *obj) {
     t_hash_object *hash_obj = (t_hash_object *)obj;
     if (! hash_obj) return;
 
-    // Because this is a hash-object, we can only add objects to the hash itself,
-    // We must decrease their references as well
-
+    // Objects that are used as keys and values are referenced by the hash, so we must decrease their
+    // references as well. Hashes with string keys are used internally (identifiers), and don't hold any references.
     t_hash_iter iter;
     ht_iter_init(&iter, hash_obj->data.ht);
     while (ht_iter_valid(&iter)) {
-//        t_object *key = ht_iter_key_obj(&iter);
-//        t_object *val = ht_iter_value(&iter);
-//        DEBUG_PRINT_CHAR("KEY Hash decreasing reference: %08X from %d to %d\n", (unsigned int)key, key->ref_count, key->ref_count-1);
-//        DEBUG_PRINT_CHAR("VAL Hash decreasing reference: %08X from %d to %d\n", (unsigned int)val, val->ref_count, val->ref_count-1);
-
-//        object_release(key);
-//        object_release(val);
+        if (ht_iter_key(&iter)->type == HASH_KEY_OBJ) {
+            object_release(ht_iter_key_obj(&iter));
+            object_release(ht_iter_value(&iter));
+        }
         ht_iter_next(&iter);
     }
 
     ht_destroy(hash_obj->data.ht);
+    hash_obj->data.ht = NULL;
+}
+
+static void obj_traverse(t_object *obj, t_object_visit visit, void *arg) {
+    t_hash_object *hash_obj = (t_hash_object *)obj;
+    if (! hash_obj->data.ht) return;
+
+    t_hash_iter iter;
+    ht_iter_init(&iter, hash_obj->data.ht);
+    while (ht_iter_valid(&iter)) {
+        if (ht_iter_key(&iter)->type == HASH_KEY_OBJ) {
+            visit(ht_iter_key_obj(&iter), arg);
+            visit(ht_iter_value(&iter), arg);
+        }
+        ht_iter_next(&iter);
+    }
 }
 
 static void obj_destroy(t_object *obj) {
@@ -461,10 +490,11 @@ t_object_funcs hash_funcs = {
         NULL,                 // Cache
         NULL,                 // Hash
 #ifdef __DEBUG
-        obj_debug
+        obj_debug,
 #else
         NULL,
 #endif
+        obj_traverse,         // Traverse referenced objects
 };
 
 
@@ -40,6 +40,51 @@
  * ======================================================================
  */
 
+#define LIST_INITIAL_CAPACITY      8        // Number of slots allocated for the first element
+
+/**
+ * Makes sure the list can hold at least capacity elements without reallocating
+ */
+void object_list_reserve(t_list_object *list_obj, long capacity) {
+    if (capacity <= list_obj->data.capacity) return;
+
+    list_obj->data.elements = smm_realloc(list_obj->data.elements, capacity * sizeof(t_object *));
+    list_obj->data.capacity = capacity;
+}
+
+/**
+ * Appends an object to the end of the list. The list holds a reference to the object.
+ */
+void object_list_append(t_list_object *list_obj, t_object *obj) {
+    if (list_obj->data.length == list_obj->data.capacity) {
+        object_list_reserve(list_obj, list_obj->data.capacity ? list_obj->data.capacity * 2 : LIST_INITIAL_CAPACITY);
+    }
+
+    object_inc_ref(obj);
+    list_obj->data.elements[list_obj->data.length++] = obj;
+}
+
+/**
+ * Stores an object at index idx of the list. Storing directly after the last element appends it. Returns 0 on
+ * success, or -1 (and raises an exception) when the index is out of range.
+ */
+int object_list_set(t_list_object *list_obj, long idx, t_object *obj) {
+    if (idx == list_obj->data.length) {
+        object_list_append(list_obj, obj);
+        return 0;
+    }
+
+    // Check index boundaries
+    if (idx < 0 || idx > list_obj->data.length) {
+        object_raise_exception(Object_IndexException, 1, "Index out of range");
+        return -1;
+    }
+
+    object_inc_ref(obj);
+    object_release(list_obj->data.elements[idx]);
+    list_obj->data.elements[idx] = obj;
+    return 0;
+}
 
 
 /* ======================================================================
@@ -67,7 +112,7 @@ SAFFIRE_METHOD(list, dtor) {
  * Saffire method: Returns the number of elements stored inside the list
  */
 SAFFIRE_METHOD(list, length) {
-    RETURN_NUMERICAL(self->data.ht->element_count);
+    RETURN_NUMERICAL(self->data.length);
 }
 
 SAFFIRE_METHOD(list, __iterator) {
@@ -77,9 +122,8 @@ SAFFIRE_METHOD(list, __key) {
     RETURN_NUMERICAL(self->data.iter.idx);
 }
 SAFFIRE_METHOD(list, __value) {
-    t_object *obj = ht_find_num(self->data.ht, self->data.iter.idx);
-    if (obj == NULL) RETURN_NULL;
-    RETURN_OBJECT(obj);
+    if (self->data.iter.idx < 0 || self->data.iter.idx >= self->data.length) RETURN_NULL;
+    RETURN_OBJECT(self->data.elements[self->data.iter.idx]);
 }
 SAFFIRE_METHOD(list, __next) {
     self->data.iter.idx++;
@@ -90,7 +134,7 @@ SAFFIRE_METHOD(list, __rewind) {
     RETURN_SELF;
 }
 SAFFIRE_METHOD(list, __hasNext) {
-    if (self->data.iter.idx < self->data.ht->element_count) {
+    if (self->data.iter.idx < self->data.length) {
         RETURN_TRUE;
     }
     RETURN_FALSE;
@@ -107,9 +151,118 @@ SAFFIRE_METHOD(list, get) {
         return NULL;
     }
 
-    t_object *obj = ht_find_num(self->data.ht, key);
-    if (obj == NULL) RETURN_NULL;
-    RETURN_OBJECT(obj);
+    if (key < 0 || key >= self->data.length) RETURN_NULL;
+    RETURN_OBJECT(self->data.elements[key]);
+}
+
+
+/**
+  * Saffire method: Returns object stored at index inside the list
+  */
+SAFFIRE_METHOD(list, __get) {
+    long idx;
+
+    if (object_parse_arguments(SAFFIRE_METHOD_ARGS, "n", &idx) != 0) {
+        return NULL;
+    }
+
+    // Check index boundaries
+    if (idx < 0 || idx >= self->data.length) {
+        object_raise_exception(Object_IndexException, 1, "Index out of range");
+        return NULL;
+    }
+
+    RETURN_OBJECT(self->data.elements[idx]);
+}
+
+/**
+  * Saffire method: Returns a new list with the elements from index "from" up to and including index "to", just
+  * like string subscriptions. A null index is the start or the end of the list.
+  */
+SAFFIRE_METHOD(list, __splice) {
+    t_object *from_obj, *to_obj;
+
+    if (object_parse_arguments(SAFFIRE_METHOD_ARGS, "oo", &from_obj, &to_obj) != 0) {
+        return NULL;
+    }
+
+    if ((! OBJECT_IS_NUMERICAL(from_obj) && ! OBJECT_IS_NULL(from_obj)) ||
+        (! OBJECT_IS_NUMERICAL(to_obj) && ! OBJECT_IS_NULL(to_obj))
+    ) {
+        object_raise_exception(Object_ArgumentException, 1, "List subscriptions must be numerical");
+        return NULL;
+    }
+
+    long from = OBJECT_IS_NUMERICAL(from_obj) ? OBJ2NUM(from_obj) : 0;
+    long to = OBJECT_IS_NUMERICAL(to_obj) ? OBJ2NUM(to_obj) : self->data.length - 1;
+
+    // Check index boundaries. A range that ends right before its start is empty.
+    if (from < 0 || from > self->data.length || to >= self->data.length || to < from - 1) {
+        object_raise_exception(Object_IndexException, 1, "Index out of range");
+        return NULL;
+    }
+
+    t_list_object *list_obj = (t_list_object *)object_alloc_instance(Object_List, 0);
+    object_list_reserve(list_obj, to - from + 1);
+    for (long i=from; i<=to; i++) {
+        object_list_append(list_obj, self->data.elements[i]);
+    }
+
+    RETURN_OBJECT(list_obj);
+}
+
+/**
+  * Saffire method: Stores object at index inside the list. Storing directly after the last element appends it.
+  */
+SAFFIRE_METHOD(list, __set) {
+    long idx;
+    t_object *val;
+
+    if (object_parse_arguments(SAFFIRE_METHOD_ARGS, "no", &idx, &val) != 0) {
+        return NULL;
+    }
+
+    if (object_list_set(self, idx, val) != 0) {
+        return NULL;
+    }
+    RETURN_SELF;
+}
+
+/**
+  * Saffire method: Returns true when the index is present in the list
+  */
+SAFFIRE_METHOD(list, __has) {
+    long idx;
+
+    if (object_parse_arguments(SAFFIRE_METHOD_ARGS, "n", &idx) != 0) {
+        return NULL;
+    }
+
+    if (idx < 0 || idx >= self->data.length) {
+        RETURN_FALSE;
+    }
+    RETURN_TRUE;
+}
+
+/**
+  * Saffire method: Removes the element at index, moving all following elements one place down
+  */
+SAFFIRE_METHOD(list, __remove) {
+    long idx;
+
+    if (object_parse_arguments(SAFFIRE_METHOD_ARGS, "n", &idx) != 0) {
+        return NULL;
+    }
+
+    if (idx < 0 || idx >= self->data.length) {
+        object_raise_exception(Object_IndexException, 1, "Index out of range");
+        return NULL;
+    }
+
+    object_release(self->data.elements[idx]);
+    memmove(&self->data.elements[idx], &self->data.elements[idx + 1], (self->data.length - idx - 1) * sizeof(t_object *));
+    self->data.length--;
+    RETURN_SELF;
 }
 
 
@@ -138,16 +291,11 @@ SAFFIRE_METHOD(list, shuffle) {
     }
 
 
-    // The hashtable has a linked list, we shuffle this one as it is used during iteration
-    for (int i = self->data.ht->element_count-1; i >= 1; i--) {
-        /* because we are exchanging values, the keys can stay the same. We basically fetch the
-         * objects and swap them. */
-
-        int j = (rand () % i);
-        t_object *obj1 = ht_find_num(self->data.ht, i);
-        t_object *obj2 = ht_find_num(self->data.ht, j);
-        ht_replace_num(self->data.ht, i, obj2);
-        ht_replace_num(self->data.ht, j, obj1);
+    for (long i = self->data.length-1; i >= 1; i--) {
+        long j = (rand () % i);
+        t_object *obj = self->data.elements[i];
+        self->data.elements[i] = self->data.elements[j];
+        self->data.elements[j] = obj;
     }
     RETURN_SELF;
 }
@@ -161,9 +309,8 @@ SAFFIRE_METHOD(list, random) {
         srand(rdtscll());
     }
 
-    t_object *obj = ht_find_num(self->data.ht, (rand () % self->data.ht->element_count));
-    if (obj == NULL) RETURN_NULL;
-    RETURN_OBJECT(obj);
+    if (self->data.length == 0) RETURN_NULL;
+    RETURN_OBJECT(self->data.elements[rand () % self->data.length]);
 }
 
 /**
@@ -176,7 +323,7 @@ SAFFIRE_METHOD(list, add) {
         return NULL;
     }
 
-    ht_add_num(self->data.ht, self->data.ht->element_count, val);
+    object_list_append(self, val);
     RETURN_SELF;
 }
 
@@ -196,14 +343,12 @@ SAFFIRE_METHOD(list, populate) {
         return NULL;
     }
 
-    if (! self->data.ht) {
-        self->data.ht = ht_create();
-    }
+    object_list_reserve(self, self->data.length + ht_obj->data.ht->element_count);
 
     t_hash_iter iter;
     ht_iter_init(&iter, ht_obj->data.ht);
     while (ht_iter_valid(&iter)) {
-        ht_add_num(self->data.ht, self->data.ht->element_count, ht_iter_value(&iter));
+        object_list_append(self, ht_iter_value(&iter));
         ht_iter_next(&iter);
     }
 
@@ -234,8 +379,9 @@ SAFFIRE_METHOD(list, sequence) {
     }
 
     t_list_object *list_obj = (t_list_object *)object_alloc_instance(Object_List, 0);
-    for (int i=from; i<=to; i+=skip) {
-        ht_add_num(list_obj->data.ht, list_obj->data.ht->element_count, object_alloc_instance(Object_Numerical, 1, i));
+    object_list_reserve(list_obj, (to - from) / skip + 1);
+    for (long i=from; i<=to; i+=skip) {
+        object_list_append(list_obj, object_alloc_instance(Object_Numerical, 1, i));
     }
 
     RETURN_OBJECT(list_obj);
@@ -247,7 +393,7 @@ SAFFIRE_METHOD(list, sequence) {
  *
  */
 SAFFIRE_METHOD(list, conv_boolean) {
-    if (self->data.ht->element_count == 0) {
+    if (self->data.length == 0) {
         RETURN_FALSE;
     } else {
         RETURN_TRUE;
@@ -265,7 +411,7 @@ SAFFIRE_METHOD(list, conv_null) {
  *
  */
 SAFFIRE_METHOD(list, conv_numerical) {
-    RETURN_NUMERICAL(self->data.ht->element_count);
+    RETURN_NUMERICAL(self->data.length);
 }
 
 /**
@@ -274,7 +420,7 @@ SAFFIRE_METHOD(list, conv_numerical) {
 SAFFIRE_METHOD(list, conv_string) {
     char s[100];
 
-    snprintf(s, 99, "list[%d]", self->data.ht->element_count);
+    snprintf(s, 99, "list[%ld]", self->data.length);
     RETURN_STRING_FROM_CHAR(s);
 }
 
@@ -301,7 +447,7 @@ SAFFIRE_METHOD(list, conv_string) {
  * Initializes list methods and properties, these are used
  */
 void object_list_init(void) {
-    Object_List_struct.attributes = ht_create();
+    Object_List_struct.attributes = ht_create_lookup();
 
     object_add_internal_method((t_object *)&Object_List_struct, "__ctor",         ATTRIB_METHOD_CTOR, ATTRIB_VISIBILITY_PUBLIC, object_list_method_ctor);
     object_add_internal_method((t_object *)&Object_List_struct, "__dtor",         ATTRIB_METHOD_DTOR, ATTRIB_VISIBILITY_PUBLIC, object_list_method_dtor);
@@ -331,6 +477,13 @@ void object_list_init(void) {
 
     object_add_internal_method((t_object *)&Object_List_struct, "sequence",       ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, object_list_method_sequence);
 
+    // Subscription interface
+    object_add_internal_method((t_object *)&Object_List_struct, "__set",          ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, object_list_method___set);
+    object_add_internal_method((t_object *)&Object_List_struct, "__remove",       ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, object_list_method___remove);
+    object_add_internal_method((t_object *)&Object_List_struct, "__get",          ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, object_list_method___get);
+    object_add_internal_method((t_object *)&Object_List_struct, "__has",          ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, object_list_method___has);
+    object_add_internal_method((t_object *)&Object_List_struct, "__splice",       ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, object_list_method___splice);
+
 //    // list + element
 //    object_add_internal_method((t_object *)&Object_List_struct, "__opr_add",      ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, object_list_method_opr_add);
 //    // list << N  shifts elements from the list
@@ -341,6 +494,7 @@ void object_list_init(void) {
 
     object_add_interface((t_object *)&Object_List_struct, Object_Iterator);
     object_add_interface((t_object *)&Object_List_struct, Object_Datastructure);
+    object_add_interface((t_object *)&Object_List_struct, Object_Subscription);
 
     vm_populate_builtins("list", (t_object *)&Object_List_struct);
 }
@@ -358,28 +512,40 @@ void object_list_fini(void) {
 static void obj_populate(t_object *obj, t_dll *arg_list) {
     t_list_object *list_obj = (t_list_object *)obj;
 
+    list_obj->data.elements = NULL;
+    list_obj->data.length = 0;
+    list_obj->data.capacity = 0;
+
     // No arguments
     if (arg_list->size == 0) {
-        list_obj->data.ht = ht_create();
         return;
     }
 
     if (arg_list->size == 1) {
-        // Simple hash table. Direct copy
+        // Simple hash table. The list takes over the values, and the hash table itself
         t_dll_element *e = DLL_HEAD(arg_list);
-        list_obj->data.ht = DLL_DATA_PTR(e);
+        t_hash_table *ht = DLL_DATA_PTR(e);
+
+        object_list_reserve(list_obj, ht->element_count);
+
+        t_hash_iter iter;
+        ht_iter_init(&iter, ht);
+        while (ht_iter_valid(&iter)) {
+            object_list_append(list_obj, ht_iter_value(&iter));
+            ht_iter_next(&iter);
+        }
+        ht_destroy(ht);
         return;
     }
 
     // 2 (or higher). Use the DLL in arg2
-    list_obj->data.ht = ht_create();
     t_dll_element *e = DLL_HEAD(arg_list);
     e = DLL_NEXT(e);
     t_dll *dll = DLL_DATA_PTR(e);
+    object_list_reserve(list_obj, dll->size);
     e = DLL_HEAD(dll);    // 2nd elementof the DLL is a DLL itself.. inception!
     while (e) {
-        t_object *val = DLL_DATA_PTR(e);
-        ht_add_num(list_obj->data.ht, list_obj->data.ht->element_count, val);
+        object_list_append(list_obj, DLL_DATA_PTR(e));
         e = DLL_NEXT(e);
     }
 }
@@ -388,8 +554,22 @@ static void obj_free(t_object *obj) {
     t_list_object *list_obj = (t_list_object *)obj;
     if (! list_obj) return;
 
-    if (list_obj->data.ht) {
-        ht_destroy(list_obj->data.ht);
+    // Release all elements
+    for (long i=0; i!=list_obj->data.length; i++) {
+        object_release(list_obj->data.elements[i]);
+    }
+
+    smm_free(list_obj->data.elements);
+    list_obj->data.elements = NULL;
+    list_obj->data.length = 0;
+    list_obj->data.capacity = 0;
+}
+
+static void obj_traverse(t_object *obj, t_object_visit visit, void *arg) {
+    t_list_object *list_obj = (t_list_object *)obj;
+
+    for (long i=0; i!=list_obj->data.length; i++) {
+        visit(list_obj->data.elements[i], arg);
     }
 }
 
@@ -401,11 +581,7 @@ static void obj_destroy(t_object *obj) {
 static char *obj_debug(t_object *obj) {
     t_list_object *list_obj = (t_list_object *)obj;
 
-    if (list_obj->data.ht) {
-        snprintf(list_obj->__debug_info, DEBUG_INFO_SIZE-1, "list[%d]", list_obj->data.ht->element_count);
-    } else {
-        snprintf(list_obj->__debug_info, DEBUG_INFO_SIZE-1, "list[]");
-    }
+    snprintf(list_obj->__debug_info, DEBUG_INFO_SIZE-1, "list[%ld]", list_obj->data.length);
     return list_obj->__debug_info;
 }
 #endif
@@ -424,6 +600,7 @@ t_object_funcs list_funcs = {
 #else
         NULL,
 #endif
+        obj_traverse,         // Traverse referenced objects
 };
 
 
@@ -432,7 +609,9 @@ t_object_funcs list_funcs = {
 t_list_object Object_List_struct = {
     OBJECT_HEAD_INIT("list", objectTypeList, OBJECT_TYPE_CLASS, &list_funcs, sizeof(t_list_object_data)),
     {
-        NULL,
+        NULL,       // Elements
+        0,          // Length
+        0,          // Capacity
         {
             0,
         }
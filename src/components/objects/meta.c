@@ -39,6 +39,24 @@
  * ======================================================================
  */
 
+/**
+ * Creates the attributes of a meta object. Meta objects are created for every iteration of a foreach, so this is
+ * only done when its attributes are actually read.
+ */
+void object_meta_populate_attributes(t_meta_object *meta_obj) {
+    if (meta_obj->data.populated) return;
+    meta_obj->data.populated = 1;
+
+    t_object *obj = (t_object *)meta_obj;
+    long index = meta_obj->data.index;
+    long count = meta_obj->data.count;
+
+    object_add_constant(obj, "first", ATTRIB_TYPE_CONSTANT | ATTRIB_ACCESS_RO | ATTRIB_VISIBILITY_PUBLIC, index == 0 ? Object_True : Object_False);
+    object_add_constant(obj, "last", ATTRIB_TYPE_CONSTANT | ATTRIB_ACCESS_RO | ATTRIB_VISIBILITY_PUBLIC, (count > 0 && index == count - 1) ? Object_True : Object_False);
+    object_add_constant(obj, "count", ATTRIB_TYPE_CONSTANT | ATTRIB_ACCESS_RO | ATTRIB_VISIBILITY_PUBLIC, NUM2OBJ(count));
+    object_add_constant(obj, "index", ATTRIB_TYPE_CONSTANT | ATTRIB_ACCESS_RO | ATTRIB_VISIBILITY_PUBLIC, NUM2OBJ(index));
+}
+
 /* ======================================================================
  *   Object methods
  * ======================================================================
@@ -53,7 +71,7 @@
  * Initializes meta methods and properties, these are used
  */
 void object_meta_init(void) {
-    Object_Meta_struct.attributes = ht_create();
+    Object_Meta_struct.attributes = ht_create_lookup();
 }
 
 /**
@@ -65,6 +83,17 @@ void object_meta_fini(void) {
 }
 
 
+static void obj_populate(t_object *obj, t_dll *arg_list) {
+    t_meta_object *meta_obj = (t_meta_object *)obj;
+
+    t_dll_element *e = DLL_HEAD(arg_list);
+    meta_obj->data.index = e->data.l;
+    e = DLL_NEXT(e);
+    meta_obj->data.count = e->data.l;
+
+    meta_obj->data.populated = 0;
+}
+
 static void obj_destroy(t_object *obj) {
     smm_free(obj);
 }
@@ -78,7 +107,7 @@ static void obj_destroy(t_object *obj) {
 static char *obj_debug(t_object *obj) {
     t_meta_object *str_obj = (t_meta_object *)obj;
 
-    snprintf(str_obj->__debug_info, DEBUG_INFO_SIZE-1, "meta()");
+    snprintf(str_obj->__debug_info, DEBUG_INFO_SIZE-1, "meta(%ld/%ld)", str_obj->data.index, str_obj->data.count);
     return str_obj->__debug_info;
 }
 #endif
@@ -87,7 +116,7 @@ static char *obj_debug(t_object *obj) {
 
 // meta object management functions
 t_object_funcs meta_funcs = {
-        NULL,                 // Populate a meta object
+        obj_populate,         // Populate a meta object
         NULL,                 // Free a meta object
         obj_destroy,          // Destroy a meta object
         NULL,                 // Clone
@@ -103,6 +132,7 @@ t_object_funcs meta_funcs = {
 
 // Intial object
 t_meta_object Object_Meta_struct = {
-    OBJECT_HEAD_INIT("meta", objectTypeUser, OBJECT_TYPE_CLASS, &meta_funcs, 0),
+    OBJECT_HEAD_INIT("meta", objectTypeUser, OBJECT_TYPE_CLASS, &meta_funcs, sizeof(t_meta_object_data)),
+    { 0, 0, 0 },
     OBJECT_FOOTER
 };
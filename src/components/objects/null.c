@@ -53,8 +53,7 @@ SAFFIRE_METHOD(null, conv_string) {
 }
 
 SAFFIRE_COMPARISON_METHOD(null, ne) {
-    t_dll_element *e = DLL_HEAD(arguments);
-    t_object *obj = DLL_DATA_PTR(e);
+    t_object *obj = argv[0];
 
     if(OBJECT_IS_NULL(obj)) {
         RETURN_FALSE;
@@ -78,7 +77,7 @@ SAFFIRE_OPERATOR_METHOD(null, not) {
  * Initializes string methods and properties, these are used
  */
 void object_null_init(void) {
-    Object_Null_struct.attributes = ht_create();
+    Object_Null_struct.attributes = ht_create_lookup();
 
     object_add_internal_method((t_object *)&Object_Null_struct, "__boolean",   ATTRIB_METHOD_NONE, ATTRIB_VISIBILITY_PUBLIC, object_null_method_conv_boolean);
     object_add_internal_method((t_object *)&Object_Null_struct, "__null",      ATTRIB_METHOD_NONE, ATTRIB_VISIBILITY_PUBLIC, object_null_method_conv_null);
@@ -168,7 +168,7 @@ SAFFIRE_METHOD(numerical, hex) {
 }
 
 SAFFIRE_METHOD(numerical, conv_string) {
-    return object_numerical_method_dec(self, arguments);
+    return object_numerical_method_dec(self, SAFFIRE_METHOD_ARGS);
 }
 
 
@@ -378,7 +378,7 @@ SAFFIRE_COMPARISON_METHOD(numerical, ge) {
  * Initializes numerical methods and properties
  */
 void object_numerical_init(void) {
-    Object_Numerical_struct.attributes = ht_create();
+    Object_Numerical_struct.attributes = ht_create_lookup();
     object_add_internal_method((t_object *)&Object_Numerical_struct, "__ctor",        ATTRIB_METHOD_CTOR, ATTRIB_VISIBILITY_PUBLIC, object_numerical_method_ctor);
     object_add_internal_method((t_object *)&Object_Numerical_struct, "__dtor",        ATTRIB_METHOD_DTOR, ATTRIB_VISIBILITY_PUBLIC, object_numerical_method_dtor);
 
@@ -455,6 +455,16 @@ void object_numerical_fini(void) {
     object_free_internal_object((t_object *)&Object_Numerical_struct);
 }
 
+/**
+ * Returns a numerical object for a tagged numerical, so it can be used as a real object. Any other object is returned
+ * as-is. Small values are returned from the numerical cache.
+ */
+t_object *object_numerical_box(t_object *obj) {
+    if (! OBJECT_IS_TAGGED(obj)) return obj;
+
+    return NUM2OBJ(TAGGED2NUM(obj));
+}
+
 
 
 static t_object *obj_cache(t_object *obj, t_dll *arg_list) {
@@ -469,10 +479,12 @@ static t_object *obj_cache(t_object *obj, t_dll *arg_list) {
     return NULL;
 }
 
-static char *obj_hash(t_object *obj) {
-    char *s = (char *)smm_malloc(32);
-    snprintf(s, 31, "%ld", ((t_numerical_object *)obj)->data.value);
-    return s;
+static uint64_t obj_hash(t_object *obj) {
+    return (uint64_t)((t_numerical_object *)obj)->data.value;
+}
+
+static int obj_equals(t_object *obj1, t_object *obj2) {
+    return ((t_numerical_object *)obj1)->data.value == ((t_numerical_object *)obj2)->data.value;
 }
 
 
@@ -513,6 +525,8 @@ t_object_funcs numerical_funcs = {
 #else
         NULL,
 #endif
+        NULL,               // Traverse
+        obj_equals,         // Equals
 };
 
 
@@ -39,6 +39,8 @@
 #include <saffire/debug.h>
 #include <saffire/gc/gc.h>
 #include <saffire/general/output.h>
+#include <saffire/general/hash/hash_funcs.h>
+#include <saffire/general/symbol.h>
 #include <saffire/memory/smm.h>
 #include <saffire/vm/thread.h>
 
@@ -68,6 +70,7 @@ const char *objectOprMethods[14] = { "__opr_add", "__opr_sub", "__opr_mul", "__o
 static void object_duplicate_interfaces(t_object *src_obj, t_object *dst_obj);
 static void object_duplicate_attributes(t_object *src_obj, t_object *dst_obj);
 static void object_instantiate(t_object *instance_obj, t_object *class_obj);
+static void _object_free_speclists(void);
 
 /**
  * Checks if an object is an instance of a class. Will check against parents too.
@@ -97,21 +100,12 @@ int object_instance_of(t_object *obj, const char *instance) {
 
 
 /**
- * Free an object (if needed)
+ * Releases everything an object holds: attributes, interfaces, its data and its name. The object itself stays
+ * allocated.
  */
-static void _object_free(t_object *obj) {
-    if (! obj) return;
-
-    // ref_count > 0, object is still in use somewhere else. Don't free it yet
-    if (obj->ref_count > 0) return;
-
-#ifdef __DEBUG
-#if __DEBUG_FREE_OBJECT
-    if (! OBJECT_IS_CALLABLE(obj) && ! OBJECT_IS_ATTRIBUTE(obj)) {
-        DEBUG_PRINT_CHAR("Freeing object: %p\n", obj);
-    }
-#endif
-#endif
+static void _object_free_contents(t_object *obj) {
+    // A new class could be allocated on the same address, so drop all cached attribute lookups
+    if (OBJECT_TYPE_IS_CLASS(obj)) object_attrib_generation++;
 
     // Free attributes
     t_hash_iter iter;
@@ -154,23 +148,96 @@ static void _object_free(t_object *obj) {
         smm_free(obj->name);
         obj->name = NULL;
     }
+}
 
-    // Free the object itself
-    if (obj->funcs && obj->funcs->destroy) {
+
+/**
+ * Destroys the object itself, or keeps its memory in the recycle queue for the next allocation of this type
+ */
+static void _object_destroy(t_object *obj) {
+    if (obj->funcs && obj->funcs->destroy && ! gc_queue_add(obj)) {
         obj->funcs->destroy(obj);
     }
+}
+
+
+/**
+ * Free an object (if needed)
+ */
+static void _object_free(t_object *obj) {
+    if (! obj) return;
+
+    // ref_count > 0, object is still in use somewhere else. Don't free it yet
+    if (obj->ref_count > 0) return;
+
+#ifdef __DEBUG
+#if __DEBUG_FREE_OBJECT
+    if (! OBJECT_IS_CALLABLE(obj) && ! OBJECT_IS_ATTRIBUTE(obj)) {
+        DEBUG_PRINT_CHAR("Freeing object: %p\n", obj);
+    }
+#endif
+#endif
+
+    // The cycle collector might already have released everything this object holds
+    if ((obj->flags & OBJECT_GC_CLEARED) == 0) {
+        _object_free_contents(obj);
+    }
+
+    // The possible roots buffer of the cycle collector still points to this object. The collector will
+    // destroy it when it handles the buffer.
+    if ((obj->flags & OBJECT_GC_BUFFERED) == OBJECT_GC_BUFFERED) return;
+
+    _object_destroy(obj);
 
     // Object is destroyed. We cannot use object anymore.
     obj = NULL;
+}
 
 
-    // @TODO: here we should actually add the object to the GC destruction queue.
-    // If we need the object later, we can still catch it from this queue, otherwise it will
-    // be destroyed somewhere in the future.
+/**
+ * Visits all objects that are referenced by the given object: its attributes, its interfaces and everything
+ * referenced from its data.
+ */
+void object_traverse(t_object *obj, t_object_visit visit, void *arg) {
+    if (obj->attributes) {
+        t_hash_iter iter;
+        ht_iter_init(&iter, obj->attributes);
+        while (ht_iter_valid(&iter)) {
+            visit((t_object *)ht_iter_value(&iter), arg);
+            ht_iter_next(&iter);
+        }
+    }
+
+    if (obj->interfaces) {
+        t_dll_element *e = DLL_HEAD(obj->interfaces);
+        while (e) {
+            visit(DLL_DATA_PTR(e), arg);
+            e = DLL_NEXT(e);
+        }
+    }
 
-//    if (! gc_queue_add(obj) && obj->funcs && obj->funcs->destroy) {
-//        obj->funcs->destroy(obj);
-//    }
+    if (obj->funcs && obj->funcs->traverse) {
+        obj->funcs->traverse(obj, visit, arg);
+    }
+}
+
+
+/**
+ * Releases everything a garbage object holds, so reference cycles are broken. The object itself is destroyed
+ * when its last reference is released.
+ */
+void object_gc_clear(t_object *obj) {
+    _object_free_contents(obj);
+    obj->flags |= OBJECT_GC_CLEARED;
+}
+
+
+/**
+ * Destroys an object that was freed while it was in the possible roots buffer of the cycle collector
+ */
+void object_gc_destroy(t_object *obj) {
+    obj->flags &= ~OBJECT_GC_MASK;
+    _object_destroy(obj);
 }
 
 
@@ -184,6 +251,9 @@ t_hash_table *refcount_objects = NULL;
 void object_inc_ref(t_object *obj) {
     if (! obj) return;
 
+    // Tagged numericals are not reference counted
+    if (OBJECT_IS_TAGGED(obj)) return;
+
     obj->ref_count++;
 
 #ifdef __DEBUG
@@ -207,6 +277,9 @@ void object_inc_ref(t_object *obj) {
 static long object_dec_ref(t_object *obj) {
     if (! obj) return 0;
 
+    // Tagged numericals are never freed
+    if (OBJECT_IS_TAGGED(obj)) return 1;
+
     if (obj->ref_count == 0) {
         fprintf(stderr, "sanity check failed: ref-count of object %p\n", obj);
         abort();
@@ -224,6 +297,10 @@ static long object_dec_ref(t_object *obj) {
 #endif
 
     if (obj->ref_count != 0) {
+        // The remaining references could all come from a reference cycle
+        if (GC_IS_POSSIBLE_ROOT(obj)) {
+            gc_possible_root(obj);
+        }
         return obj->ref_count;
     }
 
@@ -248,10 +325,17 @@ static long object_dec_ref(t_object *obj) {
 
 #ifdef __DEBUG
 char *object_debug(t_object *obj) {
+    static char tagged_debug_info[DEBUG_INFO_SIZE];
+
     if (! obj) {
         return "no object";
     }
 
+    if (OBJECT_IS_TAGGED(obj)) {
+        snprintf(tagged_debug_info, DEBUG_INFO_SIZE-1, "numerical(%ld) [tagged]", TAGGED2NUM(obj));
+        return tagged_debug_info;
+    }
+
     if (obj->__debug_info_available == 0) {
         return "no object info available";
     }
@@ -266,6 +350,25 @@ char *object_debug(t_object *obj) {
 #endif
 
 
+/**
+ * Allocates the memory for an object of the given type and data size. Memory from freed objects of the
+ * same type is reused when available. The memory is not initialized.
+ */
+t_object *object_alloc_memory(int type, int data_size) {
+    GC_COUNT_ALLOCATION();
+
+    t_object *obj = gc_queue_recycle(type, data_size);
+    if (obj) return obj;
+
+#ifdef __DEBUG
+    // In debug mode, allocate 200 bytes extra for __debug_info
+    return smm_malloc(sizeof(t_object) + data_size + DEBUG_INFO_SIZE);
+#else
+    return smm_malloc(sizeof(t_object) + data_size);
+#endif
+}
+
+
 /**
  * Clones an object and returns this new object
  */
@@ -273,11 +376,12 @@ t_object *object_clone(t_object *orig_obj) {
     assert(orig_obj != NULL);
 
     // Allocate new object with correct size and copy data
-    t_object *clone_obj = smm_malloc(sizeof(t_object) + orig_obj->data_size);
+    t_object *clone_obj = object_alloc_memory(orig_obj->type, orig_obj->data_size);
     memcpy(clone_obj, orig_obj, sizeof(t_object) + orig_obj->data_size);
 
     // New separated object gets refcount 0
     clone_obj->ref_count = 0;
+    clone_obj->flags &= ~OBJECT_GC_MASK;
     clone_obj->name = string_strdup0(orig_obj->name);
 
     if (clone_obj->class) {
@@ -313,22 +417,23 @@ t_object *object_clone(t_object *orig_obj) {
 static void object_duplicate_attributes(t_object *src_obj, t_object *dst_obj) {
     if (! src_obj->attributes) return;
 
-    t_hash_table *duplicated_attributes = ht_create();
+    t_hash_table *duplicated_attributes = ht_create_lookup();
 
     t_hash_iter iter;
     ht_iter_init(&iter, src_obj->attributes);
     while (ht_iter_valid(&iter)) {
-        char *name = ht_iter_key_str(&iter);
+        t_symbol *name = ht_iter_key_sym(&iter);
+        if (! name) name = symbol_intern0(ht_iter_key_str(&iter));
         t_attrib_object *attrib = ht_iter_value(&iter);
 
         // Duplicate attribute into new instance
         t_attrib_object *dup_attrib = object_attrib_duplicate(attrib, dst_obj);
 
         // We "bind" the attribute to this class
-        object_attrib_bind(dup_attrib, dst_obj, name);
+        object_attrib_bind(dup_attrib, dst_obj, name->s);
 
         // Replace the current attribute with the dupped one
-        ht_add_str(duplicated_attributes, name, (void *)dup_attrib);
+        ht_add_sym(duplicated_attributes, name, (void *)dup_attrib);
 
         // Increase reference to the duplicated attribute
         object_inc_ref((t_object *)dup_attrib);
@@ -342,21 +447,32 @@ static void object_duplicate_attributes(t_object *src_obj, t_object *dst_obj) {
 
 
 /**
- * Returns a hash-string of the given object. By default this is the address of the object, but it could
+ * Returns a 64bit hash of the given object. By default this is based on the address of the object, but it could
  * also be a more customized hash function within an object itself.
  */
-char *object_get_hash(t_object *obj) {
+uint64_t object_get_hash(t_object *obj) {
     // When there is no hash function, we just use the address of the object
     if (! obj->funcs->hash) {
-        char *tmp = (char *)smm_malloc(32);
-        snprintf(tmp, 31, "%ld", (long)obj);
-        return tmp;
+        return (uintptr_t)obj >> 4;
     }
 
     // Return objects hash
     return obj->funcs->hash(obj);
 }
 
+/**
+ * Returns 1 when both objects are equal. Objects without an equals function are only equal to themselves.
+ */
+int object_equals(t_object *obj1, t_object *obj2) {
+    if (obj1 == obj2) return 1;
+
+    if (obj1->funcs != obj2->funcs || ! obj1->funcs->equals) {
+        return 0;
+    }
+
+    return obj1->funcs->equals(obj1, obj2);
+}
+
 
 
 /**
@@ -394,17 +510,16 @@ static t_object *_object_allocate_with_args(t_object *obj, t_dll *arguments, int
     // Nothing found in cache, create new object
 
     // Create new object
+    res = object_alloc_memory(obj->type, obj->data_size);
 #ifdef __DEBUG
-    // In debug mode, allocate 200 bytes extra for __debug_info
-    res = smm_malloc(sizeof(t_object) + obj->data_size + DEBUG_INFO_SIZE);
     memcpy(res, obj, sizeof(t_object) + obj->data_size + DEBUG_INFO_SIZE);
 #else
-    res = smm_malloc(sizeof(t_object) + obj->data_size);
     memcpy(res, obj, sizeof(t_object) + obj->data_size);
 #endif
 
     // Since we just allocated the object, it can always be destroyed
     res->flags |= OBJECT_FLAG_ALLOCATED;
+    res->flags &= ~OBJECT_GC_MASK;
 
     res->ref_count = 0;
     res->class = obj;
@@ -423,6 +538,9 @@ static t_object *_object_allocate_with_args(t_object *obj, t_dll *arguments, int
  * Initialize all the (scalar) objects
  */
 void object_init() {
+    // Seed the string hashes before any string object is hashed
+    hash_seed_init();
+
     // Attrib cannot have any callables, as callable hasn't been initialized yet
     object_attrib_init();
     // Callable can only have attribs
@@ -464,62 +582,58 @@ void object_fini() {
     object_base_fini();
     object_callable_fini();
     object_attrib_fini();
+
+    _object_free_speclists();
 }
 
 
+// Compiled form of a speclist, so object_parse_arguments() does not need to parse the speclist on every call
+typedef struct _object_speclist {
+    char *speclist;                 // Speclist this is compiled from
+    int min_count;                  // Number of arguments that must be present at least
+    int count;                      // Number of arguments inside the speclist
+    struct {
+        t_objectype_enum type;      // Type of the argument (objectTypeAny for any object)
+        int nullable;               // 1 when a null object is accepted as well
+        int optional;               // 1 when the argument may be omitted
+    } args[];
+} t_object_speclist;
+
+// Compiled speclists, keyed on the address of the speclist
+static t_hash_table *object_speclists = NULL;
+
 /**
- * Parse arguments for a given object. Used mostly for parsing arguments from Saffire methods
- *
- * Normally called as:
- *      object_parse_arguments(SAFFIRE_METHOD_ARGS, "ss", &s1_obj, &s2_obj);
- *
- * Spec is a string with the following format:
- *
- *   s    a string object
- *   n    a numerical object
- *   N    a NULL object
- *   r    a regex object
- *   b    a boolean object
- *   o    any object
- *   |    optional arguments after this
- *   +    previous value may also be nullable (does not make sense with 'N')
- *
- * so:
- *
- *   'ss' must have two string objects as arguments
- *   'so' must have one string, and one generic object (could be a string too)
- *   'ss|n'  must have two strings and optionally a numerical object
- *   'n+|n'  must have a numerical (or a NULL), and optionally a numerical (but not a NULL)
- *
- * Will return 0 on ok, -1 on error
+ * Returns the compiled form of a speclist. Speclists are compiled once, and cached on their address. Returns NULL
+ * (and raises an exception) when the speclist cannot be parsed.
  */
-static int _object_parse_arguments(t_dll *arguments, int convert_objects, const char *speclist, va_list dst_vars) {
-    const char *ptr = speclist;
-    int optional_argument = 0;
-    t_objectype_enum type;
-    int result = -1;
-
-    // Point to first element
-    t_dll_element *e = DLL_HEAD(arguments);
+static t_object_speclist *_object_compile_speclist(const char *speclist) {
+    if (! object_speclists) {
+        object_speclists = ht_create();
+    }
 
-    // First, check if the number of elements equals (or is more) than the number of mandatory objects in the spec
-    int cnt = 0;
-    while (*ptr) {
-        if (*ptr == '|') break;     // Optional character that does not imply an argument itself
-        if (*ptr == '+') break;     // Optional character that does not imply an argument itself
-        cnt++;
-        ptr++;
+    // Speclists are almost always string literals, but make sure the speclist did not change on the same address
+    t_object_speclist *compiled = ht_find_ptr(object_speclists, (void *)speclist);
+    if (compiled && strcmp(compiled->speclist, speclist) == 0) {
+        return compiled;
     }
-    if (arguments->size < cnt) {
-        object_raise_exception(Object_ArgumentException, 1, "Error while parsing argument list: at least %d arguments are needed. Only %ld are given", cnt, arguments->size);
-        result = -1;
-        goto done;
+
+    // Every character except for '|' and '+' is an argument
+    int count = 0;
+    for (const char *ptr = speclist; *ptr; ptr++) {
+        if (*ptr != '|' && *ptr != '+') count++;
     }
 
-    // We know have have enough elements. Iterate the spec
-    ptr = speclist;
+    t_object_speclist *new_compiled = smm_malloc(sizeof(t_object_speclist) + count * sizeof(new_compiled->args[0]));
+    new_compiled->speclist = string_strdup0(speclist);
+    new_compiled->count = 0;
+
+    // The mandatory count does not look beyond the first optional or nullable argument
+    new_compiled->min_count = strcspn(speclist, "|+");
+
+    int optional_argument = 0;
+    const char *ptr = speclist;
     while (*ptr) {
-        int nullable = 0;
+        t_objectype_enum type;
         char c = *ptr; // Save current spec character
         ptr++;
         switch (c) {
@@ -547,26 +661,107 @@ static int _object_parse_arguments(t_dll *arguments, int convert_objects, const
                 break;
             default :
                 object_raise_exception(Object_SystemException, 1, "Error while parsing argument list: cannot parse argument: '%c'", c);
-                result = -1;
-                goto done;
+                smm_free(new_compiled->speclist);
+                smm_free(new_compiled);
+                return NULL;
                 break;
         }
 
+        int nullable = 0;
+
         // Check if the next value is a +, if so, we also accept nullable
         if (*ptr == '+') {
             nullable = 1;
             ptr++;
         }
 
+        new_compiled->args[new_compiled->count].type = type;
+        new_compiled->args[new_compiled->count].nullable = nullable;
+        new_compiled->args[new_compiled->count].optional = optional_argument;
+        new_compiled->count++;
+    }
+
+    if (compiled) {
+        ht_replace_ptr(object_speclists, (void *)speclist, new_compiled);
+        smm_free(compiled->speclist);
+        smm_free(compiled);
+    } else {
+        ht_add_ptr(object_speclists, (void *)speclist, new_compiled);
+    }
+
+    return new_compiled;
+}
+
+/**
+ * Frees all compiled speclists
+ */
+static void _object_free_speclists(void) {
+    if (! object_speclists) return;
+
+    t_hash_iter iter;
+    ht_iter_init(&iter, object_speclists);
+    while (ht_iter_valid(&iter)) {
+        t_object_speclist *compiled = ht_iter_value(&iter);
+        smm_free(compiled->speclist);
+        smm_free(compiled);
+        ht_iter_next(&iter);
+    }
+    ht_destroy(object_speclists);
+    object_speclists = NULL;
+}
+
+/**
+ * Parse arguments for a given object. Used mostly for parsing arguments from Saffire methods
+ *
+ * Normally called as:
+ *      object_parse_arguments(SAFFIRE_METHOD_ARGS, "ss", &s1_obj, &s2_obj);
+ *
+ * Spec is a string with the following format:
+ *
+ *   s    a string object
+ *   n    a numerical object
+ *   N    a NULL object
+ *   r    a regex object
+ *   b    a boolean object
+ *   o    any object
+ *   |    optional arguments after this
+ *   +    previous value may also be nullable (does not make sense with 'N')
+ *
+ * so:
+ *
+ *   'ss' must have two string objects as arguments
+ *   'so' must have one string, and one generic object (could be a string too)
+ *   'ss|n'  must have two strings and optionally a numerical object
+ *   'n+|n'  must have a numerical (or a NULL), and optionally a numerical (but not a NULL)
+ *
+ * Will return 0 on ok, -1 on error
+ */
+static int _object_parse_arguments(t_object **argv, int argc, int convert_objects, const char *speclist, va_list dst_vars) {
+    t_object_speclist *compiled = _object_compile_speclist(speclist);
+    if (! compiled) {
+        return -1;
+    }
+
+    // First, check if the number of elements equals (or is more) than the number of mandatory objects in the spec
+    if (argc < compiled->min_count) {
+        object_raise_exception(Object_ArgumentException, 1, "Error while parsing argument list: at least %d arguments are needed. Only %d are given", compiled->min_count, argc);
+        return -1;
+    }
+
+    // We know have have enough elements. Iterate the spec
+    for (int i=0; i!=compiled->count; i++) {
+        t_objectype_enum type = compiled->args[i].type;
+        int nullable = compiled->args[i].nullable;
+
         // Fetch the next object from the list. We must assume the user has added enough room
         void **storage_ptr = va_arg(dst_vars, void **);
-        if (optional_argument == 0 && (!e || ! DLL_DATA_PTR(e))) {
+        t_object *argument_obj = i < argc ? argv[i] : NULL;
+
+        if (compiled->args[i].optional == 0 && ! argument_obj) {
             object_raise_exception(Object_ArgumentException, 1, "Error while fetching mandatory argument.");
-            result = -1;
-            goto done;
+            return -1;
         }
 
-        t_object *argument_obj = e ? DLL_DATA_PTR(e) : NULL;
         if (argument_obj &&
             type != objectTypeAny &&
             (
@@ -575,19 +770,18 @@ static int _object_parse_arguments(t_dll *arguments, int convert_objects, const
             )
         ) {
             object_raise_exception(Object_ArgumentException, 1, "Error while parsing argument list: wanted a %s%s, but got a %s", objectTypeNames[type], (nullable?" or a null":""), objectTypeNames[argument_obj->type]);
-            result = -1;
-            goto done;
+            return -1;
         }
 
         // No argument object found, leave the current storage_ptr alone
         if (! argument_obj) {
-            goto next;
+            continue;
         }
 
         // Don't convert objects, return as-is
         if (convert_objects == 0) {
             *storage_ptr = argument_obj;
-            goto next;
+            continue;
         }
 
         // Convert objects if possible
@@ -628,29 +822,21 @@ static int _object_parse_arguments(t_dll *arguments, int convert_objects, const
                 *storage_ptr = argument_obj;
                 break;
         }
-
-next:
-        // Goto next element
-        e = e ? DLL_NEXT(e) : NULL;
     }
 
     // Everything is ok
-    result = 0;
-
-    // General cleanup
-done:
-    return result;
+    return 0;
 }
 
 
 /**
  * Parses arguments, converts scalar objects like string and numericals to actual char *, and longs
  */
-int object_parse_arguments(t_dll *arguments, const char *speclist, ...) {
+int object_parse_arguments(t_object **argv, int argc, const char *speclist, ...) {
     va_list dst_vars;
 
     va_start(dst_vars, speclist);
-    int ret = _object_parse_arguments(arguments, 1, speclist, dst_vars);
+    int ret = _object_parse_arguments(argv, argc, 1, speclist, dst_vars);
     va_end(dst_vars);
 
     return ret;
@@ -659,16 +845,67 @@ int object_parse_arguments(t_dll *arguments, const char *speclist, ...) {
 /**
  * Parses arguments, but returns only objects
  */
-int object_parse_argument_objects(t_dll *arguments, const char *speclist, ...) {
+int object_parse_argument_objects(t_object **argv, int argc, const char *speclist, ...) {
     va_list dst_vars;
 
     va_start(dst_vars, speclist);
-    int ret = _object_parse_arguments(arguments, 0, speclist, dst_vars);
+    int ret = _object_parse_arguments(argv, argc, 0, speclist, dst_vars);
     va_end(dst_vars);
 
     return ret;
 }
 
+/**
+ * Copies the arguments inside a DLL into an argument vector. The vector must be freed by the caller.
+ */
+static t_object **_object_dll_to_argv(t_dll *arguments, int *argc) {
+    *argc = arguments ? arguments->size : 0;
+    t_object **argv = smm_malloc((*argc ? *argc : 1) * sizeof(t_object *));
+
+    int i = 0;
+    t_dll_element *e = arguments ? DLL_HEAD(arguments) : NULL;
+    while (e) {
+        argv[i++] = DLL_DATA_PTR(e);
+        e = DLL_NEXT(e);
+    }
+
+    return argv;
+}
+
+/**
+ * Same as object_parse_arguments(), but for methods that receive their arguments inside a DLL (external modules)
+ */
+int object_parse_dll_arguments(t_dll *arguments, const char *speclist, ...) {
+    va_list dst_vars;
+    int argc;
+
+    t_object **argv = _object_dll_to_argv(arguments, &argc);
+
+    va_start(dst_vars, speclist);
+    int ret = _object_parse_arguments(argv, argc, 1, speclist, dst_vars);
+    va_end(dst_vars);
+
+    smm_free(argv);
+    return ret;
+}
+
+/**
+ * Same as object_parse_argument_objects(), but for methods that receive their arguments inside a DLL (external modules)
+ */
+int object_parse_dll_argument_objects(t_dll *arguments, const char *speclist, ...) {
+    va_list dst_vars;
+    int argc;
+
+    t_object **argv = _object_dll_to_argv(arguments, &argc);
+
+    va_start(dst_vars, speclist);
+    int ret = _object_parse_arguments(argv, argc, 0, speclist, dst_vars);
+    va_end(dst_vars);
+
+    smm_free(argv);
+    return ret;
+}
+
 
 /**
  * Adds interface to object (class)
@@ -695,24 +932,40 @@ void object_add_interface(t_object *class, t_object *interface) {
 /**
  * Create method- attribute that points to an INTERNAL (C) function
  */
-void object_add_internal_method_attributes(t_hash_table *attributes, t_object *obj, char *name, int method_flags, int visibility, void *func) {
+static void _object_add_internal_method_attributes(t_hash_table *attributes, t_object *obj, char *name, int method_flags, int visibility, int routing, void *func) {
     // @TODO: Instead of NULL, we should be able to add our parameters. This way, we have a more generic way to deal with internal and external functions.
-    t_callable_object *callable_obj = (t_callable_object *)object_alloc_instance(Object_Callable, 3, CALLABLE_CODE_INTERNAL, func, /* arguments */ NULL);
+    t_callable_object *callable_obj = (t_callable_object *)object_alloc_instance(Object_Callable, 3, routing, func, /* arguments */ NULL);
 
     t_attrib_object *attrib_obj = (t_attrib_object *)object_alloc_instance(Object_Attrib, 7, obj, name, ATTRIB_TYPE_METHOD, visibility, ATTRIB_ACCESS_RO, callable_obj, method_flags);
 
     /* We don't add the attributes directly to the obj, but we store them inside attributes. Otherwise we run into trouble bootstrapping the callable and attrib objects
      * (as we need to create callables during the creation of callables in callable_init, for instance). By storing them separately inside an attribute hash, and adding the
      * hash when we are finished with the object, it works (we can't do any calls to the callables in between, but we are not allowed to anyway). */
-    ht_add_str(attributes, name, attrib_obj);
+    ht_add_sym(attributes, symbol_intern0(name), attrib_obj);
     object_inc_ref((t_object *)attrib_obj);
+    object_attrib_generation++;
+}
+
+/**
+ * Create method- attribute that points to an INTERNAL (C) function, and store it inside the attributes hash
+ */
+void object_add_internal_method_attributes(t_hash_table *attributes, t_object *obj, char *name, int method_flags, int visibility, void *func) {
+    _object_add_internal_method_attributes(attributes, obj, name, method_flags, visibility, CALLABLE_CODE_INTERNAL, func);
 }
 
 /**
  * Create method- attribute that points to an INTERNAL (C) function
  */
 void object_add_internal_method(t_object *obj, char *name, int method_flags, int visibility, void *func) {
-    object_add_internal_method_attributes(obj->attributes, obj, name, method_flags, visibility, func);
+    _object_add_internal_method_attributes(obj->attributes, obj, name, method_flags, visibility, CALLABLE_CODE_INTERNAL, func);
+}
+
+/**
+ * Create method- attribute that points to an INTERNAL (C) function that receives its arguments inside a DLL. Only
+ * used by external modules that are not converted to the argument vector calling convention.
+ */
+void object_add_internal_dll_method(t_object *obj, char *name, int method_flags, int visibility, void *func) {
+    _object_add_internal_method_attributes(obj->attributes, obj, name, method_flags, visibility, CALLABLE_CODE_INTERNAL | CALLABLE_CODE_DLL, func);
 }
 
 /**
@@ -721,8 +974,11 @@ void object_add_internal_method(t_object *obj, char *name, int method_flags, int
 void object_add_property(t_object *obj, char *name, int visibility, t_object *property) {
     t_attrib_object *attrib_obj = (t_attrib_object *)object_alloc_instance(Object_Attrib, 7, obj, name, ATTRIB_TYPE_PROPERTY, visibility, ATTRIB_ACCESS_RW, property, 0);
 
-    ht_add_str(obj->attributes, name, attrib_obj);
+    ht_add_sym(obj->attributes, symbol_intern0(name), attrib_obj);
     object_inc_ref((t_object *)attrib_obj);
+
+    // Attributes of instances are never cached directly, only the ones owned by classes
+    if (OBJECT_TYPE_IS_CLASS(obj)) object_attrib_generation++;
 }
 
 
@@ -737,8 +993,11 @@ void object_add_constant(t_object *obj, char *name, int visibility, t_object *co
         fatal_error(1, "Attribute '%s' already exists in object '%s'\n", name, obj->name);      /* LCOV_EXCL_LINE */
     }
 
-    ht_add_str(obj->attributes, name, attrib_obj);
+    ht_add_sym(obj->attributes, symbol_intern0(name), attrib_obj);
     object_inc_ref((t_object *)attrib_obj);
+
+    // Same as object_add_property(), only attributes of classes can be cached
+    if (OBJECT_TYPE_IS_CLASS(obj)) object_attrib_generation++;
 }
 
 
@@ -35,6 +35,7 @@
 #include <saffire/objects/objects.h>
 #include <saffire/memory/smm.h>
 #include <saffire/general/md5.h>
+#include <saffire/general/hash/hash_funcs.h>
 #include <saffire/debug.h>
 #include <saffire/general/output.h>
 
@@ -139,7 +140,7 @@ SAFFIRE_METHOD(regex, dtor) {
  * Saffire method: Returns string regex
  */
 SAFFIRE_METHOD(regex, regex) {
-    RETURN_STRING(self->data.regex_string);
+    RETURN_STRING_FROM_CHAR(self->data.regex_string);
 }
 
 
@@ -239,8 +240,8 @@ SAFFIRE_METHOD(regex, match) {
 
     // Create tuple with ret_obj and matches_obj
     t_tuple_object *obj = (t_tuple_object *)object_alloc_instance(Object_Tuple, 0);
-    ht_append_num(obj->data.ht, ret_obj);
-    ht_append_num(obj->data.ht, matches_obj);
+    object_tuple_append(obj, ret_obj);
+    object_tuple_append(obj, (t_object *)matches_obj);
 
     RETURN_OBJECT(obj);
 }
@@ -278,7 +279,7 @@ SAFFIRE_METHOD(regex, conv_numerical) {
  *
  */
 SAFFIRE_METHOD(regex, conv_string) {
-    RETURN_STRING(self->data.regex_string);
+    RETURN_STRING_FROM_CHAR(self->data.regex_string);
 }
 
 /* ======================================================================
@@ -290,7 +291,7 @@ SAFFIRE_METHOD(regex, conv_string) {
  * Initializes regex methods and properties, these are used
  */
 void object_regex_init(void) {
-    Object_Regex_struct.attributes = ht_create();
+    Object_Regex_struct.attributes = ht_create_lookup();
     object_add_internal_method((t_object *)&Object_Regex_struct, "__ctor",        ATTRIB_METHOD_CTOR, ATTRIB_VISIBILITY_PUBLIC, object_regex_method_ctor);
     object_add_internal_method((t_object *)&Object_Regex_struct, "__dtor",        ATTRIB_METHOD_DTOR, ATTRIB_VISIBILITY_PUBLIC, object_regex_method_dtor);
 
@@ -368,10 +369,19 @@ static char *obj_debug(t_object *obj) {
 }
 #endif
 
-static char *obj_hash(t_object *obj) {
-    char *s;
-    smm_asprintf_char(&s, "%s%d", ((t_regex_object *)obj)->data.regex_string, ((t_regex_object *)obj)->data.regex_flags);
-    return s;
+static uint64_t obj_hash(t_object *obj) {
+    t_regex_object *re_obj = (t_regex_object *)obj;
+
+    if (! re_obj->data.regex_string) return 0;
+    return hash_siphash(re_obj->data.regex_string, strlen(re_obj->data.regex_string)) ^ re_obj->data.regex_flags;
+}
+
+static int obj_equals(t_object *obj1, t_object *obj2) {
+    t_regex_object *re1 = (t_regex_object *)obj1;
+    t_regex_object *re2 = (t_regex_object *)obj2;
+
+    if (! re1->data.regex_string || ! re2->data.regex_string) return 0;
+    return re1->data.regex_flags == re2->data.regex_flags && strcmp(re1->data.regex_string, re2->data.regex_string) == 0;
 }
 
 
@@ -388,6 +398,8 @@ t_object_funcs regex_funcs = {
 #else
         NULL,
 #endif
+        NULL,                 // Traverse
+        obj_equals,           // Equals
 };
 
 // Intial object
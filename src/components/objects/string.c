@@ -34,7 +34,8 @@
 #include <saffire/objects/object.h>
 #include <saffire/objects/objects.h>
 #include <saffire/memory/smm.h>
-#include <saffire/general/md5.h>
+#include <saffire/general/hash/hash_funcs.h>
+#include <saffire/general/symbol.h>
 #include <saffire/general/output.h>
 #include <saffire/debug.h>
 #include <saffire/vm/thread.h>
@@ -44,65 +45,187 @@
  * ======================================================================
  */
 /**
- * Returns a byte[16] md5 hash of the given widestring
+ * Calculates the 64bit hash of the string
  */
 static void calculate_hash(t_string_object *str_obj) {
-    md5_state_t state;
+    str_obj->data.hash = hash_siphash(STROBJ2CHAR0(str_obj), STROBJ2CHAR0LEN(str_obj));
+}
+
+
+/**
+ * Frees the character and unicode data of the string object
+ */
+static void string_free_value(t_string_object *str_obj) {
+    t_string *str = str_obj->data.value;
+    if (! str) return;
+
+    if (STRING_UNICODE(str)) smm_free(STRING_UNICODE(str));
 
-    md5_init(&state);
-    md5_append(&state, (md5_byte_t *)STROBJ2CHAR0(str_obj), STROBJ2CHAR0LEN(str_obj));
-    md5_finish(&state, str_obj->data.hash);
+    if (str_obj->data.parent) {
+        object_release(str_obj->data.parent);
+        str_obj->data.parent = NULL;
+    } else if (STRING_CHAR0(str) != str_obj->data.inline_buf) {
+        smm_free(STRING_CHAR0(str));
+    }
+
+    str_obj->data.value = NULL;
 }
 
+/**
+ * Stores a copy of a binary safe string into the string object. Short strings are stored inside the object.
+ */
+static void string_set_value(t_string_object *str_obj, const char *s, size_t len) {
+    t_string *str = &str_obj->data.string;
+
+    STRING_CHAR0(str) = len < STRING_OBJECT_INLINE_SIZE ? str_obj->data.inline_buf : smm_malloc(len + 1);
+    memcpy(STRING_CHAR0(str), s, len);
+    STRING_CHAR0(str)[len] = '\0';
+    STRING_LEN(str) = len;
+    STRING_UNICODE(str) = NULL;
+    str->charset = STRING_CHARSET_UNKNOWN;
+
+    str_obj->data.value = str;
+    str_obj->data.needs_hashing = 1;
+}
 
-static void string_change_locale(t_string_object *str_obj, char *locale) {
-    if (str_obj->data.locale) {
-        smm_free(str_obj->data.locale);
+/**
+ * Moves an allocated t_string into the string object. The t_string itself is freed.
+ */
+static void string_adopt_value(t_string_object *str_obj, t_string *src) {
+    t_string *str = &str_obj->data.string;
+
+    if (STRING_LEN(src) < STRING_OBJECT_INLINE_SIZE) {
+        if (STRING_LEN(src)) memcpy(str_obj->data.inline_buf, STRING_CHAR0(src), STRING_LEN(src));
+        str_obj->data.inline_buf[STRING_LEN(src)] = '\0';
+        if (STRING_CHAR0(src)) smm_free(STRING_CHAR0(src));
+        STRING_CHAR0(str) = str_obj->data.inline_buf;
+    } else {
+        STRING_CHAR0(str) = STRING_CHAR0(src);
     }
-    str_obj->data.locale = string_strdup0(locale);
+    STRING_LEN(str) = STRING_LEN(src);
+    STRING_UNICODE(str) = STRING_UNICODE(src);
+    str->charset = src->charset;
+    smm_free(src);
+
+    str_obj->data.value = str;
+    str_obj->data.needs_hashing = 1;
+}
+
+/**
+ * Makes the string object a view on len bytes at s, inside the character data of the parent. Views are only made
+ * on data that is followed by a \0, so they can still be used as zero terminated strings.
+ */
+static void string_set_view(t_string_object *str_obj, t_string_object *parent, const char *s, size_t len) {
+    t_string *str = &str_obj->data.string;
+
+    STRING_CHAR0(str) = (char *)s;
+    STRING_LEN(str) = len;
+    STRING_UNICODE(str) = NULL;
+    str->charset = parent->data.value->charset == STRING_CHARSET_ASCII ? STRING_CHARSET_ASCII : STRING_CHARSET_UNKNOWN;
+
+    str_obj->data.parent = (t_object *)parent;
+    object_inc_ref((t_object *)parent);
+
+    str_obj->data.value = str;
+    str_obj->data.needs_hashing = 1;
 }
 
 static t_string_object *string_create_new_object(t_string *str, char *locale) {
     t_string_object *uc_obj = (t_string_object *)object_alloc_instance(Object_String, 0);
     object_inc_ref((t_object *)uc_obj);
 
-    uc_obj->data.value = str;
-    uc_obj->data.locale = string_strdup0(locale);
+    string_adopt_value(uc_obj, str);
+    uc_obj->data.locale = locale;
 
-    uc_obj->data.needs_hashing = 1;
+    return uc_obj;
+}
+
+static t_string_object *string_create_new_object_from_char(const char *s, size_t len, char *locale) {
+    t_string_object *uc_obj = (t_string_object *)object_alloc_instance(Object_String, 0);
+    object_inc_ref((t_object *)uc_obj);
+
+    string_set_value(uc_obj, s, len);
+    uc_obj->data.locale = locale;
 
     return uc_obj;
 }
 
+/**
+ * Returns a new string object with len bytes at s, which lie inside the string object. This is a view when the
+ * bytes are followed by a \0, and the owner of the data is not much larger than the substring. Otherwise it is a
+ * copy, so small substrings do not keep large strings alive. Like object_alloc_instance(), the new string object
+ * is not referenced yet.
+ */
+static t_string_object *string_create_substring(t_string_object *str_obj, const char *s, size_t len) {
+    // Views of views share the owner of the character data
+    t_string_object *owner = str_obj->data.parent ? (t_string_object *)str_obj->data.parent : str_obj;
+    t_string *owner_str = owner->data.value;
+
+    t_string_object *sub_obj = (t_string_object *)object_alloc_instance(Object_String, 0);
+
+    if (len < STRING_OBJECT_INLINE_SIZE ||
+        len * STRING_VIEW_MAX_WASTE < STRING_LEN(owner_str) ||
+        s + len > STRING_CHAR0(owner_str) + STRING_LEN(owner_str) ||
+        s[len] != '\0'
+    ) {
+        string_set_value(sub_obj, s, len);
+    } else {
+        string_set_view(sub_obj, owner, s, len);
+    }
+    sub_obj->data.locale = str_obj->data.locale;
+
+    return sub_obj;
+}
+
+/**
+ * Returns a new string object with the character at position idx of the string object, in the same locale
+ */
+t_string_object *object_string_char_at(t_string_object *str_obj, long idx) {
+    return string_create_new_object_from_char(STRING_CHAR0(str_obj->data.value) + idx, 1, str_obj->data.locale);
+}
+
 //t_string *object_string_cat(t_string *s1, t_string *s2) {
 //    t_string *dst = string_strdup(s1);
 //    string_strcat(dst, s2);
 //    return dst;
 //}
 
+/**
+ * Orders two strings. Only UTF-8 strings with multibyte characters are compared through ICU, all others bytewise.
+ */
 static int _string_compare(t_string *s1, t_string *s2) {
+    int cs1 = string_charset(s1);
+    int cs2 = string_charset(s2);
+
+    if ((cs1 != STRING_CHARSET_UTF8 && cs2 != STRING_CHARSET_UTF8) || cs1 == STRING_CHARSET_BINARY || cs2 == STRING_CHARSET_BINARY) {
+        return string_strcmp(s1, s2);
+    }
+
     create_utf8_from_string(s1);
     create_utf8_from_string(s2);
 
     return utf8_strcmp(s1, s2);
 }
 
+/**
+ * Returns 1 when the string can be case mapped without ICU: it must be ASCII, and its locale must not map the ASCII
+ * letters differently (Turkish and Azerbaijani have a dotted and dotless i).
+ */
+static int _string_has_ascii_casing(t_string_object *str_obj) {
+    if (! STRING_IS_ASCII(str_obj->data.value)) return 0;
+
+    const char *locale = str_obj->data.locale;
+    if (locale && (strncmp(locale, "tr", 2) == 0 || strncmp(locale, "az", 2) == 0)) return 0;
+
+    return 1;
+}
+
 /* ======================================================================
  *   Object methods
  * ======================================================================
  */
 
 
- int object_string_hash_compare(t_string_object *s1, t_string_object *s2) {
-    int c = 0;
-
-    // Do a complete hash check to counter timing attacks
-    for (int i=0; i!=16; i++) {
-        c += (s1->data.hash[i] ^ s2->data.hash[i]);
-    }
-    return (c == 0);
- }
-
 /**
  * Saffire method: constructor
  */
@@ -113,12 +236,12 @@ SAFFIRE_METHOD(string, ctor) {
         return NULL;
     }
 
-    self->data.value = string_strdup(str);
+    string_free_value(self);
+    string_set_value(self, STRING_CHAR0(str), STRING_LEN(str));
     if (locale) {
-        self->data.locale = STRING_CHAR0(locale);
+        self->data.locale = symbol_intern(STRING_CHAR0(locale), STRING_LEN(locale))->s;
     } else {
-        t_thread *thread = thread_get_current();
-        self->data.locale = thread->locale ? string_strdup0(thread->locale) : NULL;
+        self->data.locale = thread_get_current()->locale;
     }
 
     RETURN_SELF;
@@ -143,9 +266,14 @@ SAFFIRE_METHOD(string, length) {
  * Saffire method: Returns uppercased string object
  */
 SAFFIRE_METHOD(string, upper) {
-    create_utf8_from_string(self->data.value);
+    t_string *dst;
 
-    t_string *dst = utf8_toupper(self->data.value, self->data.locale);
+    if (_string_has_ascii_casing(self)) {
+        dst = string_ascii_toupper(self->data.value);
+    } else {
+        create_utf8_from_string(self->data.value);
+        dst = utf8_toupper(self->data.value, self->data.locale);
+    }
 
     // Create new object
     t_string_object *obj = string_create_new_object(dst, self->data.locale);
@@ -156,9 +284,14 @@ SAFFIRE_METHOD(string, upper) {
  * Saffire method: Returns ucfirst string object
  */
 SAFFIRE_METHOD(string, ucfirst) {
-    create_utf8_from_string(self->data.value);
+    t_string *dst;
 
-    t_string *dst = utf8_ucfirst(self->data.value, self->data.locale);
+    if (_string_has_ascii_casing(self)) {
+        dst = string_ascii_ucfirst(self->data.value);
+    } else {
+        create_utf8_from_string(self->data.value);
+        dst = utf8_ucfirst(self->data.value, self->data.locale);
+    }
 
     // Create new object
     t_string_object *obj = string_create_new_object(dst, self->data.locale);
@@ -171,9 +304,14 @@ SAFFIRE_METHOD(string, ucfirst) {
  * Saffire method: Returns lowercased string object
  */
 SAFFIRE_METHOD(string, lower) {
-    create_utf8_from_string(self->data.value);
+    t_string *dst;
 
-    t_string *dst = utf8_tolower(self->data.value, self->data.locale);
+    if (_string_has_ascii_casing(self)) {
+        dst = string_ascii_tolower(self->data.value);
+    } else {
+        create_utf8_from_string(self->data.value);
+        dst = utf8_tolower(self->data.value, self->data.locale);
+    }
 
     // Create new object
     t_string_object *obj = string_create_new_object(dst, self->data.locale);
@@ -220,7 +358,7 @@ SAFFIRE_METHOD(string, trim) {
     while(end >= str && isspace(*end)) end--;
     end++;
 
-    RETURN_STRING_FROM_BINSAFE_CHAR((end-str), str);
+    RETURN_OBJECT(string_create_substring(self, str, end - str));
 }
 
 
@@ -245,7 +383,7 @@ SAFFIRE_METHOD(string, ltrim) {
         RETURN_STRING_FROM_CHAR("");
     }
 
-    RETURN_STRING_FROM_BINSAFE_CHAR(len, str);
+    RETURN_OBJECT(string_create_substring(self, str, len));
 }
 
 /**
@@ -266,7 +404,7 @@ SAFFIRE_METHOD(string, rtrim) {
         RETURN_STRING_FROM_CHAR("");
     }
 
-    RETURN_STRING_FROM_BINSAFE_CHAR((end-str), str);
+    RETURN_OBJECT(string_create_substring(self, str, end - str));
 }
 
 /**
@@ -318,6 +456,10 @@ SAFFIRE_METHOD(string, conv_string) {
     RETURN_SELF;
 }
 
+/**
+ * Saffire method: Splits the string on token, into a list of at most max strings (when max is positive). The last
+ * string holds the remainder of the string.
+ */
 SAFFIRE_METHOD(string, split) {
     t_string *token;
     long max = 0;
@@ -326,16 +468,66 @@ SAFFIRE_METHOD(string, split) {
         return NULL;
     }
 
-    // @TODO: HIGH: Split does not work? string_split??
+    if (STRING_LEN(token) == 0) {
+        object_raise_exception(Object_ArgumentException, 1, "split() expects a non-empty token");
+        return NULL;
+    }
 
-    RETURN_FALSE;
+    // All parts are cut from a single copy of the string. The first byte of every token that splits is replaced
+    // by a \0, so the long parts can be zero terminated views into this copy. Like string_create_substring(), parts
+    // that are short, or much smaller than the copy, are copied instead.
+    t_string_object *root = (t_string_object *)object_alloc_instance(Object_String, 0);
+    object_inc_ref((t_object *)root);
+    string_set_value(root, STRING_CHAR0(self->data.value), STRING_LEN(self->data.value));
+    if (STRING_IS_ASCII(self->data.value)) root->data.string.charset = STRING_CHARSET_ASCII;
+    root->data.locale = self->data.locale;
+
+    t_list_object *list_obj = (t_list_object *)object_alloc_instance(Object_List, 0);
+
+    char *s = STRING_CHAR0(root->data.value);
+    char *end = s + STRING_LEN(root->data.value);
+    long count = 1;
+
+    while (1) {
+        char *found = NULL;
+        if (max <= 0 || count < max) {
+            for (char *p = s; p + STRING_LEN(token) <= end; p++) {
+                if (*p == *STRING_CHAR0(token) && memcmp(p, STRING_CHAR0(token), STRING_LEN(token)) == 0) {
+                    found = p;
+                    break;
+                }
+            }
+        }
+
+        char *part_end = found ? found : end;
+        size_t len = part_end - s;
+
+        t_string_object *part = (t_string_object *)object_alloc_instance(Object_String, 0);
+        if (len < STRING_OBJECT_INLINE_SIZE || len * STRING_VIEW_MAX_WASTE < STRING_LEN(root->data.value)) {
+            string_set_value(part, s, len);
+        } else {
+            *part_end = '\0';
+            string_set_view(part, root, s, len);
+        }
+        part->data.locale = self->data.locale;
+        object_list_append(list_obj, (t_object *)part);
+
+        if (! found) break;
+
+        s = found + STRING_LEN(token);
+        count++;
+    }
+
+    // The root stays alive for as long as one of its views does
+    object_release((t_object *)root);
+
+    RETURN_OBJECT(list_obj);
 }
 
 /**
  *
  */
 SAFFIRE_METHOD(string, splice) {
-    // @TODO: MEDIUM: We probably want to just change the length and the offset of the t_string. Not doing any real copies
     long min, max;
 
     if (object_parse_arguments(SAFFIRE_METHOD_ARGS, "n+n+", &min, &max) != 0) {
@@ -362,16 +554,16 @@ SAFFIRE_METHOD(string, splice) {
         return NULL;
     }
 
+    // The end is inclusive, but can not go past the end of the string
     long new_size = (max - min) + 1;
+    if (min + new_size > STRING_LEN(self->data.value)) {
+        new_size = STRING_LEN(self->data.value) - min;
+    }
     if (new_size == 0) {
         RETURN_STRING_FROM_CHAR("");
     }
 
-
-    t_string *dst = string_copy_partial(self->data.value, min, new_size);
-
-    t_string_object *obj = string_create_new_object(dst, self->data.locale);
-    RETURN_OBJECT(obj);
+    RETURN_OBJECT(string_create_substring(self, STRING_CHAR0(self->data.value) + min, new_size));
 }
 
 
@@ -389,7 +581,7 @@ SAFFIRE_METHOD(string, to_locale) {
     t_string_object *dst = (t_string_object *)object_clone((t_object *)self);
 
     // Set new locale
-    string_change_locale(dst, STRING_CHAR0(locale));
+    dst->data.locale = symbol_intern(STRING_CHAR0(locale), STRING_LEN(locale))->s;
 
     RETURN_OBJECT(dst);
 }
@@ -414,7 +606,25 @@ SAFFIRE_METHOD(string, index) {
         return NULL;
     }
 
+    if (offset < 0 || offset > STRING_LEN(self->data.value)) {
+        RETURN_FALSE;
+    }
+
+    // Byte and character positions are the same in ASCII strings
+    if (STRING_IS_ASCII(self->data.value) && STRING_IS_ASCII(needle)) {
+        char *haystack = STRING_CHAR0(self->data.value) + offset;
+        char *end = STRING_CHAR0(self->data.value) + STRING_LEN(self->data.value);
+
+        for (char *p = haystack; p + STRING_LEN(needle) <= end; p++) {
+            if (memcmp(p, STRING_CHAR0(needle), STRING_LEN(needle)) == 0) {
+                RETURN_NUMERICAL(p - haystack);
+            }
+        }
+        RETURN_FALSE;
+    }
+
     create_utf8_from_string(self->data.value);
+    create_utf8_from_string(needle);
 
     int pos = utf8_strstr(self->data.value, needle, offset);
     if (pos == -1) {
@@ -456,10 +666,8 @@ SAFFIRE_COMPARISON_METHOD(string, eq) {
         RETURN_FALSE;
     }
 
-    // @TODO: Assuming that every unique string will be at the same address, we could do a simple address check
-    //        instead of a memcmp. However, it means that we MUST make sure that the value_len's are also matching,
-    //        otherwise "foo" would match "foobar", as they both have the same start address
-    if (_string_compare(self->data.value, other) == 0) {
+    // Equal strings have equal bytes, whatever their encoding
+    if (memcmp(STRING_CHAR0(self->data.value), STRING_CHAR0(other), STRING_LEN(other)) == 0) {
         RETURN_TRUE;
     }
     RETURN_FALSE;
@@ -476,10 +684,8 @@ SAFFIRE_COMPARISON_METHOD(string, ne) {
         RETURN_TRUE;
     }
 
-    // @TODO: Assuming that every unique string will be at the same address, we could do a simple address check
-    //        instead of a memcmp. However, it means that we MUST make sure that the value_len's are also matching,
-    //        otherwise "foo" would match "foobar", as they both have the same start address
-    if (_string_compare(self->data.value, other) != 0) {
+    // Equal strings have equal bytes, whatever their encoding
+    if (memcmp(STRING_CHAR0(self->data.value), STRING_CHAR0(other), STRING_LEN(other)) != 0) {
         RETURN_TRUE;
     }
     RETURN_FALSE;
@@ -576,8 +782,7 @@ SAFFIRE_METHOD(string, __key) {
 }
 
 SAFFIRE_METHOD(string, __value) {
-    t_string *dst = string_copy_partial(self->data.value, self->data.iter, 1);
-    t_string_object *dst_obj = string_create_new_object(dst, self->data.locale);
+    t_string_object *dst_obj = object_string_char_at(self, self->data.iter);
     RETURN_OBJECT(dst_obj);
 }
 
@@ -616,8 +821,7 @@ SAFFIRE_METHOD(string, __get) {
         return NULL;
     }
 
-    t_string *dst = string_copy_partial(self->data.value, idx, 1);
-    t_string_object *dst_obj = string_create_new_object(dst, self->data.locale);
+    t_string_object *dst_obj = object_string_char_at(self, idx);
     RETURN_OBJECT(dst_obj);
 }
 
@@ -644,7 +848,7 @@ SAFFIRE_METHOD(string, __has) {
  * Initializes string methods and properties, these are used
  */
 void object_string_init(void) {
-    Object_String_struct.attributes = ht_create();
+    Object_String_struct.attributes = ht_create_lookup();
     object_add_internal_method((t_object *)&Object_String_struct, "__ctor",           ATTRIB_METHOD_CTOR, ATTRIB_VISIBILITY_PUBLIC, object_string_method_ctor);
     object_add_internal_method((t_object *)&Object_String_struct, "__dtor",           ATTRIB_METHOD_DTOR, ATTRIB_VISIBILITY_PUBLIC, object_string_method_dtor);
 
@@ -667,7 +871,8 @@ void object_string_init(void) {
     object_add_internal_method((t_object *)&Object_String_struct, "getLocale",      ATTRIB_METHOD_NONE, ATTRIB_VISIBILITY_PUBLIC, object_string_method_get_locale);
 
     object_add_internal_method((t_object *)&Object_String_struct, "index",          ATTRIB_METHOD_NONE, ATTRIB_VISIBILITY_PUBLIC, object_string_method_index);
-//    object_add_internal_method((t_object *)&Object_String_struct, "splice",         ATTRIB_METHOD_NONE, ATTRIB_VISIBILITY_PUBLIC, object_string_method_splice);
+    object_add_internal_method((t_object *)&Object_String_struct, "split",          ATTRIB_METHOD_NONE, ATTRIB_VISIBILITY_PUBLIC, object_string_method_split);
+    object_add_internal_method((t_object *)&Object_String_struct, "splice",         ATTRIB_METHOD_NONE, ATTRIB_VISIBILITY_PUBLIC, object_string_method_splice);
 
     object_add_internal_method((t_object *)&Object_String_struct, "__opr_add",      ATTRIB_METHOD_NONE, ATTRIB_VISIBILITY_PUBLIC, object_string_method_opr_add);
 //    object_add_internal_method((t_object *)&Object_String_struct, "__opr_sl",       ATTRIB_METHOD_NONE, ATTRIB_VISIBILITY_PUBLIC, object_string_method_opr_sl);
@@ -720,7 +925,7 @@ static void obj_populate(t_object *obj, t_dll *arg_list) {
     if (arg_list->size == 1) {
         // 1 element: it's already a string
         t_dll_element *e = DLL_HEAD(arg_list);
-        str_obj->data.value = DLL_DATA_PTR(e);
+        string_adopt_value(str_obj, DLL_DATA_PTR(e));
     } else if (arg_list->size > 1) {
         // 2 (or more) elements: it's a size + char0 string
 
@@ -732,18 +937,14 @@ static void obj_populate(t_object *obj, t_dll *arg_list) {
         e = DLL_NEXT(e);
         char *value = DLL_DATA_PTR(e);
 
-        // Convert our stream to UTF8
-        str_obj->data.value = char_to_string(value, value_len);
+        string_set_value(str_obj, value, value_len);
     }
 
-    t_thread *thread = thread_get_current();
-    str_obj->data.locale = thread->locale ? string_strdup0(thread->locale) : NULL;
+    str_obj->data.locale = thread_get_current()->locale;
 }
 
 static void obj_free(t_object *obj) {
-    t_string_object *str_obj = (t_string_object *)obj;
-    if (str_obj->data.value) string_free(str_obj->data.value);
-    if (str_obj->data.locale) smm_free(str_obj->data.locale);
+    string_free_value((t_string_object *)obj);
 }
 
 
@@ -758,8 +959,12 @@ static void obj_clone(const t_object *original_obj, t_object *cloned_obj) {
     t_string_object *str_org_obj = (t_string_object *)original_obj;
     t_string_object *str_cloned_obj = (t_string_object *)cloned_obj;
 
-    str_cloned_obj->data.locale = string_strdup0(str_org_obj->data.locale);
-    str_cloned_obj->data.value = string_strdup(str_org_obj->data.value);
+    // The clone is a copy of the original object, so its value still points into the original
+    str_cloned_obj->data.value = NULL;
+    str_cloned_obj->data.parent = NULL;
+    if (str_org_obj->data.value) {
+        string_set_value(str_cloned_obj, STRING_CHAR0(str_org_obj->data.value), STRING_LEN(str_org_obj->data.value));
+    }
 }
 
 
@@ -780,20 +985,28 @@ static char *obj_debug(t_object *obj) {
 }
 #endif
 
-static char *obj_hash(t_object *obj) {
+static uint64_t obj_hash(t_object *obj) {
     t_string_object *str_obj = (t_string_object *)obj;
 
-    char *s = (char *)smm_malloc(17);
-
     if (str_obj->data.needs_hashing == 1) {
         // Generate hash
         calculate_hash(str_obj);
         str_obj->data.needs_hashing = 0;
     }
-    memcpy(s, str_obj->data.hash, 16);
-    s[16] = '\0';
 
-    return s;
+    return str_obj->data.hash;
+}
+
+static int obj_equals(t_object *obj1, t_object *obj2) {
+    t_string_object *s1 = (t_string_object *)obj1;
+    t_string_object *s2 = (t_string_object *)obj2;
+
+    if (STROBJ2CHAR0LEN(s1) != STROBJ2CHAR0LEN(s2)) return 0;
+
+    // When both hashes are known, they must match
+    if (! s1->data.needs_hashing && ! s2->data.needs_hashing && s1->data.hash != s2->data.hash) return 0;
+
+    return memcmp(STROBJ2CHAR0(s1), STROBJ2CHAR0(s2), STROBJ2CHAR0LEN(s1)) == 0;
 }
 
 
@@ -811,6 +1024,8 @@ t_object_funcs string_funcs = {
 #else
         NULL,
 #endif
+        NULL,                 // Traverse
+        obj_equals,           // Equals
 };
 
 
@@ -819,7 +1034,7 @@ t_string_object Object_String_struct = {
     OBJECT_HEAD_INIT("string", objectTypeString, OBJECT_TYPE_CLASS, &string_funcs, sizeof(t_string_object_data)),
     {
         NULL,       // Value
-        "",         // Hash value
+        0,          // Hash value
         1,          // Needs hashing
         0,          // Internal iteration index
         NULL,       // Locale
@@ -41,6 +41,27 @@
  * ======================================================================
  */
 
+/**
+ * Makes sure the tuple can hold at least capacity elements without reallocating
+ */
+void object_tuple_reserve(t_tuple_object *tuple_obj, long capacity) {
+    if (capacity <= tuple_obj->data.capacity) return;
+
+    tuple_obj->data.elements = smm_realloc(tuple_obj->data.elements, capacity * sizeof(t_object *));
+    tuple_obj->data.capacity = capacity;
+}
+
+/**
+ * Appends an object to the end of the tuple. The tuple holds a reference to the object.
+ */
+void object_tuple_append(t_tuple_object *tuple_obj, t_object *obj) {
+    if (tuple_obj->data.length == tuple_obj->data.capacity) {
+        object_tuple_reserve(tuple_obj, tuple_obj->data.capacity ? tuple_obj->data.capacity * 2 : 2);
+    }
+
+    object_inc_ref(obj);
+    tuple_obj->data.elements[tuple_obj->data.length++] = obj;
+}
 
 
 /* ======================================================================
@@ -68,7 +89,32 @@ SAFFIRE_METHOD(tuple, dtor) {
  * Saffire method: Returns the number of elements stored inside the tuple
  */
 SAFFIRE_METHOD(tuple, length) {
-    RETURN_NUMERICAL(self->data.ht->element_count);
+    RETURN_NUMERICAL(self->data.length);
+}
+
+SAFFIRE_METHOD(tuple, __iterator) {
+    RETURN_SELF;
+}
+SAFFIRE_METHOD(tuple, __key) {
+    RETURN_NUMERICAL(self->data.iter.idx);
+}
+SAFFIRE_METHOD(tuple, __value) {
+    if (self->data.iter.idx < 0 || self->data.iter.idx >= self->data.length) RETURN_NULL;
+    RETURN_OBJECT(self->data.elements[self->data.iter.idx]);
+}
+SAFFIRE_METHOD(tuple, __next) {
+    self->data.iter.idx++;
+    RETURN_SELF;
+}
+SAFFIRE_METHOD(tuple, __rewind) {
+    self->data.iter.idx = 0;
+    RETURN_SELF;
+}
+SAFFIRE_METHOD(tuple, __hasNext) {
+    if (self->data.iter.idx < self->data.length) {
+        RETURN_TRUE;
+    }
+    RETURN_FALSE;
 }
 
 /**
@@ -82,14 +128,12 @@ SAFFIRE_METHOD(tuple, get) {
     }
 
     // Check index boundaries
-    if (idx < 0 || idx >= self->data.ht->element_count) {
+    if (idx < 0 || idx >= self->data.length) {
         object_raise_exception(Object_IndexException, 1, "Index out of range");
         return NULL;
     }
 
-    t_object *obj = ht_find_num(self->data.ht, idx);
-    if (obj == NULL) RETURN_NULL;
-    RETURN_OBJECT(obj);
+    RETURN_OBJECT(self->data.elements[idx]);
 }
 
 ///**
@@ -101,7 +145,7 @@ SAFFIRE_METHOD(tuple, get) {
 //    if (object_parse_arguments(SAFFIRE_METHOD_ARGS, "o", &val) != 0) {
 //        return NULL;
 //    }
-//    ht_add_num(self->data.ht, self->data.ht->element_count, val);
+//    object_tuple_append(self, val);
 //    RETURN_SELF;
 //}
 
@@ -119,14 +163,12 @@ SAFFIRE_METHOD(tuple, populate) {
         return NULL;
     }
 
-    if (! self->data.ht) {
-        self->data.ht = ht_create();
-    }
+    object_tuple_reserve(self, self->data.length + ht_obj->data.ht->element_count);
 
     t_hash_iter iter;
     ht_iter_init(&iter, ht_obj->data.ht);
     while (ht_iter_valid(&iter)) {
-        ht_add_num(self->data.ht, self->data.ht->element_count, ht_iter_value(&iter));
+        object_tuple_append(self, ht_iter_value(&iter));
         ht_iter_next(&iter);
     }
 
@@ -154,7 +196,7 @@ SAFFIRE_METHOD(tuple, remove) {
  *
  */
 SAFFIRE_METHOD(tuple, conv_boolean) {
-    if (self->data.ht->element_count == 0) {
+    if (self->data.length == 0) {
         RETURN_FALSE;
     } else {
         RETURN_TRUE;
@@ -172,7 +214,7 @@ SAFFIRE_METHOD(tuple, conv_null) {
  *
  */
 SAFFIRE_METHOD(tuple, conv_numerical) {
-    RETURN_NUMERICAL(self->data.ht->element_count);
+    RETURN_NUMERICAL(self->data.length);
 }
 
 /**
@@ -204,7 +246,7 @@ SAFFIRE_METHOD(tuple, conv_string) {
  * Initializes tuple methods and properties, these are used
  */
 void object_tuple_init(void) {
-    Object_Tuple_struct.attributes = ht_create();
+    Object_Tuple_struct.attributes = ht_create_lookup();
     object_add_internal_method((t_object *)&Object_Tuple_struct, "__ctor",        ATTRIB_METHOD_CTOR, ATTRIB_VISIBILITY_PUBLIC, object_tuple_method_ctor);
     object_add_internal_method((t_object *)&Object_Tuple_struct, "__dtor",        ATTRIB_METHOD_DTOR, ATTRIB_VISIBILITY_PUBLIC, object_tuple_method_dtor);
 
@@ -217,6 +259,15 @@ void object_tuple_init(void) {
     object_add_internal_method((t_object *)&Object_Tuple_struct, "populate",       ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, object_tuple_method_populate);
     object_add_interface((t_object *)&Object_Tuple_struct, Object_Datastructure);
 
+    // Iterator interface
+    object_add_internal_method((t_object *)&Object_Tuple_struct, "__iterator",     ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, object_tuple_method___iterator);
+    object_add_internal_method((t_object *)&Object_Tuple_struct, "__key",          ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, object_tuple_method___key);
+    object_add_internal_method((t_object *)&Object_Tuple_struct, "__value",        ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, object_tuple_method___value);
+    object_add_internal_method((t_object *)&Object_Tuple_struct, "__rewind",       ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, object_tuple_method___rewind);
+    object_add_internal_method((t_object *)&Object_Tuple_struct, "__next",         ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, object_tuple_method___next);
+    object_add_internal_method((t_object *)&Object_Tuple_struct, "__hasNext",      ATTRIB_METHOD_STATIC, ATTRIB_VISIBILITY_PUBLIC, object_tuple_method___hasNext);
+    object_add_interface((t_object *)&Object_Tuple_struct, Object_Iterator);
+
 //    object_add_internal_method((t_object *)&Object_Tuple_struct, "add",         ATTRIB_METHOD_NONE, ATTRIB_VISIBILITY_PUBLIC, object_tuple_method_add);
 //    object_add_internal_method((t_object *)&Object_Tuple_struct, "get",         ATTRIB_METHOD_NONE, ATTRIB_VISIBILITY_PUBLIC, object_tuple_method_get);
 //    object_add_internal_method((t_object *)&Object_Tuple_struct, "length",      ATTRIB_METHOD_NONE, ATTRIB_VISIBILITY_PUBLIC, object_tuple_method_length);
@@ -246,10 +297,10 @@ void object_tuple_fini(void) {
 static void obj_populate(t_object *obj, t_dll *arg_list) {
     t_tuple_object *tuple_obj = (t_tuple_object *)obj;
 
-    // Create new hash list
-    tuple_obj->data.ht = ht_create();
+    tuple_obj->data.elements = NULL;
+    tuple_obj->data.length = 0;
+    tuple_obj->data.capacity = 0;
 
-    int cnt = 0;
     t_dll_element *e = DLL_HEAD(arg_list);
     if (! e) return;
 
@@ -257,12 +308,13 @@ static void obj_populate(t_object *obj, t_dll *arg_list) {
     e = DLL_NEXT(e);
 
     t_dll *dll = DLL_DATA_PTR(e);
+    object_tuple_reserve(tuple_obj, dll->size);
     e = DLL_HEAD(dll);    // 2nd element of the DLL is a DLL itself.. inception!
     while (e) {
         t_object *arg_obj = DLL_DATA_PTR(e);
 
         DEBUG_PRINT_STRING_ARGS("Adding object: %s\n", object_debug(arg_obj));
-        ht_add_num(tuple_obj->data.ht, cnt++, arg_obj);
+        object_tuple_append(tuple_obj, arg_obj);
 
         e = DLL_NEXT(e);
     }
@@ -272,8 +324,22 @@ static void obj_free(t_object *obj) {
     t_tuple_object *tuple_obj = (t_tuple_object *)obj;
     if (! tuple_obj) return;
 
-    if (tuple_obj->data.ht) {
-        ht_destroy(tuple_obj->data.ht);
+    // Release all elements
+    for (long i=0; i!=tuple_obj->data.length; i++) {
+        object_release(tuple_obj->data.elements[i]);
+    }
+
+    smm_free(tuple_obj->data.elements);
+    tuple_obj->data.elements = NULL;
+    tuple_obj->data.length = 0;
+    tuple_obj->data.capacity = 0;
+}
+
+static void obj_traverse(t_object *obj, t_object_visit visit, void *arg) {
+    t_tuple_object *tuple_obj = (t_tuple_object *)obj;
+
+    for (long i=0; i!=tuple_obj->data.length; i++) {
+        visit(tuple_obj->data.elements[i], arg);
     }
 }
 
@@ -286,11 +352,7 @@ static void obj_destroy(t_object *obj) {
 static char *obj_debug(t_object *obj) {
     t_tuple_object *tuple_obj = (t_tuple_object *)obj;
 
-    if (tuple_obj->data.ht) {
-        snprintf(tuple_obj->__debug_info, DEBUG_INFO_SIZE-1, "tuple[%d]", tuple_obj->data.ht->element_count);
-    } else {
-        snprintf(tuple_obj->__debug_info, DEBUG_INFO_SIZE-1, "tuple[]");
-    }
+    snprintf(tuple_obj->__debug_info, DEBUG_INFO_SIZE-1, "tuple[%ld]", tuple_obj->data.length);
     return tuple_obj->__debug_info;
 
 }
@@ -310,6 +372,7 @@ t_object_funcs tuple_funcs = {
 #else
         NULL,
 #endif
+        obj_traverse,         // Traverse referenced objects
 };
 
 
@@ -318,7 +381,12 @@ t_object_funcs tuple_funcs = {
 t_tuple_object Object_Tuple_struct = {
     OBJECT_HEAD_INIT("tuple", objectTypeTuple, OBJECT_TYPE_CLASS, &tuple_funcs, sizeof(t_tuple_object_data)),
     {
-        NULL
+        NULL,       // Elements
+        0,          // Length
+        0,          // Capacity
+        {
+            0
+        }
     },
     OBJECT_FOOTER
 };
@@ -26,6 +26,7 @@
 */
 #include <string.h>
 #include <saffire/vm/vmtypes.h>
+#include <saffire/vm/block.h>
 #include <saffire/debug.h>
 #include <saffire/general/output.h>
 
@@ -59,6 +60,7 @@ static t_vm_frameblock *_create_block(t_vm_stackframe *frame, int type, int sp)
     block->sp = sp;
     block->visited = 0;
     block->iter.available = 0;
+    block->iter.native = ITER_NATIVE_NONE;
 
 #ifdef __DEBUG
 vm_frame_block_debug(frame);
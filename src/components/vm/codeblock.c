@@ -27,9 +27,84 @@
 #include <string.h>
 #include <saffire/vm/codeblock.h>
 #include <saffire/vm/context.h>
+#include <saffire/vm/vm.h>
+#include <saffire/vm/vm_opcodes.h>
 #include <saffire/memory/smm.h>
+#include <saffire/general/output.h>
 #include <saffire/debug.h>
 
+extern char *vm_code_names[];
+extern int vm_codes_offset[];
+
+/**
+ * String constants, keyed by their symbol. Constants with the same contents share one string object over all
+ * codeblocks. The pool holds a reference to each object until vm_codeblock_fini().
+ */
+static t_hash_table *string_constants = NULL;
+
+
+/**
+ * Returns the shared string object for a string constant
+ */
+static t_object *_vm_codeblock_string_constant(t_symbol *symbol) {
+    if (! string_constants) {
+        string_constants = ht_create_lookup();
+    }
+
+    t_object *obj = ht_find_sym(string_constants, symbol);
+    if (obj) return obj;
+
+    obj = object_alloc_instance(Object_String, 2, symbol->len, symbol->s);
+    object_inc_ref(obj);
+    ht_add_sym(string_constants, symbol, obj);
+    return obj;
+}
+
+/**
+ * Reads a 16 bit operand from the code and moves the instruction pointer past it
+ */
+static unsigned int _vm_codeblock_decode_operand(t_bytecode *bytecode, unsigned long *ip) {
+    // Truncated code, operand is not present
+    if (*ip + sizeof(uint16_t) > bytecode->code_len) {
+        *ip = bytecode->code_len;
+        return 0;
+    }
+
+    uint16_t *ptr = (uint16_t *)(bytecode->code + *ip);
+    *ip += sizeof(uint16_t);
+
+    return (*ptr & 0xFFFF);
+}
+
+/**
+ * Decodes the code of the bytecode into fixed-width instructions. The last entry is always a STOP instruction, so
+ * running past the end of the code will halt the frame.
+ */
+static t_vm_instruction *_vm_codeblock_decode(t_bytecode *bytecode) {
+    t_vm_instruction *instructions = smm_malloc((bytecode->code_len + 1) * sizeof(t_vm_instruction));
+    bzero(instructions, (bytecode->code_len + 1) * sizeof(t_vm_instruction));
+
+    unsigned long ip = 0;
+    while (ip < bytecode->code_len) {
+        t_vm_instruction *instruction = &instructions[ip];
+
+        instruction->opcode = bytecode->code[ip++];
+
+        // If high bits are set, get operands. Assumes maximum of 3 operands
+        if ((instruction->opcode & 0x80) == 0x80) instruction->oparg1 = _vm_codeblock_decode_operand(bytecode, &ip);
+        if ((instruction->opcode & 0xC0) == 0xC0) instruction->oparg2 = _vm_codeblock_decode_operand(bytecode, &ip);
+        if ((instruction->opcode & 0xE0) == 0xE0) instruction->oparg3 = _vm_codeblock_decode_operand(bytecode, &ip);
+
+        instruction->next = ip;
+    }
+
+    instructions[bytecode->code_len].opcode = VM_STOP;
+    instructions[bytecode->code_len].next = bytecode->code_len;
+
+    return instructions;
+}
+
+
 /**
  *
  */
@@ -47,9 +122,11 @@ static t_vm_codeblock *_vm_codeblock_new(t_bytecode *bytecode, t_vm_context *con
     // Create constants that are located in the bytecode and store inside the codeblock
     codeblock->constants_objects_len = bytecode->constants_len;
     codeblock->constants_objects = smm_malloc(bytecode->constants_len * sizeof(t_object *));
+    codeblock->constants_symbols = smm_malloc(bytecode->constants_len * sizeof(t_symbol *));
     for (int i=0; i!=codeblock->constants_objects_len; i++) {
         t_object *obj = NULL;
         t_bytecode_constant *c = bytecode->constants[i];
+        codeblock->constants_symbols[i] = NULL;
         switch (c->type) {
             case BYTECODE_CONST_CODE :
             {
@@ -59,7 +136,8 @@ static t_vm_codeblock *_vm_codeblock_new(t_bytecode *bytecode, t_vm_context *con
                 break;
             }
             case BYTECODE_CONST_STRING :
-                obj = object_alloc_instance(Object_String, 2, bytecode->constants[i]->len, bytecode->constants[i]->data.s);
+                codeblock->constants_symbols[i] = symbol_intern(c->data.s, c->len);
+                obj = _vm_codeblock_string_constant(codeblock->constants_symbols[i]);
                 break;
             case BYTECODE_CONST_REGEX :
                 obj = object_alloc_instance(Object_Regex, 2, bytecode->constants[i]->len, bytecode->constants[i]->data.s);
@@ -74,6 +152,26 @@ static t_vm_codeblock *_vm_codeblock_new(t_bytecode *bytecode, t_vm_context *con
         object_inc_ref(obj);
     }
 
+    // Create empty resolve cache for the identifiers, and intern their names
+    codeblock->identifier_cache = NULL;
+    codeblock->identifiers_symbols = NULL;
+    if (bytecode->identifiers_len > 0) {
+        codeblock->identifier_cache = smm_malloc(bytecode->identifiers_len * sizeof(t_vm_identifier_cache));
+        bzero(codeblock->identifier_cache, bytecode->identifiers_len * sizeof(t_vm_identifier_cache));
+
+        codeblock->identifiers_symbols = smm_malloc(bytecode->identifiers_len * sizeof(t_symbol *));
+        for (int i=0; i!=bytecode->identifiers_len; i++) {
+            codeblock->identifiers_symbols[i] = symbol_intern(bytecode->identifiers[i]->s, bytecode->identifiers[i]->len);
+        }
+    }
+
+    codeblock->self_slot = vm_codeblock_get_slot(codeblock, "self");
+
+    // Decode the code, so the VM does not need to decode operands on every execution
+    codeblock->instructions_len = bytecode->code_len + 1;
+    codeblock->instructions = _vm_codeblock_decode(bytecode);
+    codeblock->instructions_threaded = 0;
+
     return codeblock;
 }
 
@@ -90,6 +188,59 @@ t_vm_codeblock *vm_codeblock_new(t_bytecode *bytecode, t_vm_context *context) {
 }
 
 
+/**
+ * Returns the local variable slot for the given identifier, or -1 when the identifier is not present in the codeblock
+ */
+int vm_codeblock_get_slot(t_vm_codeblock *codeblock, char *id) {
+    for (int i=0; i!=codeblock->bytecode->identifiers_len; i++) {
+        if (strcmp(codeblock->bytecode->identifiers[i]->s, id) == 0) return i;
+    }
+
+    return -1;
+}
+
+
+/**
+ * Outputs the decoded instructions of a codeblock, followed by the codeblocks of its methods. Instructions that are
+ * quickened by the VM are shown with the generic opcode they replace.
+ */
+void vm_codeblock_disassemble(t_vm_codeblock *codeblock) {
+    output_char("; codeblock %s (%lu bytes)\n", codeblock->context->file.full ? codeblock->context->file.full : "<none>", codeblock->bytecode->code_len);
+
+    unsigned long ip = 0;
+    while (ip < codeblock->bytecode->code_len) {
+        t_vm_instruction *instruction = &codeblock->instructions[ip];
+        unsigned int opcode = instruction->opcode;
+
+        output_char("%08lX %-20s", ip, vm_code_names[vm_codes_offset[opcode]]);
+        if ((opcode & 0x80) == 0x80) output_char(" %5d", instruction->oparg1);
+        if ((opcode & 0xC0) == 0xC0) output_char(" %5d", instruction->oparg2);
+        if ((opcode & 0xE0) == 0xE0) output_char(" %5d", instruction->oparg3);
+
+        if (vm_generic_opcode(opcode) != opcode) {
+            output_char("    ; quickened %s", vm_code_names[vm_codes_offset[vm_generic_opcode(opcode)]]);
+        }
+        if (instruction->deopt_count) {
+            output_char("    ; de-optimized %u times", instruction->deopt_count);
+        }
+        output_char("\n");
+
+        // Truncated code
+        if (instruction->next <= ip) break;
+        ip = instruction->next;
+    }
+    output_char("\n");
+
+    // Disassemble the codeblocks of the methods and closures inside this codeblock
+    for (int i=0; i!=codeblock->constants_objects_len; i++) {
+        if (codeblock->bytecode->constants[i]->type != BYTECODE_CONST_CODE) continue;
+
+        t_callable_object *callable = (t_callable_object *)codeblock->constants_objects[i];
+        vm_codeblock_disassemble(callable->data.code.external.codeblock);
+    }
+}
+
+
 /**
  * Destroys a codeblock object. Note that this also cleans up constants that are imported from the codeblock, but does
  * not free the codeblock itself. This is because the codeblock might be a child of another codeblock (like a method
@@ -107,6 +258,15 @@ void vm_codeblock_destroy(t_vm_codeblock *codeblock) {
         object_release((t_object *)codeblock->constants_objects[i]);
     }
     smm_free(codeblock->constants_objects);
+    smm_free(codeblock->constants_symbols);
+
+    if (codeblock->identifier_cache) smm_free(codeblock->identifier_cache);
+    if (codeblock->identifiers_symbols) smm_free(codeblock->identifiers_symbols);
+
+    for (int i=0; i!=codeblock->instructions_len; i++) {
+        if (codeblock->instructions[i].attrib_cache) smm_free(codeblock->instructions[i].attrib_cache);
+    }
+    smm_free(codeblock->instructions);
 
     // Release context
     vm_context_free(codeblock->context);
@@ -114,3 +274,21 @@ void vm_codeblock_destroy(t_vm_codeblock *codeblock) {
     // Release codeblock itself
     smm_free(codeblock);
 }
+
+
+/**
+ * Releases the shared string constants. Must be called after all codeblocks are destroyed.
+ */
+void vm_codeblock_fini(void) {
+    if (! string_constants) return;
+
+    t_hash_iter iter;
+    ht_iter_init(&iter, string_constants);
+    while (ht_iter_valid(&iter)) {
+        object_release((t_object *)ht_iter_value(&iter));
+        ht_iter_next(&iter);
+    }
+
+    ht_destroy(string_constants);
+    string_constants = NULL;
+}
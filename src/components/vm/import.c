@@ -82,8 +82,8 @@ typedef struct _vm_class_mapping {
  * Initialize import cache table.
  */
 void vm_namespace_cache_init(void) {
-    global_module_mapping = ht_create();
-    global_class_mapping = ht_create();
+    global_module_mapping = ht_create_lookup();
+    global_class_mapping = ht_create_lookup();
 }
 
 /**
@@ -43,6 +43,127 @@
 #include <saffire/general/output.h>
 
 #include <saffire/general/hashtable.h>
+#include <saffire/general/symbol.h>
+
+unsigned long vm_identifier_generation = 0;
+
+/**
+ * Returns a frame from the frame pool of the current thread, or allocates a new one when the pool is empty. Pooled
+ * frames keep their local slots, all other fields must be initialized by the caller.
+ */
+static t_vm_stackframe *_vm_frame_pool_acquire(void) {
+    t_thread *thread = thread_get_current();
+
+    if (thread && thread->frame_pool) {
+        t_vm_stackframe *frame = thread->frame_pool;
+        thread->frame_pool = frame->parent;
+        thread->frame_pool_len--;
+        return frame;
+    }
+
+    t_vm_stackframe *frame = smm_malloc(sizeof(t_vm_stackframe));
+    bzero(frame, sizeof(t_vm_stackframe));
+    return frame;
+}
+
+/**
+ * Returns a destroyed frame to the frame pool of the current thread, or frees it when the pool is full
+ */
+static void _vm_frame_pool_release(t_vm_stackframe *frame) {
+    t_thread *thread = thread_get_current();
+
+    if (thread && thread->frame_pool_len < THREAD_FRAME_POOL_SIZE) {
+        frame->parent = thread->frame_pool;
+        thread->frame_pool = frame;
+        thread->frame_pool_len++;
+        return;
+    }
+
+    if (frame->local_slots) smm_free(frame->local_slots);
+    smm_free(frame);
+}
+
+/**
+ * Takes the operand stack of a frame from the top of the VM stack of the current thread. Falls back to a separate
+ * allocation when the VM stack is full.
+ */
+static void _vm_frame_stack_acquire(t_vm_stackframe *frame, long stack_size) {
+    t_thread *thread = thread_get_current();
+
+    if (thread && ! thread->stack) {
+        thread->stack = smm_malloc(THREAD_STACK_SIZE * sizeof(t_object *));
+        bzero(thread->stack, THREAD_STACK_SIZE * sizeof(t_object *));
+        thread->stack_len = THREAD_STACK_SIZE;
+        thread->stack_top = 0;
+    }
+
+    if (thread && thread->stack_top + stack_size <= thread->stack_len) {
+        frame->stack = thread->stack + thread->stack_top;
+        frame->stack_pooled = 1;
+        thread->stack_top += stack_size;
+        return;
+    }
+
+    frame->stack = smm_malloc(stack_size * sizeof(t_object *));
+    bzero(frame->stack, stack_size * sizeof(t_object *));
+    frame->stack_pooled = 0;
+}
+
+/**
+ * Gives the segments that were released out of order back to the VM stack, as long as they are on top of it
+ */
+static void _vm_frame_stack_reclaim(t_thread *thread) {
+    int i = 0;
+    while (i < thread->stack_released_len) {
+        if (thread->stack_released[i * 2 + 1] != thread->stack_top) {
+            i++;
+            continue;
+        }
+
+        // Reclaim the segment, and start over as the segment below it might be released as well
+        thread->stack_top = thread->stack_released[i * 2];
+        thread->stack_released_len--;
+        thread->stack_released[i * 2] = thread->stack_released[thread->stack_released_len * 2];
+        thread->stack_released[i * 2 + 1] = thread->stack_released[thread->stack_released_len * 2 + 1];
+        i = 0;
+    }
+}
+
+/**
+ * Gives the operand stack of a frame back to the VM stack. Frames that are destroyed out of order (like imported
+ * module frames) are remembered, and their segment is given back once all segments above it are released.
+ */
+static void _vm_frame_stack_release(t_vm_stackframe *frame) {
+    long stack_size = frame->codeblock->bytecode->stack_size;
+
+    if (! frame->stack_pooled) {
+        smm_free(frame->stack);
+        frame->stack = NULL;
+        return;
+    }
+
+    // The next frame expects a clean stack
+    bzero(frame->stack, stack_size * sizeof(t_object *));
+
+    t_thread *thread = thread_get_current();
+    if (thread) {
+        long start = frame->stack - thread->stack;
+
+        if (start + stack_size == thread->stack_top) {
+            thread->stack_top = start;
+            _vm_frame_stack_reclaim(thread);
+        } else {
+            if (thread->stack_released_len == thread->stack_released_cap) {
+                thread->stack_released_cap = thread->stack_released_cap ? thread->stack_released_cap * 2 : 8;
+                thread->stack_released = smm_realloc(thread->stack_released, thread->stack_released_cap * 2 * sizeof(long));
+            }
+            thread->stack_released[thread->stack_released_len * 2] = start;
+            thread->stack_released[thread->stack_released_len * 2 + 1] = start + stack_size;
+            thread->stack_released_len++;
+        }
+    }
+    frame->stack = NULL;
+}
 
 
 /**
@@ -111,31 +232,34 @@ long vm_frame_get_source_line(t_vm_stackframe *frame) {
 }
 
 /**
- * Returns the next opcode
+ * Returns the next decoded instruction and moves the instruction pointer past it
  */
-unsigned char vm_frame_get_next_opcode(t_vm_stackframe *frame) {
-    // Sanity stop
+t_vm_instruction *vm_frame_get_next_instruction(t_vm_stackframe *frame) {
+    // Sanity stop. The last instruction is always a STOP
     if (frame->ip >= frame->codeblock->bytecode->code_len) {
         DEBUG_PRINT_CHAR("Running outside bytecode!\n\n\n");
-        return VM_STOP;
+        return &frame->codeblock->instructions[frame->codeblock->bytecode->code_len];
     }
 
-    unsigned char op = frame->codeblock->bytecode->code[frame->ip];
-    frame->ip++;
+    t_vm_instruction *instruction = &frame->codeblock->instructions[frame->ip];
+    frame->ip = instruction->next;
 
-    return op;
+    return instruction;
 }
 
 /**
- * Returns he next operand. Does not do any sanity checks if it actually is an operand.
+ * Replaces a tagged numerical on the given stack position with a numerical object, which is owned by the stack.
  */
-unsigned int vm_frame_get_operand(t_vm_stackframe *frame) {
-    // Read operand
-    uint16_t *ptr = (uint16_t *)(frame->codeblock->bytecode->code + frame->ip);
-    unsigned int ret = (*ptr & 0xFFFF);
+static t_object *_vm_frame_stack_box(t_vm_stackframe *frame, int pos) {
+    t_object *obj = frame->stack[pos];
 
-    frame->ip += sizeof(uint16_t);
-    return ret;
+    if (obj && OBJECT_IS_TAGGED(obj)) {
+        obj = object_numerical_box(obj);
+        object_inc_ref(obj);
+        frame->stack[pos] = obj;
+    }
+
+    return obj;
 }
 
 /**
@@ -143,8 +267,19 @@ unsigned int vm_frame_get_operand(t_vm_stackframe *frame) {
  * data of that attribute. Will error when the stack is empty.
  */
 t_object *vm_frame_stack_pop(t_vm_stackframe *frame, int resolve_attrib) {
+    if (frame->sp < frame->codeblock->bytecode->stack_size) {
+        _vm_frame_stack_box(frame, frame->sp);
+    }
+
+    return vm_frame_stack_pop_tagged(frame, resolve_attrib);
+}
+
+/**
+ * Pops an object from the stack, just like vm_frame_stack_pop(), but returns tagged numericals as-is.
+ */
+t_object *vm_frame_stack_pop_tagged(t_vm_stackframe *frame, int resolve_attrib) {
 #if __DEBUG_STACK
-    DEBUG_PRINT_CHAR(ANSI_BRIGHTYELLOW "STACK POP (%d): %08X '%s'{%d}\n" ANSI_RESET, frame->sp, (uintptr_t)frame->stack[frame->sp], object_debug(frame->stack[frame->sp]), ((t_object *)(frame->stack[frame->sp]))->ref_count);
+    DEBUG_PRINT_CHAR(ANSI_BRIGHTYELLOW "STACK POP (%d): %08X '%s'\n" ANSI_RESET, frame->sp, (uintptr_t)frame->stack[frame->sp], object_debug(frame->stack[frame->sp]));
 #endif
 
     if (frame->sp >= frame->codeblock->bytecode->stack_size) {
@@ -156,7 +291,7 @@ t_object *vm_frame_stack_pop(t_vm_stackframe *frame, int resolve_attrib) {
     frame->sp++;
 
 
-    if (resolve_attrib == 1 && OBJECT_IS_ATTRIBUTE(obj)) return ((t_attrib_object *)obj)->data.attribute;
+    if (resolve_attrib == 1 && ! OBJECT_IS_TAGGED(obj) && OBJECT_IS_ATTRIBUTE(obj)) return ((t_attrib_object *)obj)->data.attribute;
     return obj;
 }
 
@@ -165,7 +300,7 @@ t_object *vm_frame_stack_pop(t_vm_stackframe *frame, int resolve_attrib) {
  */
 void vm_frame_stack_push(t_vm_stackframe *frame, t_object *obj) {
 #if __DEBUG_STACK
-        DEBUG_PRINT_STRING_ARGS(ANSI_BRIGHTYELLOW "STACK PUSH(%d): %s %08lX {%d}\n" ANSI_RESET, frame->sp-1, object_debug(obj), (unsigned long)obj, obj->ref_count);
+        DEBUG_PRINT_STRING_ARGS(ANSI_BRIGHTYELLOW "STACK PUSH(%d): %s %08lX\n" ANSI_RESET, frame->sp-1, object_debug(obj), (unsigned long)obj);
 #endif
 
 
@@ -185,12 +320,41 @@ void vm_frame_stack_modify(t_vm_stackframe *frame, int idx, t_object *obj) {
  * Fetches the top of the stack. Does not pop anything.
  */
 t_object *vm_frame_stack_fetch_top(t_vm_stackframe *frame, int resolve_attrib) {
-    t_object *obj = frame->stack[frame->sp];
+    t_object *obj = _vm_frame_stack_box(frame, frame->sp);
 
     if (resolve_attrib == 1 && OBJECT_IS_ATTRIBUTE(obj)) return ((t_attrib_object *)obj)->data.attribute;
     return obj;
 }
 
+/**
+ * Fetches an object from the stack without popping it. Index 0 is the top of the stack.
+ */
+t_object *vm_frame_stack_fetch(t_vm_stackframe *frame, int idx, int resolve_attrib) {
+    if (frame->sp + idx >= frame->codeblock->bytecode->stack_size) {
+        fatal_error(1, "Trying to fetch from outside the stack");        /* LCOV_EXCL_LINE */
+    }
+
+    t_object *obj = _vm_frame_stack_box(frame, frame->sp + idx);
+
+    if (resolve_attrib == 1 && obj && OBJECT_IS_ATTRIBUTE(obj)) return ((t_attrib_object *)obj)->data.attribute;
+    return obj;
+}
+
+/**
+ * Fetches an object from the stack without popping it, just like vm_frame_stack_fetch(), but returns tagged
+ * numericals as-is.
+ */
+t_object *vm_frame_stack_fetch_tagged(t_vm_stackframe *frame, int idx, int resolve_attrib) {
+    if (frame->sp + idx >= frame->codeblock->bytecode->stack_size) {
+        fatal_error(1, "Trying to fetch from outside the stack");        /* LCOV_EXCL_LINE */
+    }
+
+    t_object *obj = frame->stack[frame->sp + idx];
+
+    if (resolve_attrib == 1 && obj && ! OBJECT_IS_TAGGED(obj) && OBJECT_IS_ATTRIBUTE(obj)) return ((t_attrib_object *)obj)->data.attribute;
+    return obj;
+}
+
 /**
  * Return a constant literal, without converting to an object
  */
@@ -214,11 +378,23 @@ t_object *vm_frame_get_constant(t_vm_stackframe *frame, int idx) {
     return frame->codeblock->constants_objects[idx];
 }
 
+/**
+ * Returns the symbol of a string constant, or NULL when the constant is not a string
+ */
+t_symbol *vm_frame_get_constant_symbol(t_vm_stackframe *frame, int idx) {
+    if (idx < 0 || idx >= frame->codeblock->bytecode->constants_len) {
+        fatal_error(1, "Trying to fetch from outside constant range");      /* LCOV_EXCL_LINE */
+    }
+
+    return frame->codeblock->constants_symbols[idx];
+}
+
 /**
  * Store object into the global identifier table. When obj == NULL, it will remove the actual reference (plus object)
  */
 void vm_frame_set_global_identifier(t_vm_stackframe *frame, char *id, t_object *obj) {
     if (obj == NULL) {
+        vm_identifier_generation++;
         t_object *old = ht_remove_str(frame->global_identifiers->data.ht, id);
 
         if (old) object_release(old);
@@ -226,7 +402,12 @@ void vm_frame_set_global_identifier(t_vm_stackframe *frame, char *id, t_object *
     }
 
     if (! ht_exists_str(frame->global_identifiers->data.ht, id)) {
-        ht_add_str(frame->global_identifiers->data.ht, id, obj);
+        vm_identifier_generation++;
+        ht_add_sym(frame->global_identifiers->data.ht, symbol_intern0(id), obj);
+        object_inc_ref(obj);
+    } else if (ht_find_str(frame->global_identifiers->data.ht, id) == OBJECT_NEEDS_RESOLVING) {
+        // Store the resolved object, so it does not need to be resolved again
+        ht_replace_sym(frame->global_identifiers->data.ht, symbol_intern0(id), obj);
         object_inc_ref(obj);
     } else {
         // @TODO: Overwrite, or throw error?
@@ -243,15 +424,33 @@ t_object *vm_frame_get_global_identifier(t_vm_stackframe *frame, char *id) {
     return obj;
 }
 
+/**
+ * Returns the local identifier table, and creates it when the frame does not have one yet
+ */
+static t_hash_object *_vm_frame_get_local_identifiers(t_vm_stackframe *frame) {
+    if (frame->local_identifiers == NULL) {
+        DEBUG_PRINT_CHAR("Creating local ID table for frame %08x\n", frame);
+        frame->local_identifiers = (t_hash_object *)object_alloc_instance(Object_Hash, 0);
+        object_inc_ref((t_object *)frame->local_identifiers);
+    }
+
+    return frame->local_identifiers;
+}
+
 /**
  * Store object into the local identifier table
  */
 void vm_frame_set_local_identifier(t_vm_stackframe *frame, char *class, t_object *new_obj) {
     t_vm_context *ctx = vm_frame_get_context(frame);
     char *fqcn = vm_context_create_fqcn_from_context(ctx, class);
-    t_object *old_obj = (t_object *) ht_replace_str(frame->local_identifiers->data.ht, fqcn, new_obj);
+    t_object *old_obj = (t_object *) ht_replace_sym(_vm_frame_get_local_identifiers(frame)->data.ht, symbol_intern0(fqcn), new_obj);
     smm_free(fqcn);
 
+    // A new local identifier can shadow globals and builtins, or is a global when this is the initial frame
+    if (old_obj == NULL) {
+        vm_identifier_generation++;
+    }
+
     // Increase object before decreasing old object. Otherwise, the object might expire
     // in the mean time when the object has ref-count 1 and old_obj == new_obj.
     if (new_obj != NULL && new_obj != OBJECT_NEEDS_RESOLVING) {
@@ -263,6 +462,43 @@ void vm_frame_set_local_identifier(t_vm_stackframe *frame, char *class, t_object
     }
 }
 
+/**
+ * Store object into a local variable slot
+ */
+void vm_frame_set_fast_identifier(t_vm_stackframe *frame, int idx, t_object *new_obj) {
+    if (idx < 0 || idx >= frame->codeblock->bytecode->identifiers_len) {
+        fatal_error(1, "Trying to store outside local slot range");        /* LCOV_EXCL_LINE */
+    }
+
+    t_object *old_obj = frame->local_slots[idx];
+    frame->local_slots[idx] = new_obj;
+
+    // Increase object before decreasing old object, same as vm_frame_set_local_identifier()
+    if (new_obj != NULL) {
+        object_inc_ref(new_obj);
+    }
+
+    if (old_obj != NULL) {
+        object_release(old_obj);
+    }
+}
+
+/**
+ * Return object from a local variable slot. When the slot is not set yet, the identifier is looked up the regular
+ * way, as it could be a global or builtin identifier that has not been overwritten by a local variable (yet).
+ * Local variable slots can hold tagged numericals, which are returned as-is.
+ */
+t_object *vm_frame_get_fast_identifier(t_vm_stackframe *frame, int idx) {
+    if (idx < 0 || idx >= frame->codeblock->bytecode->identifiers_len) {
+        fatal_error(1, "Trying to fetch from outside local slot range");        /* LCOV_EXCL_LINE */
+    }
+
+    t_object *obj = frame->local_slots[idx];
+    if (obj) return obj;
+
+    return vm_frame_find_cached_identifier(frame, idx);
+}
+
 void vm_frame_set_alias_identifier(t_vm_stackframe *frame, char *class, char *target_fqcn) {
     if (vm_frame_find_identifier(frame, class)) {
         fatal_error(1, "Alias %s already imported", class);
@@ -283,7 +519,10 @@ void vm_frame_set_alias_identifier(t_vm_stackframe *frame, char *class, char *ta
 
 void vm_frame_set_builtin_identifier(t_vm_stackframe *frame, char *uqcn, t_object *obj) {
     // Builtin objects do not have a FQCN. They are stored as "numeric", "false", "null" etc..
-    t_object *old_obj = ht_replace_str(frame->builtin_identifiers->data.ht, uqcn, obj);
+    t_object *old_obj = ht_replace_sym(frame->builtin_identifiers->data.ht, symbol_intern0(uqcn), obj);
+    if (old_obj == NULL) {
+        vm_identifier_generation++;
+    }
 
     object_release(old_obj);
     if (obj != NULL && obj != OBJECT_NEEDS_RESOLVING) {
@@ -340,7 +579,7 @@ t_object *vm_frame_identifier_exists(t_vm_stackframe *frame, char *id) {
     /*
      *  Find in local identifiers (without FQCN)
      */
-    obj = ht_find_str(frame->local_identifiers->data.ht, id);
+    obj = frame->local_identifiers ? ht_find_str(frame->local_identifiers->data.ht, id) : NULL;
     if (obj == OBJECT_NEEDS_RESOLVING) {
         obj = _vm_frame_object_resolve(frame, id);
         if (obj) {
@@ -354,7 +593,7 @@ t_object *vm_frame_identifier_exists(t_vm_stackframe *frame, char *id) {
     /*
      *  Check local identifiers, but on FQCN
      */
-    obj = ht_find_str(frame->local_identifiers->data.ht, fqcn);
+    obj = frame->local_identifiers ? ht_find_str(frame->local_identifiers->data.ht, fqcn) : NULL;
     if (obj == OBJECT_NEEDS_RESOLVING) {
         obj = _vm_frame_object_resolve(frame, fqcn);
         if (obj) {
@@ -435,6 +674,89 @@ t_object *vm_frame_find_identifier(t_vm_stackframe *frame, char *id) {
     return NULL;
 }
 
+/**
+ * Returns one of the identifier tables of the frame (VM_IDENTIFIER_TABLE_*), or NULL when the frame does not have it
+ */
+static t_hash_object *_vm_frame_get_identifier_table(t_vm_stackframe *frame, int table) {
+    switch (table) {
+        case VM_IDENTIFIER_TABLE_LOCAL :
+            return frame->local_identifiers;
+        case VM_IDENTIFIER_TABLE_GLOBAL :
+            return frame->global_identifiers;
+        default :
+            return frame->builtin_identifiers;
+    }
+}
+
+/**
+ * Stores in the cache which table and key resolved the identifier id into obj. The tables and keys are checked in
+ * the same order as vm_frame_identifier_exists() does.
+ */
+static void _vm_frame_cache_identifier(t_vm_stackframe *frame, t_vm_identifier_cache *cache, char *id, t_object *obj) {
+    t_symbol *id_sym = symbol_intern0(id);
+    char *fqcn = vm_context_create_fqcn_from_context(vm_frame_get_context(frame), id);
+    t_symbol *fqcn_sym = symbol_intern0(fqcn);
+    smm_free(fqcn);
+
+    struct {
+        int table;
+        t_symbol *key;
+    } candidates[] = {
+        { VM_IDENTIFIER_TABLE_LOCAL, id_sym },
+        { VM_IDENTIFIER_TABLE_LOCAL, fqcn_sym },
+        { VM_IDENTIFIER_TABLE_GLOBAL, id_sym },
+        { VM_IDENTIFIER_TABLE_GLOBAL, fqcn_sym },
+        { VM_IDENTIFIER_TABLE_BUILTIN, id_sym },
+    };
+
+    cache->key = NULL;
+    for (int i=0; i!=sizeof(candidates) / sizeof(candidates[0]); i++) {
+        t_hash_object *table = _vm_frame_get_identifier_table(frame, candidates[i].table);
+        if (table == NULL) continue;
+
+        t_object *found = ht_find_sym(table->data.ht, candidates[i].key);
+        if (found == NULL) continue;
+
+        // The first table that holds the identifier is the one that resolved it
+        if (found == obj) {
+            cache->table = candidates[i].table;
+            cache->key = candidates[i].key;
+        }
+        break;
+    }
+
+    cache->generation = vm_identifier_generation;
+    cache->globals = frame->global_identifiers;
+}
+
+/**
+ * Same as vm_frame_find_identifier, but finds the identifier at index idx of the frame's bytecode, and caches where
+ * it was found inside the codeblock. The cache is only used when the frame has no local identifiers of its own, as
+ * those differ for each frame that runs the codeblock. The cache is invalidated by the global identifier generation.
+ */
+t_object *vm_frame_find_cached_identifier(t_vm_stackframe *frame, int idx) {
+    if (frame->local_identifiers != NULL && frame->local_identifiers != frame->global_identifiers) {
+        return vm_frame_find_identifier(frame, vm_frame_get_name(frame, idx));
+    }
+
+    t_vm_identifier_cache *cache = &frame->codeblock->identifier_cache[idx];
+    if (cache->key && cache->generation == vm_identifier_generation && cache->globals == frame->global_identifiers) {
+        t_hash_object *table = _vm_frame_get_identifier_table(frame, cache->table);
+        t_object *obj = table ? ht_find_sym(table->data.ht, cache->key) : NULL;
+        if (obj != NULL && obj != OBJECT_NEEDS_RESOLVING) {
+            return obj;
+        }
+    }
+
+    t_object *obj = vm_frame_find_identifier(frame, vm_frame_get_name(frame, idx));
+    if (obj) {
+        // Resolving can change the generation and the tables, so locate the identifier after resolving
+        _vm_frame_cache_identifier(frame, cache, vm_frame_get_name(frame, idx), obj);
+    }
+
+    return obj;
+}
+
 /**
  * Returns an identifier name as string
  */
@@ -452,7 +774,7 @@ char *vm_frame_get_name(t_vm_stackframe *frame, int idx) {
     //    print_debug_table(frame->local_identifiers->ht, "Locals");
     //#endif
 
-    return frame->codeblock->bytecode->identifiers[idx]->s;
+    return frame->codeblock->identifiers_symbols[idx]->s;
 }
 
 /**
@@ -463,32 +785,56 @@ t_vm_stackframe *vm_stackframe_new(t_vm_stackframe *parent_frame, t_vm_codeblock
     DEBUG_PRINT_CHAR("\n\n\n\n\n============================ VM frame new ('%s' -> parent: '%s') ============================\n", codeblock->context->module.full, parent_frame ? parent_frame->codeblock->context->module.full : "<root>");
     DEBUG_PRINT_CHAR("THIS FRAME IS BASED ON %08X\n", parent_frame);
 
-    t_vm_stackframe *frame = smm_malloc(sizeof(t_vm_stackframe));
+    t_vm_stackframe *frame = _vm_frame_pool_acquire();
 
     DEBUG_PRINT_CHAR("THIS FRAME IS %08X\n", frame);
-    bzero(frame, sizeof(t_vm_stackframe));
 
     frame->parent = parent_frame;
     frame->codeblock = codeblock;
 
+    frame->caller = NULL;
+    frame->depth = 0;
+    frame->tail_calls = 0;
+    frame->call_attrib = NULL;
+    frame->call_argv = NULL;
+    frame->call_argc = 0;
+
     frame->ip = 0;
 
+    frame->lineno_lowerbound = 0;
+    frame->lineno_upperbound = 0;
+    frame->lineno_current_line = 0;
+    frame->lineno_current_lino_offset = 0;
+
+    // Blocks are initialized when they are pushed
+    frame->block_cnt = 0;
+
     frame->trace_class = NULL;
     frame->trace_method = NULL;
+    frame->param_count = 0;
+    frame->params = NULL;
+    frame->executions = 0;
 
     frame->sp = codeblock->bytecode->stack_size;
-    frame->stack = smm_malloc(codeblock->bytecode->stack_size * sizeof(t_object *));
-    bzero(frame->stack, codeblock->bytecode->stack_size * sizeof(t_object *));
+    _vm_frame_stack_acquire(frame, codeblock->bytecode->stack_size);
 
 
     //    DEBUG_PRINT_CHAR("Increasing builtin_identifiers refcount\n");
     frame->builtin_identifiers = builtin_identifiers;
     object_inc_ref((t_object *)builtin_identifiers);
 
-    // Create new empty local identifier hash
-    DEBUG_PRINT_CHAR("Creating local ID table for frame %08x\n", frame);
-    frame->local_identifiers = (t_hash_object *)object_alloc_instance(Object_Hash, 0);
-    object_inc_ref((t_object *)frame->local_identifiers);
+    // Local variables are stored in slots, one for each identifier. Only the initial frame has a local identifier
+    // hash from the start, as it doubles as the global identifier hash. Other frames create it when needed. The slots
+    // of a pooled frame are reused when they are large enough.
+    if (codeblock->bytecode->identifiers_len > frame->local_slots_len) {
+        if (frame->local_slots) smm_free(frame->local_slots);
+        frame->local_slots = smm_malloc(codeblock->bytecode->identifiers_len * sizeof(t_object *));
+        frame->local_slots_len = codeblock->bytecode->identifiers_len;
+    }
+    if (codeblock->bytecode->identifiers_len > 0) {
+        bzero(frame->local_slots, codeblock->bytecode->identifiers_len * sizeof(t_object *));
+    }
+    frame->local_identifiers = NULL;
 
     if (frame->parent == NULL) {
         frame->object_aliases = ht_create();
@@ -499,7 +845,7 @@ t_vm_stackframe *vm_stackframe_new(t_vm_stackframe *parent_frame, t_vm_codeblock
     // Set the variable hashes
     if (frame->parent == NULL) {
         // global identifiers are the same as the local identifiers for the initial frame
-        frame->global_identifiers = frame->local_identifiers;
+        frame->global_identifiers = _vm_frame_get_local_identifiers(frame);
     } else {
         // if not the initial frame, link globals from the parent frame
         frame->global_identifiers = frame->parent->global_identifiers;
@@ -535,11 +881,17 @@ void vm_stackframe_destroy(t_vm_stackframe *frame) {
 
 //    // Remove codeblock reference (don't mind cleanup, since we still have it on the codeblock stack)
 //    frame->codeblock = NULL;
-    if (frame->trace_class) smm_free(frame->trace_class);
-    if (frame->trace_method) smm_free(frame->trace_method);
+
+    // Release local variables
+    for (int i=frame->codeblock->bytecode->identifiers_len-1; i>=0; i--) {
+        if (frame->local_slots[i] == NULL) continue;
+
+        DEBUG_PRINT_STRING_ARGS("Frame destroy: Releasing slot => %s => %s [%p]\n", frame->codeblock->bytecode->identifiers[i]->s, object_debug(frame->local_slots[i]), frame->local_slots[i]);
+        object_release(frame->local_slots[i]);
+    }
 
     t_hash_iter iter;
-    ht_iter_init_tail(&iter, frame->local_identifiers->data.ht);
+    ht_iter_init_tail(&iter, frame->local_identifiers ? frame->local_identifiers->data.ht : NULL);
     while (ht_iter_valid(&iter)) {
         char *key = ht_iter_key_str(&iter);
         t_object *val = ht_iter_value(&iter);
@@ -559,11 +911,14 @@ void vm_stackframe_destroy(t_vm_stackframe *frame) {
 
     // Free identifiers
     object_release((t_object *)frame->global_identifiers);
-    object_release((t_object *)frame->local_identifiers);
+    if (frame->local_identifiers) object_release((t_object *)frame->local_identifiers);
     object_release((t_object *)frame->builtin_identifiers);
 
 
     if (frame->parent == NULL) {
+        // Global identifiers are gone, so cached identifiers that are resolved through them are not valid anymore
+        vm_identifier_generation++;
+
         // If we are the lowest frame, remove object aliases
         ht_iter_init(&iter, frame->object_aliases);
         while (ht_iter_valid(&iter)) {
@@ -574,9 +929,9 @@ void vm_stackframe_destroy(t_vm_stackframe *frame) {
         ht_destroy(frame->object_aliases);
     }
 
-    smm_free(frame->stack);
+    _vm_frame_stack_release(frame);
 
-    smm_free(frame);
+    _vm_frame_pool_release(frame);
 }
 
 
@@ -24,6 +24,7 @@
  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
+#include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
 #include <string.h>
@@ -31,6 +32,7 @@
 #include <saffire/vm/thread.h>
 #include <saffire/memory/smm.h>
 #include <saffire/vm/vm.h>
+#include <saffire/general/symbol.h>
 
 // Current running thread. Don't change directly, but only through thread_switch() methods.
 t_thread *current_thread;
@@ -40,13 +42,26 @@ t_thread *thread_new(void) {
     t_thread *thread = smm_malloc(sizeof(t_thread));
     bzero(thread, sizeof(t_thread));
 
-    thread->locale = string_strdup0(config_get_string("intl.locale", "nl_NL"));
+    thread->locale = symbol_intern0(config_get_string("intl.locale", "nl_NL"))->s;
+    thread->max_depth = config_get_long("vm.max_depth", THREAD_MAX_DEPTH);
     return thread;
 }
 
 void thread_free(t_thread *thread) {
-    if (thread->locale) {
-        smm_free(thread->locale);
+    // Free the frames inside the frame pool
+    while (thread->frame_pool) {
+        t_vm_stackframe *frame = thread->frame_pool;
+        thread->frame_pool = frame->parent;
+
+        if (frame->local_slots) smm_free(frame->local_slots);
+        smm_free(frame);
+    }
+
+    if (thread->stack) {
+        smm_free(thread->stack);
+    }
+    if (thread->stack_released) {
+        smm_free(thread->stack_released);
     }
 
     smm_free(thread);
@@ -90,15 +105,24 @@ t_hash_table *thread_create_stacktrace() {
     while (frame) {
         char *s = NULL;
         t_vm_context *ctx = vm_frame_get_context(frame);
-        smm_asprintf_char(&s, "#%d %s:%d %s.%s (<args>)",
+
+        // Frames that are released by tail calls are not available anymore, but we mark where they were
+        char elided[64] = "";
+        if (frame->tail_calls) {
+            snprintf(elided, sizeof(elided), " [%ld frames elided by tail calls]", frame->tail_calls);
+        }
+
+        smm_asprintf_char(&s, "#%d %s:%d %s.%s (<args>)%s",
             depth,
             ctx->file.full ? ctx->file.full : "<none>",
             vm_frame_get_source_line(frame),
             ctx->module.full ? ctx->module.full : "",
-            frame->trace_method ? frame->trace_method : ""
+            frame->trace_method ? frame->trace_method : "",
+            elided
         );
 
         t_string_object *str = (t_string_object *)object_alloc_instance(Object_String, 2, strlen(s), s);
+        object_inc_ref((t_object *)str);
         ht_add_num(stacktrace, stacktrace->element_count, str);
 
         frame = frame->parent;
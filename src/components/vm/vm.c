@@ -29,6 +29,7 @@
 #include <saffire/compiler/bytecode.h>
 #include <saffire/vm/vm.h>
 #include <saffire/vm/stackframe.h>
+#include <saffire/vm/codeblock.h>
 #include <saffire/vm/context.h>
 #include <saffire/vm/vm_opcodes.h>
 #include <saffire/vm/block.h>
@@ -44,6 +45,7 @@
 #include <saffire/vm/import.h>
 #include <saffire/gc/gc.h>
 #include <saffire/debugger/dbgp/dbgp.h>
+#include <saffire/config.h>
 
 t_hash_table *builtin_identifiers_ht;       // Builtin identifiers - actual hash table
 t_hash_object *builtin_identifiers;         // Builtin identifiers - hash object
@@ -52,6 +54,60 @@ t_hash_object *builtin_identifiers;         // Builtin identifiers - hash object
 // A boolean method or property name that ends on a '?'
 #define IS_BOOLEAN_ATTRIBUTE(s)  (s[strlen(s)-1] == '?')
 
+#ifdef VM_COMPUTED_GOTO
+    // Every opcode handler gets its own label, so decoded instructions can jump directly to their handler
+    #define VM_CASE(_op_)       case _op_ : vm_target_##_op_
+
+    #ifdef __DEBUG
+        // Always go through the dispatcher, so opcodes can be traced
+        #define VM_DISPATCH()   goto dispatch
+    #else
+        // Fetch the next instruction and jump directly to its handler. The debugger needs the complete dispatcher.
+        #define VM_DISPATCH()                               \
+            do {                                            \
+                if (VM_IN_DEBUG_MODE) goto dispatch;        \
+                frame->executions++;                        \
+                instruction = &instructions[frame->ip];     \
+                frame->ip = instruction->next;              \
+                opcode = instruction->opcode;               \
+                oparg1 = instruction->oparg1;               \
+                oparg2 = instruction->oparg2;               \
+                oparg3 = instruction->oparg3;               \
+                goto *instruction->handler;                 \
+            } while (0)
+    #endif
+#else
+    #define VM_CASE(_op_)       case _op_
+    #define VM_DISPATCH()       goto dispatch
+#endif
+
+#ifdef VM_COMPUTED_GOTO
+    // Rewrites the opcode of a decoded instruction in place, together with its handler
+    #define VM_REWRITE(_instruction_, _opcode_)                 \
+        do {                                                    \
+            (_instruction_)->opcode = (_opcode_);               \
+            (_instruction_)->handler = vm_targets[(_opcode_)];  \
+        } while (0)
+#else
+    #define VM_REWRITE(_instruction_, _opcode_)                 \
+        do {                                                    \
+            (_instruction_)->opcode = (_opcode_);               \
+        } while (0)
+#endif
+
+// Rewrites a quickened instruction back to its generic opcode, and lets the generic handler execute it instead
+#define VM_DEOPTIMIZE()                                         \
+    do {                                                        \
+        opcode = vm_generic_opcode(opcode);                     \
+        VM_REWRITE(instruction, opcode);                        \
+        instruction->quicken_count = 0;                         \
+        instruction->deopt_count++;                             \
+        goto execute;                                           \
+    } while (0)
+
+#define VM_QUICKEN_THRESHOLD    8       // Consecutive executions with stable operand types before an instruction is quickened
+#define VM_QUICKEN_MAX_DEOPTS   4       // Instructions that are de-optimized this often will stay generic
+
 // Flow termination reasons
 #define REASON_NONE         0       // No return status. Just end the execution
 #define REASON_RETURN       1       // Return statement given
@@ -110,14 +166,14 @@ static int _vm_coerce(t_object *left_obj, t_object *right_obj, t_object **left_t
     }
 
     // Must return tuple of 2
-    if (ret->data.ht->element_count != 2) {
+    if (ret->data.length != 2) {
         thread_create_exception_printf((t_exception_object *)Object_CoerceException, 1, "__coerce() must return a tuple[[]] with 2 elements");
         return -1;
     }
 
     // Must return tuple of 2 with same typed objects
-    t_object *obj1 = ht_find_num(ret->data.ht, 0);
-    t_object *obj2 = ht_find_num(ret->data.ht, 1);
+    t_object *obj1 = ret->data.elements[0];
+    t_object *obj2 = ret->data.elements[1];
 
     // What about  "foo extends string" vs "string" ??  or instanceof?
     if (obj1->type != obj2->type) {
@@ -134,12 +190,353 @@ static int _vm_coerce(t_object *left_obj, t_object *right_obj, t_object **left_t
     return 0;
 }
 
+// Builtin objects that are not extended by a user class. Their operator and comparison methods are known (and read-only).
+#define IS_NATIVE_NUMERICAL(obj)    (OBJECT_IS_TAGGED(obj) || ((obj)->type == objectTypeNumerical && (obj)->class == Object_Numerical))
+#define IS_NATIVE_STRING(obj)       (OBJECT_IS_STRING(obj) && (obj)->class == Object_String)
+#define IS_NATIVE_BOOLEAN(obj)      (IS_BOOLEAN_TRUE(obj) || IS_BOOLEAN_FALSE(obj))
+#define IS_NATIVE_LIST(obj)         (OBJECT_IS_LIST(obj) && (obj)->class == Object_List)
+#define IS_NATIVE_TUPLE(obj)        (OBJECT_IS_TUPLE(obj) && (obj)->class == Object_Tuple)
+#define IS_NATIVE_HASH(obj)         (OBJECT_IS_HASH(obj) && (obj)->class == Object_Hash)
+
+#define NATIVE_BOOLEAN(b)           ((b) ? Object_True : Object_False)
+
+/**
+ * Returns a numerical for the stack. The value is tagged when it fits, so no object needs to be allocated for it.
+ */
+static inline t_object *_vm_numerical(long value) {
+    if (NUM_FITS_TAGGED(value)) return NUM2TAGGED(value);
+    return NUM2OBJ(value);
+}
+
+/**
+ * Does operators on builtin numerical, boolean and string objects directly, without calling the operator method.
+ * Returns NULL when the operation is not handled natively, and the operator method must be called instead.
+ */
+static t_object *_vm_object_operator_native(t_object *obj1, int opr, t_object *obj2) {
+    if (IS_NATIVE_NUMERICAL(obj1) && IS_NATIVE_NUMERICAL(obj2)) {
+        long l = OBJ2NUM(obj1);
+        long r = OBJ2NUM(obj2);
+
+        switch (opr) {
+            case OPERATOR_ADD : return _vm_numerical(l + r);
+            case OPERATOR_SUB : return _vm_numerical(l - r);
+            case OPERATOR_MUL : return _vm_numerical(l * r);
+            // Division by zero is raised by the method itself
+            case OPERATOR_DIV : return r ? _vm_numerical(l / r) : NULL;
+            case OPERATOR_MOD : return r ? _vm_numerical(l % r) : NULL;
+            case OPERATOR_AND : return _vm_numerical(l & r);
+            case OPERATOR_OR  : return _vm_numerical(l | r);
+            case OPERATOR_XOR : return _vm_numerical(l ^ r);
+            // Unary operators only work on the first operand
+            case OPERATOR_UNARY_INV : return _vm_numerical(~l);
+            case OPERATOR_UNARY_NOT : return _vm_numerical(!l);
+            case OPERATOR_UNARY_POS : return _vm_numerical(+l);
+            case OPERATOR_UNARY_NEG : return _vm_numerical(-l);
+        }
+        return NULL;
+    }
+
+    if (IS_NATIVE_BOOLEAN(obj1) && IS_NATIVE_BOOLEAN(obj2)) {
+        long l = ((t_boolean_object *)obj1)->data.value;
+        long r = ((t_boolean_object *)obj2)->data.value;
+
+        switch (opr) {
+            case OPERATOR_AND : return NATIVE_BOOLEAN((l & r) >= 1);
+            case OPERATOR_OR  : return NATIVE_BOOLEAN((l | r) >= 1);
+            case OPERATOR_XOR : return NATIVE_BOOLEAN((l ^ r) >= 1);
+            case OPERATOR_UNARY_NOT : return NATIVE_BOOLEAN(! l);
+        }
+        return NULL;
+    }
+
+    if (opr == OPERATOR_ADD && IS_NATIVE_STRING(obj1) && IS_NATIVE_STRING(obj2)) {
+        t_string *dst = string_strcat(((t_string_object *)obj1)->data.value, ((t_string_object *)obj2)->data.value);
+        return STR2OBJ(dst);
+    }
+
+    return NULL;
+}
+
+/**
+ * Does comparisons on builtin numerical, boolean and string objects directly, without calling the comparison method.
+ * Returns NULL when the comparison is not handled natively, and the comparison method must be called instead.
+ */
+static t_object *_vm_object_comparison_native(t_object *obj1, int cmp, t_object *obj2) {
+    if (IS_NATIVE_NUMERICAL(obj1) && IS_NATIVE_NUMERICAL(obj2)) {
+        long l = OBJ2NUM(obj1);
+        long r = OBJ2NUM(obj2);
+
+        switch (cmp) {
+            case COMPARISON_EQ : return NATIVE_BOOLEAN(l == r);
+            case COMPARISON_NE : return NATIVE_BOOLEAN(l != r);
+            case COMPARISON_LT : return NATIVE_BOOLEAN(l < r);
+            case COMPARISON_GT : return NATIVE_BOOLEAN(l > r);
+            case COMPARISON_LE : return NATIVE_BOOLEAN(l <= r);
+            case COMPARISON_GE : return NATIVE_BOOLEAN(l >= r);
+        }
+        return NULL;
+    }
+
+    if (IS_NATIVE_BOOLEAN(obj1) && IS_NATIVE_BOOLEAN(obj2)) {
+        switch (cmp) {
+            case COMPARISON_EQ : return NATIVE_BOOLEAN(obj1 == obj2);
+            case COMPARISON_NE : return NATIVE_BOOLEAN(obj1 != obj2);
+        }
+        return NULL;
+    }
+
+    if ((cmp == COMPARISON_EQ || cmp == COMPARISON_NE) && IS_NATIVE_STRING(obj1) && IS_NATIVE_STRING(obj2)) {
+        t_string *l = ((t_string_object *)obj1)->data.value;
+        t_string *r = ((t_string_object *)obj2)->data.value;
+
+        int equals = (STRING_LEN(l) == STRING_LEN(r) && memcmp(STRING_CHAR0(l), STRING_CHAR0(r), STRING_LEN(l)) == 0);
+        return NATIVE_BOOLEAN(cmp == COMPARISON_EQ ? equals : ! equals);
+    }
+
+    // ASCII strings are ordered bytewise, other strings are ordered by the string methods through ICU
+    if (cmp >= COMPARISON_LT && cmp <= COMPARISON_GE && IS_NATIVE_STRING(obj1) && IS_NATIVE_STRING(obj2)) {
+        t_string *l = ((t_string_object *)obj1)->data.value;
+        t_string *r = ((t_string_object *)obj2)->data.value;
+        if (! STRING_IS_ASCII(l) || ! STRING_IS_ASCII(r)) return NULL;
+
+        int res = string_strcmp(l, r);
+        switch (cmp) {
+            case COMPARISON_LT : return NATIVE_BOOLEAN(res < 0);
+            case COMPARISON_GT : return NATIVE_BOOLEAN(res > 0);
+            case COMPARISON_LE : return NATIVE_BOOLEAN(res <= 0);
+            case COMPARISON_GE : return NATIVE_BOOLEAN(res >= 0);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Returns the quickened opcode for an OPERATOR instruction on the given operands, or 0 when it cannot be quickened
+ */
+static unsigned int _vm_quicken_operator(int opr, t_object *obj1, t_object *obj2) {
+    if (! obj1 || ! IS_NATIVE_NUMERICAL(obj1) || ! IS_NATIVE_NUMERICAL(obj2)) return 0;
+
+    switch (opr) {
+        case OPERATOR_ADD : return VM_ADD_NUM_NUM;
+        case OPERATOR_SUB : return VM_SUB_NUM_NUM;
+    }
+    return 0;
+}
+
+/**
+ * Returns the quickened opcode for a COMPARE_OP instruction on the given operands, or 0 when it cannot be quickened
+ */
+static unsigned int _vm_quicken_comparison(int cmp, t_object *obj1, t_object *obj2) {
+    if (! IS_NATIVE_NUMERICAL(obj1) || ! IS_NATIVE_NUMERICAL(obj2)) return 0;
+
+    switch (cmp) {
+        case COMPARISON_EQ : return VM_EQ_NUM_NUM;
+        case COMPARISON_NE : return VM_NE_NUM_NUM;
+        case COMPARISON_LT : return VM_LT_NUM_NUM;
+        case COMPARISON_GT : return VM_GT_NUM_NUM;
+        case COMPARISON_LE : return VM_LE_NUM_NUM;
+        case COMPARISON_GE : return VM_GE_NUM_NUM;
+    }
+    return 0;
+}
+
+/**
+ * Counts an execution of a generic instruction that could be quickened into the given opcode (0 when the operand
+ * types cannot be quickened). Returns 1 when the operand types have been stable long enough to rewrite the instruction.
+ */
+static int _vm_quicken_count(t_vm_instruction *instruction, unsigned int quickened_opcode) {
+    // Instructions that keep changing types are not worth quickening. Superinstructions are never quickened.
+    if (quickened_opcode == 0 || instruction->deopt_count >= VM_QUICKEN_MAX_DEOPTS || instruction->opcode != vm_generic_opcode(quickened_opcode)) {
+        instruction->quicken_count = 0;
+        return 0;
+    }
+
+    instruction->quicken_count++;
+    return (instruction->quicken_count >= VM_QUICKEN_THRESHOLD);
+}
+
+/**
+ * Fetches the two topmost operands of a quickened numerical instruction without popping them. Returns 0 when they are
+ * not both builtin numericals anymore, and the instruction must be de-optimized.
+ */
+static int _vm_fetch_num_num(t_vm_stackframe *frame, t_object **top, t_object **second) {
+    t_object *obj1 = vm_frame_stack_fetch_tagged(frame, 0, 1);
+    t_object *obj2 = vm_frame_stack_fetch_tagged(frame, 1, 1);
+
+    *top = obj1;
+    *second = obj2;
+
+    return (obj1 && obj2 && IS_NATIVE_NUMERICAL(obj1) && IS_NATIVE_NUMERICAL(obj2));
+}
+
+/**
+ * Returns the generic opcode of a quickened opcode. Other opcodes are returned as-is.
+ */
+unsigned int vm_generic_opcode(unsigned int opcode) {
+    switch (opcode) {
+        case VM_ADD_NUM_NUM :
+        case VM_SUB_NUM_NUM :
+            return VM_OPERATOR;
+        case VM_EQ_NUM_NUM :
+        case VM_NE_NUM_NUM :
+        case VM_LT_NUM_NUM :
+        case VM_GT_NUM_NUM :
+        case VM_LE_NUM_NUM :
+        case VM_GE_NUM_NUM :
+            return VM_COMPARE_OP;
+        case VM_ITER_FETCH_LIST :
+            return VM_ITER_FETCH;
+    }
+    return opcode;
+}
+
+/**
+ * Creates the metadata object (first, last, count, index) for the next element of the iteration block. The
+ * attributes of the metadata are only created when they are actually read.
+ */
+static t_object *_vm_iter_meta(t_vm_frameblock *block) {
+    // Increase iteration count
+    block->iter.index++;
+
+    return object_alloc_instance(Object_Meta, 2, (long)block->iter.index, (long)block->iter.count);
+}
+
+/**
+ * Returns how a builtin object can be iterated without calling its iterator methods (any of ITER_NATIVE_*)
+ */
+static int _vm_iter_native_type(t_object *obj) {
+    if (IS_NATIVE_LIST(obj)) return ITER_NATIVE_LIST;
+    if (IS_NATIVE_TUPLE(obj)) return ITER_NATIVE_TUPLE;
+    if (IS_NATIVE_HASH(obj)) return ITER_NATIVE_HASH;
+    if (IS_NATIVE_STRING(obj)) return ITER_NATIVE_STRING;
+    return ITER_NATIVE_NONE;
+}
+
+/**
+ * Returns the element at idx of a builtin list or tuple, or NULL (and raises an exception) when the index is out of
+ * range.
+ */
+static t_object *_vm_subscript_get_native(t_object *obj, long idx) {
+    t_object **elements;
+    long length;
+
+    if (OBJECT_IS_LIST(obj)) {
+        elements = ((t_list_object *)obj)->data.elements;
+        length = ((t_list_object *)obj)->data.length;
+    } else {
+        elements = ((t_tuple_object *)obj)->data.elements;
+        length = ((t_tuple_object *)obj)->data.length;
+    }
+
+    if (idx < 0 || idx >= length) {
+        thread_create_exception((t_exception_object *)Object_IndexException, 1, "Index out of range");
+        return NULL;
+    }
+
+    return elements[idx];
+}
+
+/**
+ * Rewinds the native iteration of a builtin object. The cursor is kept inside the iteration block, so the object
+ * itself is not modified and can be iterated by nested loops as well.
+ */
+static void _vm_iter_reset_native(t_vm_frameblock *block, t_object *obj) {
+    block->iter.pos = 0;
+
+    switch (block->iter.native) {
+        case ITER_NATIVE_LIST :
+            block->iter.count = ((t_list_object *)obj)->data.length;
+            break;
+        case ITER_NATIVE_TUPLE :
+            block->iter.count = ((t_tuple_object *)obj)->data.length;
+            break;
+        case ITER_NATIVE_HASH :
+            ht_iter_init(&block->iter.ht_iter, ((t_hash_object *)obj)->data.ht);
+            block->iter.count = ((t_hash_object *)obj)->data.ht->element_count;
+            break;
+        case ITER_NATIVE_STRING :
+            block->iter.count = STRING_LEN(((t_string_object *)obj)->data.value);
+            break;
+    }
+}
+
+/**
+ * Pushes the value, the key (when value_count >= 2) and the hasNext boolean of the native iteration of a builtin
+ * object, and moves the cursor to the next element.
+ */
+static void _vm_iter_fetch_native(t_vm_stackframe *frame, t_vm_frameblock *block, t_object *obj, int value_count) {
+    t_object **elements;
+    long length;
+    t_object *value = Object_Null;
+    t_object *key = Object_Null;
+    int has_next = 0;
+    int owned = 0;
+
+    switch (block->iter.native) {
+        case ITER_NATIVE_LIST :
+        case ITER_NATIVE_TUPLE :
+            if (block->iter.native == ITER_NATIVE_LIST) {
+                elements = ((t_list_object *)obj)->data.elements;
+                length = ((t_list_object *)obj)->data.length;
+            } else {
+                elements = ((t_tuple_object *)obj)->data.elements;
+                length = ((t_tuple_object *)obj)->data.length;
+            }
+            has_next = block->iter.pos < length;
+            if (has_next) {
+                value = elements[block->iter.pos];
+                if (value_count >= 2) key = _vm_numerical(block->iter.pos);
+            }
+            break;
+        case ITER_NATIVE_HASH :
+            has_next = ht_iter_valid(&block->iter.ht_iter);
+            if (has_next) {
+                value = ht_iter_value(&block->iter.ht_iter);
+                key = ht_iter_key_obj(&block->iter.ht_iter);
+                if (value == NULL) value = Object_Null;
+                if (key == NULL) key = Object_Null;
+                ht_iter_next(&block->iter.ht_iter);
+            }
+            break;
+        case ITER_NATIVE_STRING :
+            has_next = block->iter.pos < STRING_LEN(((t_string_object *)obj)->data.value);
+            if (has_next) {
+                // Every character is a new string object, which we hand over to the stack
+                value = (t_object *)object_string_char_at((t_string_object *)obj, block->iter.pos);
+                owned = 1;
+                if (value_count >= 2) key = _vm_numerical(block->iter.pos);
+            }
+            break;
+    }
+
+    if (has_next && block->iter.native != ITER_NATIVE_HASH) {
+        block->iter.pos++;
+    }
+
+    vm_frame_stack_push(frame, value);
+    if (! owned) object_inc_ref(value);
+
+    if (value_count >= 2) {
+        vm_frame_stack_push(frame, key);
+        object_inc_ref(key);
+    }
+
+    t_object *has_next_obj = NATIVE_BOOLEAN(has_next);
+    vm_frame_stack_push(frame, has_next_obj);
+    object_inc_ref(has_next_obj);
+}
+
 /**
  * This method is called when we need to call an operator method. Even though eventually
  * it is a normal method call to a _opr_* method, we go a different route so we can easily
  * do custom optimizations later on.
  */
 static t_object *vm_object_operator(t_object *obj1, int opr, t_object *obj2) {
+    // Builtin objects don't need a method call
+    t_object *ret = _vm_object_operator_native(obj1, opr, obj2);
+    if (ret) return ret;
+
     char *opr_method = objectOprMethods[opr];
 
     t_attrib_object *found_obj = object_attrib_find(obj1, opr_method);
@@ -158,6 +555,10 @@ static t_object *vm_object_operator(t_object *obj1, int opr, t_object *obj2) {
  * Calls an comparison function. Returns true or false objects
  */
 static t_object *vm_object_comparison(t_object *obj1, int cmp, t_object *obj2) {
+    // Builtin objects don't need a method call
+    t_object *ret = _vm_object_comparison_native(obj1, cmp, obj2);
+    if (ret) return ret;
+
     char *cmp_method = objectCmpMethods[cmp];
 
     t_attrib_object *found_obj = object_attrib_find(obj1, cmp_method);
@@ -169,7 +570,7 @@ static t_object *vm_object_comparison(t_object *obj1, int cmp, t_object *obj2) {
     DEBUG_PRINT_CHAR(">>> Calling comparison %s(%d) on object %s\n", cmp_method, cmp, obj1->name);
 
     // Call the actual operator and return the result
-    t_object *ret = call_saffire_method(obj1, found_obj, 1, obj2);
+    ret = call_saffire_method(obj1, found_obj, 1, obj2);
     if (! ret) return ret;
 
     // Implicit conversion to boolean if needed
@@ -187,16 +588,16 @@ static t_object *vm_object_comparison(t_object *obj1, int cmp, t_object *obj2) {
  *
  * Returns 0 on success, -1 on failure/exception is thrown
  */
-static int _parse_calling_arguments(t_vm_stackframe *frame, t_callable_object *callable, t_dll *arg_list) {
+static int _parse_calling_arguments(t_vm_stackframe *frame, t_callable_object *callable, t_object **argv, int argc) {
     t_hash_table *ht = callable->data.arguments;
-    t_dll_element *e = DLL_HEAD(arg_list);
+    int idx = 0;
 
 #ifdef __DEBUG
     ht_debug_keys(ht);
 #endif
 
     int need_count = ht->element_count;
-    int given_count = arg_list->size;
+    int given_count = argc;
 
     // When set to null, no varargs are wanted
     t_list_object *vararg_obj = NULL;
@@ -221,7 +622,7 @@ static int _parse_calling_arguments(t_vm_stackframe *frame, t_callable_object *c
 
         // If we have values on the calling arg list, use the next value, overriding any default values set.
         if (given_count) {
-            obj = e ? DLL_DATA_PTR(e) : NULL;
+            obj = idx < argc ? argv[idx] : NULL;
             given_count--;
         }
 
@@ -240,7 +641,7 @@ static int _parse_calling_arguments(t_vm_stackframe *frame, t_callable_object *c
 
                 // Add first argument
                 if (obj) {
-                    ht_add_num(vararg_obj->data.ht, vararg_obj->data.ht->element_count, obj);
+                    object_list_append(vararg_obj, obj);
                 }
 
                 // Make sure we add our List[] to the local_identifiers below
@@ -261,14 +662,19 @@ static int _parse_calling_arguments(t_vm_stackframe *frame, t_callable_object *c
             }
         }
 
-        // Everything is ok, add the new value onto the local identifiers
-        vm_frame_set_local_identifier(frame, name, obj);
+        // Everything is ok, add the new value into its slot, or onto the local identifiers when the method body
+        // does not use the argument.
+        if (arg->slot >= 0) {
+            vm_frame_set_fast_identifier(frame, arg->slot, obj);
+        } else {
+            vm_frame_set_local_identifier(frame, name, obj);
+        }
 
         need_count--;
 
         // Next needed element
         ht_iter_next(&iter);
-        if (e) e = DLL_NEXT(e);
+        idx++;
     }
 
 
@@ -280,9 +686,9 @@ static int _parse_calling_arguments(t_vm_stackframe *frame, t_callable_object *c
         }
 
         // Just add arguments to vararg list. No need to do any typehint checks here.
-        while (e) {
-            ht_add_num(vararg_obj->data.ht, vararg_obj->data.ht->element_count, DLL_DATA_PTR(e));
-            e = DLL_NEXT(e);
+        while (idx < argc) {
+            object_list_append(vararg_obj, argv[idx]);
+            idx++;
         }
     }
 
@@ -330,10 +736,167 @@ static t_object *vm_create_userland_object(t_vm_stackframe *frame, char *name, i
     return user_obj;
 }
 
+/**
+ * Creates the frame in which external code is called at the given call depth, and populates self and the arguments
+ * inside it. Returns NULL when an exception is thrown.
+ */
+static t_vm_stackframe *_vm_frame_create_call(t_object *self_obj, t_vm_stackframe *scope_frame, char *name, t_callable_object *callable_obj, t_object **argv, int argc, long depth) {
+    if (depth > thread_get_current()->max_depth) {
+        thread_create_exception_printf((t_exception_object *)Object_CallException, 1, "Maximum call depth of %ld reached", thread_get_current()->max_depth);
+        return NULL;
+    }
+
+    // Create a new execution frame. The trace names are borrowed, as self and the method outlive the frame.
+    t_vm_stackframe *child_frame = vm_stackframe_new(scope_frame, callable_obj->data.code.external.codeblock);
+    child_frame->trace_class = self_obj ? self_obj->name : "<anonymous>";
+    child_frame->trace_method = name;
+    child_frame->depth = depth;
+
+    // Create self inside the new frame
+    int self_slot = child_frame->codeblock->self_slot;
+    if (self_slot >= 0) {
+        vm_frame_set_fast_identifier(child_frame, self_slot, self_obj);
+    } else {
+        vm_frame_set_local_identifier(child_frame, "self", self_obj);
+    }
+
+    // Parse calling arguments to see if they match our signatures. Note that _parse_calling_arguments also
+    // populates our arguments into the child_frame.
+    if (_parse_calling_arguments(child_frame, callable_obj, argv, argc) != 0) {
+        vm_stackframe_destroy(child_frame);
+
+        // Exception thrown in the argument parsing
+        return NULL;
+    }
+
+    return child_frame;
+}
+
+/**
+ * Returns the arguments of a call that are on the stack of the frame, as a vector. The arguments stay on the stack,
+ * so the vector points directly into the stack. Only when varargs must be expanded, all arguments are moved into an
+ * allocated vector instead, which is returned in allocated_argv.
+ */
+static t_object **_vm_call_args_fetch(t_vm_stackframe *frame, int argc, t_list_object *varargs, int *call_argc, t_object ***allocated_argv) {
+    // The first argument is pushed first, so reverse the arguments on the stack to get them in order
+    t_object **argv = frame->stack + frame->sp;
+    for (int i=0, j=argc-1; i < j; i++, j--) {
+        t_object *tmp = argv[i];
+        argv[i] = argv[j];
+        argv[j] = tmp;
+    }
+
+    // Attributes are passed by their value, just like popping them with resolve_attrib. Tagged numericals are boxed,
+    // as the callee needs real objects.
+    for (int i=0; i!=argc; i++) {
+        if (OBJECT_IS_TAGGED(argv[i])) {
+            argv[i] = object_numerical_box(argv[i]);
+            object_inc_ref(argv[i]);
+        } else if (OBJECT_IS_ATTRIBUTE(argv[i])) {
+            argv[i] = ((t_attrib_object *)argv[i])->data.attribute;
+        }
+    }
+
+    *call_argc = argc;
+    *allocated_argv = NULL;
+
+    if (OBJECT_IS_NULL(varargs)) {
+        return argv;
+    }
+
+    // Move the arguments from the stack and append the varargs, in the correct order
+    t_object **expanded_argv = smm_malloc((argc + varargs->data.length + 1) * sizeof(t_object *));
+    for (int i=0; i!=argc; i++) {
+        expanded_argv[i] = argv[i];
+    }
+    for (int i=0; i!=argc; i++) {
+        vm_frame_stack_pop(frame, 0);
+    }
+
+    for (long i=0; i!=varargs->data.length; i++) {
+        t_object *obj = varargs->data.elements[i];
+        expanded_argv[(*call_argc)++] = obj;
+        object_inc_ref(obj);
+    }
+
+    *allocated_argv = expanded_argv;
+    return expanded_argv;
+}
+
+/**
+ * Releases the arguments of a call. These are either inside the allocated vector, or still on the stack of the frame.
+ */
+static void _vm_call_args_release(t_vm_stackframe *frame, t_object **allocated_argv, int argc) {
+    if (allocated_argv) {
+        for (int i=0; i!=argc; i++) {
+            object_release(allocated_argv[i]);
+        }
+        smm_free(allocated_argv);
+        return;
+    }
+
+    for (int i=0; i!=argc; i++) {
+        object_release(vm_frame_stack_pop(frame, 0));
+    }
+}
+
+/**
+ * Moves the arguments of a call from the stack of the frame into an allocated vector
+ */
+static t_object **_vm_call_args_detach(t_vm_stackframe *frame, t_object **argv, int argc) {
+    t_object **allocated_argv = smm_malloc((argc + 1) * sizeof(t_object *));
+    for (int i=0; i!=argc; i++) {
+        allocated_argv[i] = argv[i];
+    }
+    for (int i=0; i!=argc; i++) {
+        vm_frame_stack_pop(frame, 0);
+    }
+    return allocated_argv;
+}
+
+/**
+ * Destroys a frame that was called from inside the VM loop, together with the called attribute and its arguments
+ * that were kept alive during the call.
+ */
+static void _vm_frame_destroy_call(t_vm_stackframe *frame) {
+    t_vm_stackframe *caller_frame = frame->caller;
+    t_object *call_attrib = frame->call_attrib;
+    t_object **call_argv = frame->call_argv;
+    int call_argc = frame->call_argc;
+
+    vm_stackframe_destroy(frame);
+
+    object_release(call_attrib);
+    _vm_call_args_release(caller_frame, call_argv, call_argc);
+}
+
+/**
+ * Returns 1 when the frame can be released before calling the attribute as a tail call, 0 otherwise.
+ */
+static int _vm_frame_can_tail_call(t_vm_stackframe *frame, t_attrib_object *attrib_obj) {
+    // Only frames that are called from inside the VM loop can be released, others are destroyed by their caller
+    if (! frame->caller) return 0;
+
+    // The scope of the callee must outlive the frame
+    if (! attrib_obj->frame || attrib_obj->frame == frame) return 0;
+
+    // Finally blocks must be executed after the callee has returned
+    for (int i=0; i!=frame->block_cnt; i++) {
+        if (frame->blocks[i].type == BLOCK_TYPE_EXCEPTION) return 0;
+    }
+
+    // Boolean methods check their own return value, so the callee must check the same
+    if (frame->trace_method && IS_BOOLEAN_ATTRIBUTE(frame->trace_method) && ! IS_BOOLEAN_ATTRIBUTE(attrib_obj->data.bound_name)) {
+        return 0;
+    }
+
+    return 1;
+}
+
 /**
  * Call a callable with arguments
  */
-static t_object *_object_call_callable_with_args(t_object *self_obj, t_vm_stackframe *scope_frame, char *name, t_callable_object *callable_obj, t_dll *arg_list) {
+static t_object *_object_call_callable_with_args(t_object *self_obj, t_vm_stackframe *scope_frame, char *name, t_callable_object *callable_obj, t_object **argv, int argc) {
     t_object *ret;
 
     // Check if the object is actually a callable
@@ -347,28 +910,27 @@ static t_object *_object_call_callable_with_args(t_object *self_obj, t_vm_stackf
     if (CALLABLE_IS_CODE_INTERNAL(callable_obj)) {
         // @TODO: should internal code not have a frame as well?
         // Internal function call
-        ret = callable_obj->data.code.internal.native_func(self_obj, arg_list);
+        if (CALLABLE_IS_CODE_DLL(callable_obj)) {
+            // Methods from external modules that still want their arguments inside a DLL
+            t_dll *arg_list = dll_init();
+            for (int i=0; i!=argc; i++) {
+                dll_append(arg_list, argv[i]);
+            }
+            ret = callable_obj->data.code.internal.native_dll_func(self_obj, arg_list);
+            dll_free(arg_list);
+        } else {
+            ret = callable_obj->data.code.internal.native_func(self_obj, argv, argc);
+        }
         object_inc_ref(ret);
         return ret;
     }
 
 
-    // External code
-
-    // Create a new execution frame
-    t_vm_stackframe *child_frame = vm_stackframe_new(scope_frame, callable_obj->data.code.external.codeblock);
-    child_frame->trace_class = self_obj ? string_strdup0(self_obj->name) : string_strdup0("<anonymous>");
-    child_frame->trace_method = string_strdup0(name);
-
-    // Create self inside the new frame
-    vm_frame_set_local_identifier(child_frame, "self", self_obj);
-
-    // Parse calling arguments to see if they match our signatures. Note that _parse_calling_arguments also
-    // populates our arguments into the child_frame.
-    if (arg_list && _parse_calling_arguments(child_frame, callable_obj, arg_list) != 0) {
-        vm_stackframe_destroy(child_frame);
-
-        // Exception thrown in the argument parsing
+    // External code. The depth is counted from the current frame, so calls made from native code are counted as well
+    t_vm_stackframe *current_frame = thread_get_current_frame();
+    long depth = current_frame ? current_frame->depth + 1 : 1;
+    t_vm_stackframe *child_frame = _vm_frame_create_call(self_obj, scope_frame, name, callable_obj, argv, argc, depth);
+    if (! child_frame) {
         return NULL;
     }
 
@@ -455,14 +1017,84 @@ static int _check_attrib_visibility(t_object *self, t_attrib_object *attrib) {
     return -1;
 }
 
+/**
+ * Returns the inline cache of the LOAD_ATTRIB or STORE_ATTRIB instruction. Entries are cleared when attributes have
+ * been added to a class (or a class has been freed) since they were cached.
+ */
+static t_vm_attrib_cache *_vm_attrib_cache_get(t_vm_instruction *instruction) {
+    if (! instruction->attrib_cache) {
+        instruction->attrib_cache = smm_malloc(sizeof(t_vm_attrib_cache));
+        bzero(instruction->attrib_cache, sizeof(t_vm_attrib_cache));
+        instruction->attrib_cache->generation = object_attrib_generation;
+    }
+
+    t_vm_attrib_cache *cache = instruction->attrib_cache;
+    if (cache->generation != object_attrib_generation) {
+        bzero(cache->entries, sizeof(cache->entries));
+        cache->next = 0;
+        cache->generation = object_attrib_generation;
+    }
+
+    return cache;
+}
+
+/**
+ * Finds attribute 'name' for the receiver in the inline cache. Returns NULL when the receiver class is not cached. When
+ * found, checked is set to 1 when the static-call, visibility and readonly checks do not need to be done again.
+ */
+static t_attrib_object *_vm_attrib_cache_find(t_vm_attrib_cache *cache, t_object *self, t_object *offset, t_symbol *name, int *checked) {
+    int is_class = OBJECT_TYPE_IS_CLASS(self);
+    t_object *class = is_class ? self : self->class;
+
+    if (! class) return NULL;
+
+    for (int i=0; i!=VM_ATTRIB_CACHE_WAYS; i++) {
+        t_vm_attrib_cache_entry *entry = &cache->entries[i];
+        if (entry->class != class || entry->is_class != is_class) continue;
+
+        // Attributes owned by the instance itself must be fetched from the instance
+        t_attrib_object *attrib = entry->attrib ? entry->attrib : ht_find_sym(offset->attributes, name);
+        if (attrib) {
+            *checked = entry->checked;
+        }
+        return attrib;
+    }
+
+    return NULL;
+}
+
+/**
+ * Stores an attribute that was found through object_attrib_find_sym() in the inline cache.
+ */
+static void _vm_attrib_cache_store(t_vm_attrib_cache *cache, t_object *self, t_object *offset, t_symbol *name, t_attrib_object *attrib, int checked) {
+    int is_class = OBJECT_TYPE_IS_CLASS(self);
+    t_object *class = is_class ? self : self->class;
+
+    if (! class) return;
+
+    t_vm_attrib_cache_entry *entry = &cache->entries[cache->next];
+    cache->next = (cache->next + 1) % VM_ATTRIB_CACHE_WAYS;
+
+    entry->class = class;
+    entry->is_class = is_class;
+    entry->checked = checked;
+
+    // Only attributes owned by a class are shared between receivers. Instances have their own (duplicated) attributes.
+    if (! OBJECT_TYPE_IS_CLASS(offset) && ht_find_sym(offset->attributes, name) == attrib) {
+        entry->attrib = NULL;
+    } else {
+        entry->attrib = attrib;
+    }
+}
+
 /**
  * Check an attribute and if ok, chck
  */
-static t_object *_object_call_attrib_with_args(t_object *self, t_attrib_object *attrib_obj, t_dll *arg_list) {
+static t_object *_object_call_attrib_with_args(t_object *self, t_attrib_object *attrib_obj, t_object **argv, int argc) {
     // Call on the frame stored in the object. If none is found, use the current frame as the base frame
     t_vm_stackframe *frame = attrib_obj->frame ? attrib_obj->frame : thread_get_current_frame();
 
-    return _object_call_callable_with_args(self, frame, attrib_obj->data.bound_name, (t_callable_object *)attrib_obj->data.attribute, arg_list);
+    return _object_call_callable_with_args(self, frame, attrib_obj->data.bound_name, (t_callable_object *)attrib_obj->data.attribute, argv, argc);
 }
 
 /**
@@ -513,7 +1145,7 @@ void vm_init(int runmode) {
 
     // Initialize hash where everybody can add their builtins to. Since object_hash does not exist yet,
     // we must use a generic hash for this. We will "convert" this to an hash-hobject later
-    builtin_identifiers_ht = ht_create();
+    builtin_identifiers_ht = ht_create_lookup();
 
     // Initialize saffire objects and modules
     object_init();
@@ -569,6 +1201,7 @@ void vm_fini(void) {
     object_release((t_object *)builtin_identifiers);
 
     module_fini();
+    vm_codeblock_fini();
     object_fini();
 
 #ifdef __DEBUG
@@ -593,6 +1226,9 @@ void vm_fini(void) {
 
 
     gc_fini();
+
+    // Tables can still hold symbols until all objects are gone
+    symbol_fini();
 }
 
 /**
@@ -603,10 +1239,98 @@ t_object *_vm_execute(t_vm_stackframe *frame) {
     t_object *left_obj, *right_obj;
     t_attrib_object *attr_obj;
     unsigned int opcode, oparg1, oparg2, oparg3;
+    unsigned int quickened_opcode;
+    t_vm_instruction *instruction;
     long reason = REASON_NONE;
     t_object *dst;
 
 
+#ifdef VM_COMPUTED_GOTO
+    // Handlers for every opcode. Unknown opcodes are NULL
+    static void *vm_targets[256] = {
+        [VM_STOP] = &&vm_target_halt,
+        [VM_RESERVED] = &&vm_target_halt,
+        [VM_POP_TOP] = &&vm_target_VM_POP_TOP,
+        [VM_ROT_TWO] = &&vm_target_VM_ROT_TWO,
+        [VM_ROT_THREE] = &&vm_target_VM_ROT_THREE,
+        [VM_DUP_TOP] = &&vm_target_VM_DUP_TOP,
+        [VM_ROT_FOUR] = &&vm_target_VM_ROT_FOUR,
+        [VM_NOP] = &&vm_target_VM_NOP,
+        [VM_LOAD_ATTRIB] = &&vm_target_VM_LOAD_ATTRIB,
+        [VM_STORE_ATTRIB] = &&vm_target_VM_STORE_ATTRIB,
+        [VM_LOAD_CONST] = &&vm_target_VM_LOAD_CONST,
+        [VM_STORE_ID] = &&vm_target_VM_STORE_ID,
+        [VM_LOAD_ID] = &&vm_target_VM_LOAD_ID,
+        [VM_STORE_FAST] = &&vm_target_VM_STORE_FAST,
+        [VM_LOAD_FAST] = &&vm_target_VM_LOAD_FAST,
+        [VM_OPERATOR] = &&vm_target_VM_OPERATOR,
+        [VM_JUMP_FORWARD] = &&vm_target_VM_JUMP_FORWARD,
+        [VM_JUMP_IF_TRUE] = &&vm_target_VM_JUMP_IF_TRUE,
+        [VM_JUMP_IF_FALSE] = &&vm_target_VM_JUMP_IF_FALSE,
+        [VM_JUMP_IF_FIRST_TRUE] = &&vm_target_VM_JUMP_IF_FIRST_TRUE,
+        [VM_JUMP_IF_FIRST_FALSE] = &&vm_target_VM_JUMP_IF_FIRST_FALSE,
+        [VM_JUMP_ABSOLUTE] = &&vm_target_VM_JUMP_ABSOLUTE,
+        [VM_DUP_TOPX] = &&vm_target_VM_DUP_TOPX,
+        [VM_CALL] = &&vm_target_VM_CALL,
+        [VM_TAIL_CALL] = &&vm_target_VM_TAIL_CALL,
+        [VM_IMPORT] = &&vm_target_VM_IMPORT,
+        [VM_SETUP_LOOP] = &&vm_target_VM_SETUP_LOOP,
+        [VM_SETUP_ELSE_LOOP] = &&vm_target_VM_SETUP_ELSE_LOOP,
+        [VM_POP_BLOCK] = &&vm_target_VM_POP_BLOCK,
+        [VM_CONTINUE_LOOP] = &&vm_target_VM_CONTINUE_LOOP,
+        [VM_BREAK_LOOP] = &&vm_target_VM_BREAK_LOOP,
+        [VM_BREAKELSE_LOOP] = &&vm_target_VM_BREAKELSE_LOOP,
+        [VM_COMPARE_OP] = &&vm_target_VM_COMPARE_OP,
+        [VM_BUILD_ATTRIB] = &&vm_target_VM_BUILD_ATTRIB,
+        [VM_BUILD_INTERFACE] = &&vm_target_VM_BUILD_INTERFACE,
+        [VM_BUILD_CLASS] = &&vm_target_VM_BUILD_CLASS,
+        [VM_STORE_FRAME_ID] = &&vm_target_VM_STORE_FRAME_ID,
+        [VM_RETURN] = &&vm_target_VM_RETURN,
+        [VM_SETUP_EXCEPT] = &&vm_target_VM_SETUP_EXCEPT,
+        [VM_END_FINALLY] = &&vm_target_VM_END_FINALLY,
+        [VM_THROW] = &&vm_target_VM_THROW,
+        [VM_PACK_TUPLE] = &&vm_target_VM_PACK_TUPLE,
+        [VM_UNPACK_TUPLE] = &&vm_target_VM_UNPACK_TUPLE,
+        [VM_ITER_RESET] = &&vm_target_VM_ITER_RESET,
+        [VM_ITER_FETCH] = &&vm_target_VM_ITER_FETCH,
+        [VM_BUILD_DATASTRUCT] = &&vm_target_VM_BUILD_DATASTRUCT,
+        [VM_LOAD_SUBSCRIPT] = &&vm_target_VM_LOAD_SUBSCRIPT,
+        [VM_STORE_SUBSCRIPT] = &&vm_target_VM_STORE_SUBSCRIPT,
+        [VM_ADD_NUM_NUM] = &&vm_target_VM_ADD_NUM_NUM,
+        [VM_SUB_NUM_NUM] = &&vm_target_VM_SUB_NUM_NUM,
+        [VM_EQ_NUM_NUM] = &&vm_target_VM_EQ_NUM_NUM,
+        [VM_NE_NUM_NUM] = &&vm_target_VM_NE_NUM_NUM,
+        [VM_LT_NUM_NUM] = &&vm_target_VM_LT_NUM_NUM,
+        [VM_GT_NUM_NUM] = &&vm_target_VM_GT_NUM_NUM,
+        [VM_LE_NUM_NUM] = &&vm_target_VM_LE_NUM_NUM,
+        [VM_GE_NUM_NUM] = &&vm_target_VM_GE_NUM_NUM,
+        [VM_ITER_FETCH_LIST] = &&vm_target_VM_ITER_FETCH_LIST,
+        [VM_LOAD_CONST_STORE_ID] = &&vm_target_VM_LOAD_CONST_STORE_ID,
+        [VM_COMPARE_JUMP_FALSE] = &&vm_target_VM_COMPARE_JUMP_FALSE,
+        [VM_LOAD_ID_ATTRIB_CALL] = &&vm_target_VM_LOAD_ID_ATTRIB_CALL,
+        [VM_LOAD_ID_ID_OPERATOR] = &&vm_target_VM_LOAD_ID_ID_OPERATOR,
+        [VM_LOAD_CONST_STORE_FAST] = &&vm_target_VM_LOAD_CONST_STORE_FAST,
+        [VM_LOAD_FAST_ATTRIB_CALL] = &&vm_target_VM_LOAD_FAST_ATTRIB_CALL,
+        [VM_LOAD_FAST_FAST_OPERATOR] = &&vm_target_VM_LOAD_FAST_FAST_OPERATOR,
+    };
+
+    t_vm_instruction *instructions;
+#endif
+
+    // Frame that was current when we entered the VM loop
+    t_vm_stackframe *parent_frame = thread_get_current_frame();
+
+    // Default return value;
+    t_object *ret = NULL;
+
+    // Saffire code that is called from inside the loop is executed in the same loop. Entering a frame starts here.
+enter_frame:
+    // Set the correct current frame
+    thread_set_current_frame(frame);
+
+    // Entering a frame is a safe point to collect reference cycles
+    if (gc_collect_pending) gc_collect();
+
 #ifdef __DEBUG
     if (frame->local_identifiers) print_debug_table(frame->local_identifiers->data.ht, "Locals");
     if (frame->global_identifiers) print_debug_table(frame->global_identifiers->data.ht, "Globals");
@@ -636,12 +1360,17 @@ t_object *_vm_execute(t_vm_stackframe *frame) {
     DEBUG_PRINT_CHAR(ANSI_BRIGHTRED "-----------------------------------\n" ANSI_RESET);
 #endif
 
-    // Set the correct current frame
-    t_vm_stackframe *parent_frame = thread_get_current_frame();
-    thread_set_current_frame(frame);
-
-    // Default return value;
-    t_object *ret = NULL;
+#ifdef VM_COMPUTED_GOTO
+    // Label addresses are only known inside this function, so resolve the handlers of the codeblock on first execution
+    instructions = frame->codeblock->instructions;
+    if (! frame->codeblock->instructions_threaded) {
+        for (int i=0; i!=frame->codeblock->instructions_len; i++) {
+            void *handler = vm_targets[instructions[i].opcode & 0xFF];
+            instructions[i].handler = handler ? handler : &&vm_target_unknown;
+        }
+        frame->codeblock->instructions_threaded = 1;
+    }
+#endif
 
     for (;;) {
 
@@ -665,13 +1394,12 @@ dispatch:
         }
 
 
-        // Get opcode and additional argument
-        opcode = vm_frame_get_next_opcode(frame);
-
-        // If high bits are set, get operands. Assumes maximum of 3 operands
-        oparg1 = ((opcode & 0x80) == 0x80) ? vm_frame_get_operand(frame) : 0;
-        oparg2 = ((opcode & 0xC0) == 0xC0) ? vm_frame_get_operand(frame) : 0;
-        oparg3 = ((opcode & 0xE0) == 0xE0) ? vm_frame_get_operand(frame) : 0;
+        // Get the next decoded instruction with its operands
+        instruction = vm_frame_get_next_instruction(frame);
+        opcode = instruction->opcode;
+        oparg1 = instruction->oparg1;
+        oparg2 = instruction->oparg2;
+        oparg3 = instruction->oparg3;
 
 #ifdef __DEBUG
     #if __DEBUG_VM_OPCODES
@@ -726,6 +1454,9 @@ dispatch:
 
 
 
+#ifdef VM_COMPUTED_GOTO
+vm_target_halt:
+#endif
         // Breaks out of the current frame.
         if (opcode == VM_STOP) break;
 
@@ -734,45 +1465,54 @@ dispatch:
             fatal_error(1, "VM: Reached reserved (0xFF) opcode. Halting.\n");       /* LCOV_EXCL_LINE */
         }
 
+#ifdef VM_COMPUTED_GOTO
+        goto *instruction->handler;
+#endif
+
+        // Superinstructions continue with their next opcode from here, and de-optimized instructions are executed again
+execute:
+#ifdef VM_COMPUTED_GOTO
+        goto *vm_targets[opcode];
+#endif
 
         switch (opcode) {
             // Removes SP-0
-            case VM_POP_TOP :
-                obj1 = vm_frame_stack_pop(frame, 1);
+            VM_CASE(VM_POP_TOP) :
+                obj1 = vm_frame_stack_pop_tagged(frame, 1);
                 object_release(obj1);
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Rotate / swap SP-0 and SP-1
-            case VM_ROT_TWO :
+            VM_CASE(VM_ROT_TWO) :
                 obj1 = vm_frame_stack_pop(frame, 1);
                 obj2 = vm_frame_stack_pop(frame, 1);
                 vm_frame_stack_push(frame, obj1);
                 vm_frame_stack_push(frame, obj2);
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Rotate SP-0 to SP-2
-            case VM_ROT_THREE :
+            VM_CASE(VM_ROT_THREE) :
                 obj1 = vm_frame_stack_pop(frame, 1);
                 obj2 = vm_frame_stack_pop(frame, 1);
                 obj3 = vm_frame_stack_pop(frame, 1);
                 vm_frame_stack_push(frame, obj1);
                 vm_frame_stack_push(frame, obj2);
                 vm_frame_stack_push(frame, obj3);
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Duplicate SP-0
-            case VM_DUP_TOP :
+            VM_CASE(VM_DUP_TOP) :
                 obj1 = vm_frame_stack_fetch_top(frame, 0);
                 vm_frame_stack_push(frame, obj1);
                 object_inc_ref(obj1);
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Rotate SP-0 to SP-3
-            case VM_ROT_FOUR :
+            VM_CASE(VM_ROT_FOUR) :
                 obj1 = vm_frame_stack_pop(frame, 1);
                 obj2 = vm_frame_stack_pop(frame, 1);
                 obj3 = vm_frame_stack_pop(frame, 1);
@@ -781,24 +1521,47 @@ dispatch:
                 vm_frame_stack_push(frame, obj2);
                 vm_frame_stack_push(frame, obj3);
                 vm_frame_stack_push(frame, obj4);
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // No operation
-            case VM_NOP :
+            VM_CASE(VM_NOP) :
                 // Does nothing. Can be used for bytecode padding
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Load an attribute from an object
-            case VM_LOAD_ATTRIB :
+            // Superinstruction: LOAD_ID or LOAD_FAST, LOAD_ATTRIB (self scope) and CALL
+            VM_CASE(VM_LOAD_FAST_ATTRIB_CALL) :
+            VM_CASE(VM_LOAD_ID_ATTRIB_CALL) :
+                if (opcode == VM_LOAD_FAST_ATTRIB_CALL) {
+                    dst = vm_frame_get_fast_identifier(frame, oparg1);
+                } else {
+                    dst = vm_frame_find_cached_identifier(frame, oparg1);
+                }
+                if (dst == NULL) {
+                    reason = REASON_EXCEPTION;
+                    thread_create_exception_printf((t_exception_object *)Object_AttributeException, 1, "Identifier '%s' is not found", vm_frame_get_name(frame, oparg1));
+                    goto block_end;
+                }
+
+                vm_frame_stack_push(frame, dst);
+                object_inc_ref(dst);
+
+                // Continue with the LOAD_ATTRIB operands. The CALL operand is kept in oparg3.
+                oparg1 = oparg2;
+                oparg2 = OBJECT_SCOPE_SELF;
+
+                /* FALLTHROUGH */
+
+            VM_CASE(VM_LOAD_ATTRIB) :
                 {
                     // The object to load the attribute from.
                     t_object *self_obj = vm_frame_stack_pop(frame, 1);
 
                     // Name of attribute to load
-                    t_object *name_obj = vm_frame_get_constant(frame, oparg1);
-                    char *name = DUP_OBJ2STR0(name_obj);
+                    t_symbol *name_sym = vm_frame_get_constant_symbol(frame, oparg1);
+                    char *name = name_sym->s;
 
                     // Scope of the loading (start from self. or parent.)
                     int scope = oparg2;
@@ -821,33 +1584,39 @@ dispatch:
                         offset_obj = self_obj->parent;
                     }
 
-                    t_attrib_object *attrib_obj = object_attrib_find(offset_obj, name);
+                    // Try the inline cache first, and fall back to a complete lookup
+                    t_vm_attrib_cache *cache = _vm_attrib_cache_get(instruction);
+                    int checked = 0;
+                    t_attrib_object *attrib_obj = _vm_attrib_cache_find(cache, self_obj, offset_obj, name_sym, &checked);
                     if (attrib_obj == NULL) {
-                        object_release(self_obj);
+                        attrib_obj = object_attrib_find_sym(offset_obj, name_sym);
+                        if (attrib_obj == NULL) {
+                            object_release(self_obj);
 
-                        reason = REASON_EXCEPTION;
-                        thread_create_exception_printf((t_exception_object *)Object_AttributeException, 1, "Attribute '%s' in class '%s' not found", name, self_obj->name);
-                        smm_free(name);
-                        goto block_end;
-                        break;
+                            reason = REASON_EXCEPTION;
+                            thread_create_exception_printf((t_exception_object *)Object_AttributeException, 1, "Attribute '%s' in class '%s' not found", name, self_obj->name);
+                            goto block_end;
+                            break;
+                        }
+
+                        checked = ATTRIB_IS_PUBLIC(attrib_obj) && (! ATTRIB_IS_METHOD(attrib_obj) || _check_attribute_for_static_call(self_obj, attrib_obj) == 0);
+                        _vm_attrib_cache_store(cache, self_obj, offset_obj, name_sym, attrib_obj, checked);
                     }
 
                     // Make sure we are not loading a non-static attribute from a static context
-                    if (ATTRIB_IS_METHOD(attrib_obj) && _check_attribute_for_static_call(self_obj, attrib_obj) != 0) {
+                    if (! checked && ATTRIB_IS_METHOD(attrib_obj) && _check_attribute_for_static_call(self_obj, attrib_obj) != 0) {
                         object_release(self_obj);
 
                         thread_create_exception_printf((t_exception_object *)Object_CallableException, 1, "Cannot call dynamic method '%s' from class '%s'\n", attrib_obj->data.bound_name, self_obj->name);
-                        smm_free(name);
                         reason = REASON_EXCEPTION;
                         goto block_end;
                     }
 
                     // Check visibility of attribute
-                    if (_check_attrib_visibility(self_obj, attrib_obj) != 0) {
+                    if (! checked && _check_attrib_visibility(self_obj, attrib_obj) != 0) {
                         object_release(self_obj);
 
                         thread_create_exception_printf((t_exception_object *)Object_VisibilityException, 1, "Visibility does not allow to fetch attribute '%s'\n", name);
-                        smm_free(name);
                         reason = REASON_EXCEPTION;
                         goto block_end;
                     }
@@ -867,16 +1636,22 @@ dispatch:
                     object_inc_ref((t_object *)attrib_obj);
 
                     object_release(self_obj);
-                    smm_free(name);
                 }
-                goto dispatch;
+
+                // The superinstruction continues with the call
+                if (opcode == VM_LOAD_ID_ATTRIB_CALL || opcode == VM_LOAD_FAST_ATTRIB_CALL) {
+                    opcode = VM_CALL;
+                    oparg1 = oparg3;
+                    goto execute;
+                }
+                VM_DISPATCH();
                 break;
 
             // Stores an attribute into an object
-            case VM_STORE_ATTRIB :
+            VM_CASE(VM_STORE_ATTRIB) :
                 {
                     // Name of the attribute
-                    t_object *name_obj = vm_frame_get_constant(frame, oparg1);
+                    t_symbol *name_sym = vm_frame_get_constant_symbol(frame, oparg1);
                     // Object to store attribute in
                     t_object *target_obj = vm_frame_stack_pop(frame, 1);
                     // Actual attribute
@@ -893,9 +1668,23 @@ dispatch:
                         goto block_end;
                     }
 
+                    char *name = name_sym->s;
+
+                    // Find actual attribute, through the inline cache when possible
+                    t_vm_attrib_cache *cache = _vm_attrib_cache_get(instruction);
+                    int checked = 0;
+                    t_attrib_object *attrib_obj = _vm_attrib_cache_find(cache, target_obj, target_obj, name_sym, &checked);
+                    if (attrib_obj == NULL) {
+                        attrib_obj = object_attrib_find_sym(target_obj, name_sym);
+                        if (attrib_obj) {
+                            checked = ! IS_BOOLEAN_ATTRIBUTE(name) && ATTRIB_IS_READWRITE(attrib_obj) && ATTRIB_IS_PUBLIC(attrib_obj);
+                            _vm_attrib_cache_store(cache, target_obj, target_obj, name_sym, attrib_obj, checked);
+                        }
+                    }
+
                     // Check if we want to set an boolean to a boolean-attribute (ending on a '?')
-                    if (IS_BOOLEAN_ATTRIBUTE(OBJ2STR0(name_obj)) && ! OBJECT_IS_BOOLEAN(value_obj)) {
-                        thread_create_exception_printf((t_exception_object *)Object_TypeException, 1, "Cannot set non-boolean value to property '%s'\n", OBJ2STR0(name_obj));
+                    if (! checked && IS_BOOLEAN_ATTRIBUTE(name) && ! OBJECT_IS_BOOLEAN(value_obj)) {
+                        thread_create_exception_printf((t_exception_object *)Object_TypeException, 1, "Cannot set non-boolean value to property '%s'\n", name);
 
                         object_release(target_obj);
                         object_release(value_obj);
@@ -904,12 +1693,9 @@ dispatch:
                         goto block_end;
                     }
 
-                    // Find actual attribute
-                    t_attrib_object *attrib_obj = object_attrib_find(target_obj, OBJ2STR0(name_obj));
-
                     // Read only?
-                    if (attrib_obj && ATTRIB_IS_READONLY(attrib_obj)) {
-                        thread_create_exception_printf((t_exception_object *)Object_VisibilityException, 1, "Cannot write to readonly attribute '%s'\n", OBJ2STR0(name_obj));
+                    if (! checked && attrib_obj && ATTRIB_IS_READONLY(attrib_obj)) {
+                        thread_create_exception_printf((t_exception_object *)Object_VisibilityException, 1, "Cannot write to readonly attribute '%s'\n", name);
 
                         object_release(target_obj);
                         object_release(value_obj);
@@ -919,8 +1705,8 @@ dispatch:
                     }
 
                     // Incorrect visibility
-                    if (attrib_obj && _check_attrib_visibility(target_obj, attrib_obj) != 0) {
-                        thread_create_exception_printf((t_exception_object *)Object_VisibilityException, 1, "Visibility does not allow to access attribute '%s'\n", DUP_OBJ2STR0(name_obj));
+                    if (! checked && attrib_obj && _check_attrib_visibility(target_obj, attrib_obj) != 0) {
+                        thread_create_exception_printf((t_exception_object *)Object_VisibilityException, 1, "Visibility does not allow to access attribute '%s'\n", name);
 
                         object_release(target_obj);
                         object_release(value_obj);
@@ -944,39 +1730,53 @@ dispatch:
                     } else {
                         // if the attribute does not exist yet, we just add a new attribute to the object (RW/PUBLIC)
                         // @TODO: MEDIUM: Why ATTRIB_TYPE_PROPERTY, can't it be a ATTRIB_TYPE_METHOD ??
-                        object_add_property(target_obj, OBJ2STR0(name_obj), ATTRIB_TYPE_PROPERTY | ATTRIB_ACCESS_RW | ATTRIB_VISIBILITY_PUBLIC, value_obj);
+                        object_add_property(target_obj, name, ATTRIB_TYPE_PROPERTY | ATTRIB_ACCESS_RW | ATTRIB_VISIBILITY_PUBLIC, value_obj);
                     }
 
                     object_release(value_obj);
                     object_release(target_obj);
                 }
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Load and push a constant onto the stack
-            case VM_LOAD_CONST :
+            VM_CASE(VM_LOAD_CONST) :
                 dst = vm_frame_get_constant(frame, oparg1);
                 vm_frame_stack_push(frame, dst);
                 object_inc_ref(dst);
-                goto dispatch;
+                VM_DISPATCH();
+                break;
+
+            // Superinstruction: LOAD_CONST and STORE_ID. The constant is stored directly without using the stack.
+            VM_CASE(VM_LOAD_CONST_STORE_ID) :
+                dst = vm_frame_get_constant(frame, oparg1);
+                vm_frame_set_local_identifier(frame, vm_frame_get_name(frame, oparg2), dst);
+                VM_DISPATCH();
+                break;
+
+            // Superinstruction: LOAD_CONST and STORE_FAST
+            VM_CASE(VM_LOAD_CONST_STORE_FAST) :
+                dst = vm_frame_get_constant(frame, oparg1);
+                vm_frame_set_fast_identifier(frame, oparg2, dst);
+                VM_DISPATCH();
                 break;
 
             // Store SP+0 into identifier
-            case VM_STORE_ID :
+            VM_CASE(VM_STORE_ID) :
                 dst = vm_frame_stack_pop(frame, 1);
                 char *s = vm_frame_get_name(frame, oparg1);
                 vm_frame_set_local_identifier(frame, s, dst);
 
                 object_release(dst);
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Load and push identifier onto stack
-            case VM_LOAD_ID :
+            VM_CASE(VM_LOAD_ID) :
                 {
                 char *name = vm_frame_get_name(frame, oparg1);
 
-                dst = vm_frame_find_identifier(frame, name);
+                dst = vm_frame_find_cached_identifier(frame, oparg1);
                 if (dst == NULL) {
                     reason = REASON_EXCEPTION;
                     thread_create_exception_printf((t_exception_object *)Object_AttributeException, 1, "Identifier '%s' is not found", name);
@@ -985,11 +1785,85 @@ dispatch:
 
                 vm_frame_stack_push(frame, dst);
                 object_inc_ref(dst);
-                goto dispatch;
+                VM_DISPATCH();
+                break;
+                }
+            // Store SP+0 into a local variable slot
+            VM_CASE(VM_STORE_FAST) :
+                // Local variable slots can hold tagged numericals
+                dst = vm_frame_stack_pop_tagged(frame, 1);
+                vm_frame_set_fast_identifier(frame, oparg1, dst);
+
+                object_release(dst);
+                VM_DISPATCH();
+                break;
+
+            // Load and push a local variable slot onto the stack
+            VM_CASE(VM_LOAD_FAST) :
+                dst = vm_frame_get_fast_identifier(frame, oparg1);
+                if (dst == NULL) {
+                    reason = REASON_EXCEPTION;
+                    thread_create_exception_printf((t_exception_object *)Object_AttributeException, 1, "Identifier '%s' is not found", vm_frame_get_name(frame, oparg1));
+                    goto block_end;
+                }
+
+                vm_frame_stack_push(frame, dst);
+                object_inc_ref(dst);
+                VM_DISPATCH();
                 break;
+
+            // Superinstruction: LOAD_FAST, LOAD_FAST and OPERATOR. Superinstructions are never quickened, so operators
+            // on two builtin numericals are done here directly, without boxing tagged numericals.
+            VM_CASE(VM_LOAD_FAST_FAST_OPERATOR) :
+                obj1 = frame->local_slots[oparg1];
+                obj2 = frame->local_slots[oparg2];
+                if (obj1 && obj2 && IS_NATIVE_NUMERICAL(obj1) && IS_NATIVE_NUMERICAL(obj2)) {
+                    dst = _vm_object_operator_native(obj1, oparg3, obj2);
+                    if (dst) {
+                        vm_frame_stack_push(frame, dst);
+                        object_inc_ref(dst);
+                        VM_DISPATCH();
+                        break;
+                    }
+                }
+
+                /* FALLTHROUGH */
+
+            // Superinstruction: LOAD_ID, LOAD_ID and OPERATOR
+            VM_CASE(VM_LOAD_ID_ID_OPERATOR) :
+                if (opcode == VM_LOAD_FAST_FAST_OPERATOR) {
+                    dst = vm_frame_get_fast_identifier(frame, oparg1);
+                } else {
+                    dst = vm_frame_find_cached_identifier(frame, oparg1);
                 }
+                if (dst == NULL) {
+                    reason = REASON_EXCEPTION;
+                    thread_create_exception_printf((t_exception_object *)Object_AttributeException, 1, "Identifier '%s' is not found", vm_frame_get_name(frame, oparg1));
+                    goto block_end;
+                }
+                vm_frame_stack_push(frame, dst);
+                object_inc_ref(dst);
+
+                if (opcode == VM_LOAD_FAST_FAST_OPERATOR) {
+                    dst = vm_frame_get_fast_identifier(frame, oparg2);
+                } else {
+                    dst = vm_frame_find_cached_identifier(frame, oparg2);
+                }
+                if (dst == NULL) {
+                    reason = REASON_EXCEPTION;
+                    thread_create_exception_printf((t_exception_object *)Object_AttributeException, 1, "Identifier '%s' is not found", vm_frame_get_name(frame, oparg2));
+                    goto block_end;
+                }
+                vm_frame_stack_push(frame, dst);
+                object_inc_ref(dst);
+
+                // Continue with the OPERATOR operand
+                oparg1 = oparg3;
+
+                /* FALLTHROUGH */
+
             //
-            case VM_OPERATOR :
+            VM_CASE(VM_OPERATOR) :
                 right_obj = obj2 = vm_frame_stack_pop(frame, 1);
                 left_obj = obj1 = vm_frame_stack_pop(frame, 1);
 
@@ -1019,6 +1893,12 @@ dispatch:
                 // Left object and obj2 might be the same, but might be different when coerced.
                 dst = vm_object_operator(obj1, oparg1, obj2);
 
+                // Rewrite into a type-specialized opcode once the operand types are stable
+                quickened_opcode = _vm_quicken_operator(oparg1, left_obj, right_obj);
+                if (dst && _vm_quicken_count(instruction, quickened_opcode)) {
+                    VM_REWRITE(instruction, quickened_opcode);
+                }
+
                 // Release objects
                 object_release(right_obj);
                 object_release(left_obj);
@@ -1041,17 +1921,17 @@ dispatch:
 
                 vm_frame_stack_push(frame, dst);
                 object_inc_ref(dst);
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Unconditional relative jump forward
-            case VM_JUMP_FORWARD :
+            VM_CASE(VM_JUMP_FORWARD) :
                 frame->ip += oparg1;
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Conditional jump on SP-0 is true
-            case VM_JUMP_IF_TRUE :
+            VM_CASE(VM_JUMP_IF_TRUE) :
                 dst = vm_frame_stack_fetch_top(frame, 1);
                 if (! OBJECT_IS_BOOLEAN(dst)) {
                     // Cast to boolean
@@ -1063,11 +1943,11 @@ dispatch:
                     frame->ip += oparg1;
                 }
 
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Conditional jump on SP-0 is false
-            case VM_JUMP_IF_FALSE :
+            VM_CASE(VM_JUMP_IF_FALSE) :
                 dst = vm_frame_stack_fetch_top(frame, 1);
                 if (! OBJECT_IS_BOOLEAN(dst)) {
                     // Cast to boolean
@@ -1078,10 +1958,10 @@ dispatch:
                 if (IS_BOOLEAN_FALSE(dst)) {
                     frame->ip += oparg1;
                 }
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
-            case VM_JUMP_IF_FIRST_TRUE :
+            VM_CASE(VM_JUMP_IF_FIRST_TRUE) :
                 dst = vm_frame_stack_fetch_top(frame, 1);
                 if (! OBJECT_IS_BOOLEAN(dst)) {
                     // Cast to boolean
@@ -1101,10 +1981,10 @@ dispatch:
                 // We have visited this frame, so next time we won't do the jump
                 frame->blocks[frame->block_cnt-1].visited = 1;
 
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
-            case VM_JUMP_IF_FIRST_FALSE :
+            VM_CASE(VM_JUMP_IF_FIRST_FALSE) :
                 dst = vm_frame_stack_fetch_top(frame, 1);
                 if (! OBJECT_IS_BOOLEAN(dst)) {
                     // Cast to boolean
@@ -1123,27 +2003,32 @@ dispatch:
                 // We have visited this frame, so next time we won't do the jump
                 frame->blocks[frame->block_cnt-1].visited = 1;
 
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Unconditional absolute jump
-            case VM_JUMP_ABSOLUTE :
+            VM_CASE(VM_JUMP_ABSOLUTE) :
                 frame->ip = oparg1;
-                goto dispatch;
+
+                // Jumping back in a loop is a safe point to collect reference cycles
+                if (gc_collect_pending) gc_collect();
+                VM_DISPATCH();
                 break;
 
             // Duplicates the SP+0 a number of times
-            case VM_DUP_TOPX :
+            VM_CASE(VM_DUP_TOPX) :
                 dst = vm_frame_stack_fetch_top(frame, 0);
                 for (int i=0; i!=oparg1; i++) {
                     vm_frame_stack_push(frame, dst);
                     object_inc_ref(dst);
                 }
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
-            // Calls an callable attribute from SP-0 with OP+0 args starting from SP-1
-            case VM_CALL :
+            // Calls an callable attribute from SP-0 with OP+0 args starting from SP-1. A tail call is followed by a
+            // RETURN, which is only reached when the current frame could not be released before the call.
+            VM_CASE(VM_TAIL_CALL) :
+            VM_CASE(VM_CALL) :
                 {
                     // Fetch methods to call
                     obj1 = vm_frame_stack_pop(frame, 0);
@@ -1179,45 +2064,84 @@ dispatch:
                         self = ((t_attrib_object *)obj1)->data.bound_instance;
                     }
 
-                    // Create argument list inside a DLL
-                    t_dll *arg_list = dll_init();
-
                     // Fetch varargs object (or null_object when no varargs are needed)
                     t_list_object *varargs = (t_list_object *)vm_frame_stack_pop(frame, 1);
 
-                    // Add items
-                    for (int i=0; i!=oparg1; i++) {
-                        // We pop arguments, but we add it to a dll, don't decrease refcount, but we must do so
-                        // when we finish with our dll
-                        dll_prepend(arg_list, vm_frame_stack_pop(frame, 1));
-                    }
+                    // The arguments are passed as a vector that points into our stack (unless varargs are expanded)
+                    int call_argc;
+                    t_object **allocated_argv;
+                    t_object **argv = _vm_call_args_fetch(frame, oparg1, varargs, &call_argc, &allocated_argv);
+
+                    object_release((t_object *)varargs);
+
+                    // Saffire code is executed inside this loop, instead of calling the VM recursively
+                    t_callable_object *callable_obj = (t_callable_object *)((t_attrib_object *)obj1)->data.attribute;
+                    if (OBJECT_IS_CALLABLE(callable_obj) && ! CALLABLE_IS_CODE_INTERNAL(callable_obj)) {
+                        t_attrib_object *call_attrib = (t_attrib_object *)obj1;
+                        t_vm_stackframe *scope_frame = call_attrib->frame ? call_attrib->frame : frame;
+                        t_vm_stackframe *caller_frame = frame;
+                        long depth = frame->depth + 1;
+                        long tail_calls = 0;
 
-                    if (! OBJECT_IS_NULL(varargs)) {
-                        // iterate hash (this is the correct order), and prepend values to the arg_list DLL
-                        t_hash_iter iter;
-                        ht_iter_init(&iter, varargs->data.ht);
-                        while (ht_iter_valid(&iter)) {
-                            t_object *obj = ht_iter_value(&iter);
-                            dll_append(arg_list, obj);
-                            object_inc_ref(obj);
-                            ht_iter_next(&iter);
+                        // Self could only be referenced by a frame that is released by a tail call
+                        object_inc_ref(self);
+
+                        // A tail call releases the current frame first. The callee returns directly into our caller.
+                        if (opcode == VM_TAIL_CALL && _vm_frame_can_tail_call(frame, call_attrib)) {
+                            caller_frame = frame->caller;
+                            depth = frame->depth;
+                            tail_calls = frame->tail_calls + 1;
+
+                            // The arguments cannot stay on the stack of the frame we release
+                            if (! allocated_argv) {
+                                allocated_argv = argv = _vm_call_args_detach(frame, argv, call_argc);
+                            }
+
+                            // Release whatever is left on the stack, like the iterators of loops
+                            while (frame->sp < frame->codeblock->bytecode->stack_size) {
+                                object_release(vm_frame_stack_pop_tagged(frame, 0));
+                            }
+                            _vm_frame_destroy_call(frame);
+
+                            frame = caller_frame;
+                            thread_set_current_frame(frame);
+#ifdef VM_COMPUTED_GOTO
+                            instructions = frame->codeblock->instructions;
+#endif
                         }
+
+                        t_vm_stackframe *child_frame = _vm_frame_create_call(self, scope_frame, call_attrib->data.bound_name, callable_obj, argv, call_argc, depth);
+
+                        object_release(self);
+
+                        if (! child_frame) {
+                            object_release(obj1);
+                            _vm_call_args_release(frame, allocated_argv, call_argc);
+
+                            reason = REASON_EXCEPTION;
+                            goto block_end;
+                            break;
+                        }
+
+                        // The attribute and the arguments are released when the child frame returns
+                        child_frame->call_attrib = obj1;
+                        child_frame->call_argv = allocated_argv;
+                        child_frame->call_argc = call_argc;
+                        child_frame->caller = caller_frame;
+                        child_frame->tail_calls = tail_calls;
+
+                        frame = child_frame;
+                        ret = NULL;
+                        goto enter_frame;
                     }
 
-                    t_object *ret_obj = _object_call_attrib_with_args(self, (t_attrib_object *)obj1, arg_list);
+                    t_object *ret_obj = _object_call_attrib_with_args(self, (t_attrib_object *)obj1, argv, call_argc);
 
                     // Release (duplicated) attribute
                     object_release(obj1);
 
                     // Decrefs our arguments here
-                    t_dll_element *e = DLL_HEAD(arg_list);
-                    while (e) {
-                        object_release(DLL_DATA_PTR(e));
-                        e = DLL_NEXT(e);
-                    }
-                    dll_free(arg_list);
-
-                    object_release((t_object *)varargs);
+                    _vm_call_args_release(frame, allocated_argv, call_argc);
 
                     if (ret_obj == NULL) {
                         // NULL returned means exception occurred.
@@ -1233,11 +2157,11 @@ dispatch:
                     object_release(ret_obj);
                 }
 
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Import X as Y
-            case VM_IMPORT :
+            VM_CASE(VM_IMPORT) :
                 {
                     // Fetch alias
                     t_object *alias_obj = vm_frame_stack_pop(frame, 1);
@@ -1256,48 +2180,50 @@ dispatch:
                     smm_free(fqcn_module);
                     smm_free(fqcn_alias);
                 }
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Sets up loop block
-            case VM_SETUP_LOOP :
+            VM_CASE(VM_SETUP_LOOP) :
                 vm_push_block_loop(frame, BLOCK_TYPE_LOOP, frame->sp, frame->ip + oparg1, 0);
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Sets up loop block with else clause
-            case VM_SETUP_ELSE_LOOP :
+            VM_CASE(VM_SETUP_ELSE_LOOP) :
                 vm_push_block_loop(frame, BLOCK_TYPE_LOOP, frame->sp, frame->ip + oparg1, frame->ip + oparg2);
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Pops the most inner loop-block
-            case VM_POP_BLOCK :
+            VM_CASE(VM_POP_BLOCK) :
                 vm_pop_block(frame);
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Continue the most inner loop-block
-            case VM_CONTINUE_LOOP :
+            VM_CASE(VM_CONTINUE_LOOP) :
                 ret = object_alloc_instance(Object_Numerical, 1, oparg1);
                 reason = REASON_CONTINUE;
                 goto block_end;
                 break;
 
             // Breaks out a loop-block
-            case VM_BREAK_LOOP :
+            VM_CASE(VM_BREAK_LOOP) :
                 reason = REASON_BREAK;
                 goto block_end;
                 break;
 
             // Breaks out a loop-block, and continue with the else clause
-            case VM_BREAKELSE_LOOP :
+            VM_CASE(VM_BREAKELSE_LOOP) :
                 reason = REASON_BREAKELSE;
                 goto block_end;
                 break;
 
-            // Compare 2 objects and push a boolean(true) or boolean(false) object back onto the stack
-            case VM_COMPARE_OP :
+            // Compare 2 objects and push a boolean(true) or boolean(false) object back onto the stack. The
+            // COMPARE_JUMP_FALSE superinstruction continues with a JUMP_IF_FALSE afterwards.
+            VM_CASE(VM_COMPARE_JUMP_FALSE) :
+            VM_CASE(VM_COMPARE_OP) :
                 left_obj = obj1 = vm_frame_stack_pop(frame, 1);
                 right_obj = obj2 = vm_frame_stack_pop(frame, 1);
 
@@ -1345,7 +2271,7 @@ dispatch:
 
                     vm_frame_stack_push(frame, ret_obj);
                     object_inc_ref(ret_obj);
-                    goto dispatch;
+                    goto compare_done;
                 }
 
 
@@ -1363,8 +2289,7 @@ dispatch:
                     object_release(right_obj);
                     object_release(left_obj);
 
-                    goto dispatch;
-                    break;
+                    goto compare_done;
                 }
 
                 DEBUG_PRINT_CHAR("Compare '%s (%d)' against '%s (%d)'\n", left_obj->name, left_obj->type, right_obj->name, right_obj->type);
@@ -1414,6 +2339,12 @@ dispatch:
 
                 dst = vm_object_comparison(obj1, oparg1, obj2);
 
+                // Rewrite into a type-specialized opcode once the operand types are stable
+                quickened_opcode = _vm_quicken_comparison(oparg1, left_obj, right_obj);
+                if (dst && _vm_quicken_count(instruction, quickened_opcode)) {
+                    VM_REWRITE(instruction, quickened_opcode);
+                }
+
                 // Release objects
                 object_release(right_obj);
                 object_release(left_obj);
@@ -1435,11 +2366,19 @@ dispatch:
 
                 vm_frame_stack_push(frame, dst);
                 object_inc_ref(dst);
-                goto dispatch;
+
+compare_done:
+                // The superinstruction continues with the conditional jump
+                if (opcode == VM_COMPARE_JUMP_FALSE) {
+                    opcode = VM_JUMP_IF_FALSE;
+                    oparg1 = oparg2;
+                    goto execute;
+                }
+                VM_DISPATCH();
                 break;
 
             // Build an attribute object from the values of the stack, and push attribute object back onto the stack
-            case VM_BUILD_ATTRIB :
+            VM_CASE(VM_BUILD_ATTRIB) :
                 {
                     // pop access object
                     t_object *access = vm_frame_stack_pop(frame, 1);
@@ -1470,6 +2409,9 @@ dispatch:
 
                             arg->typehint = (t_string_object *)vm_frame_stack_pop(frame, 1);
 
+                            // Find the slot in the method frame where this argument will be stored
+                            arg->slot = vm_codeblock_get_slot(((t_callable_object *)value_obj)->data.code.external.codeblock, s);
+
                             ht_add_str(arg_list, s, arg);
                             smm_free(s);
                         }
@@ -1505,12 +2447,12 @@ dispatch:
                     object_release(visibility);
                     object_release(value_obj);
                 }
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Build interface or class from the values on the stack and push the object back onto the stack
-            case VM_BUILD_INTERFACE :
-            case VM_BUILD_CLASS :
+            VM_CASE(VM_BUILD_INTERFACE) :
+            VM_CASE(VM_BUILD_CLASS) :
                 {
                     // pop class flags
                     // @TODO: Do we need to mask certain flags, as they should not be set directly through opcodes?
@@ -1593,22 +2535,19 @@ dispatch:
                     object_release(name_obj);
 
                     // Fetch all attributes
-                    t_hash_table *attributes = ht_create();
+                    t_hash_table *attributes = ht_create_lookup();
                     for (int i=0; i!=oparg1; i++) {
                         t_object *attr_name = vm_frame_stack_pop(frame, 1);
                         t_attrib_object *attrib_obj = (t_attrib_object *)vm_frame_stack_pop(frame, 0);
 
                         // Add method attribute to class
-                        s = DUP_OBJ2STR0(attr_name);
+                        ht_add_sym(attributes, symbol_intern(OBJ2STR0(attr_name), OBJ2STR(attr_name)->len), attrib_obj);
                         object_release(attr_name);
-                        ht_add_str(attributes, s, attrib_obj);
 
                         // Increase because we are using it inside our hash table
                         object_inc_ref((t_object *)attrib_obj);
                         // Decrease because we have popped it from the stack
                         object_release((t_object *)attrib_obj);
-
-                        smm_free(s);
                     }
 
                     // Actually create the object
@@ -1628,10 +2567,10 @@ dispatch:
                     smm_free(name);
                 }
 
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
-            case VM_STORE_FRAME_ID :
+            VM_CASE(VM_STORE_FRAME_ID) :
                 // @TODO: Why is this different from VM_STORE_ID (except fqcn)
 
                 // Store SP-0 as name[oparg1] in the current frame
@@ -1646,12 +2585,12 @@ dispatch:
 
                 object_release(obj1);
 
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
 
             // Return / end the current frame
-            case VM_RETURN :
+            VM_CASE(VM_RETURN) :
                 // Pop "ret" object from the stack
                 ret = vm_frame_stack_pop(frame, 1);
 
@@ -1678,18 +2617,18 @@ dispatch:
                 break;
 
             // Setup an exception try/catch block
-            case VM_SETUP_EXCEPT :
+            VM_CASE(VM_SETUP_EXCEPT) :
                 vm_push_block_exception(frame, BLOCK_TYPE_EXCEPTION, frame->sp, frame->ip + oparg1, frame->ip + oparg2, frame->ip + oparg3);
 
                 obj1 = object_alloc_instance(Object_Numerical, 1, REASON_FINALLY);
                 vm_frame_stack_push(frame, obj1);
                 object_inc_ref(obj1);
 
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Setup an exception try/catch block with finally clause
-            case VM_END_FINALLY :
+            VM_CASE(VM_END_FINALLY) :
                 // Pop "return" object
                 ret = vm_frame_stack_pop(frame, 1);
 
@@ -1719,7 +2658,7 @@ dispatch:
                 break;
 
             // Throw an exception
-            case VM_THROW :
+            VM_CASE(VM_THROW) :
                 {
                     // Fetch exception object
                     t_object *obj = (t_object *)vm_frame_stack_pop(frame, 1);
@@ -1745,28 +2684,29 @@ dispatch:
                 break;
 
             // Pack a tuple object with values from the stack
-            case VM_PACK_TUPLE :
+            VM_CASE(VM_PACK_TUPLE) :
                 {
                     // Create an empty tuple
                     t_tuple_object *tuple_obj = (t_tuple_object *)object_alloc_instance(Object_Tuple, 0);
 
-                    // Add elements from the stack into the tuple, sort in reverse order!
+                    // Add elements from the stack into the tuple, sort in reverse order! The tuple takes over the
+                    // references from the stack.
+                    object_tuple_reserve(tuple_obj, oparg1);
                     for (int i=0; i!=oparg1; i++) {
-                        t_object *val = vm_frame_stack_pop(frame, 1);
-
-                        ht_add_num(tuple_obj->data.ht, oparg1 - i - 1, val);
+                        tuple_obj->data.elements[oparg1 - i - 1] = vm_frame_stack_pop(frame, 1);
                     }
+                    tuple_obj->data.length = oparg1;
 
                     // Push tuple on the stack
                     vm_frame_stack_push(frame, (t_object *)tuple_obj);
                     object_inc_ref((t_object *)tuple_obj);
                 }
 
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Unpack a tuple object
-            case VM_UNPACK_TUPLE :
+            VM_CASE(VM_UNPACK_TUPLE) :
                 {
                     // Check if we are are unpacking a tuple
                     t_tuple_object *tuple_obj = (t_tuple_object *)vm_frame_stack_pop(frame, 1);
@@ -1783,15 +2723,15 @@ dispatch:
                     } else {
 
                         // Push the tuple vars. Make sure we start from the correct position
-                        int offset = oparg1 < tuple_obj->data.ht->element_count ? oparg1 : tuple_obj->data.ht->element_count;
+                        int offset = oparg1 < tuple_obj->data.length ? oparg1 : tuple_obj->data.length;
                         for (int i=0; i < offset; i++) {
-                            t_object *val = ht_find_num(tuple_obj->data.ht, i);
+                            t_object *val = tuple_obj->data.elements[i];
                             vm_frame_stack_push(frame, val);
                             object_inc_ref(val);
                         }
 
                         // If we haven't got enough elements in our tuple, pad the result with NULLs first
-                        while (oparg1-- > tuple_obj->data.ht->element_count) {
+                        while (oparg1-- > tuple_obj->data.length) {
                             vm_frame_stack_push(frame, Object_Null);
                             object_inc_ref(Object_Null);
                         }
@@ -1800,14 +2740,33 @@ dispatch:
                     }
                 }
 
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Reset an iteration
-            case VM_ITER_RESET :
+            VM_CASE(VM_ITER_RESET) :
                 {
                     obj1 = vm_frame_stack_pop(frame, 1);
 
+                    // Get the current block, and store iter data in it
+                    t_vm_frameblock *block = vm_peek_block(frame);
+                    if (block == NULL) {
+                        fatal_error(1, "Trying to initialize an iteration block, but block stack is empty.");
+                    }
+                    block->iter.available = 1;
+                    block->iter.index = -1;
+
+                    // Builtin objects are their own iterator, and are iterated without calling their methods
+                    block->iter.native = _vm_iter_native_type(obj1);
+                    if (block->iter.native != ITER_NATIVE_NONE) {
+                        _vm_iter_reset_native(block, obj1);
+
+                        // Our reference moves to the stack
+                        vm_frame_stack_push(frame, obj1);
+                        VM_DISPATCH();
+                        break;
+                    }
+
                     // check if we have the iterator interface implemented
                     if (! object_has_interface(obj1, "iterator")) {
                         object_release(obj1);
@@ -1838,45 +2797,41 @@ dispatch:
                         goto block_end;
                     }
 
-
-                    // Get the current block, and store iter data in it
-                    t_vm_frameblock *block = vm_peek_block(frame);
-                    if (block == NULL) {
-                        fatal_error(1, "Trying to initialize an iteration block, but block stack is empty.");
-                    }
-                    block->iter.available = 1;
                     block->iter.count = OBJ2NUM(obj1);
-                    block->iter.index = -1;
                 }
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Fetch iteration values (key, val, meta)
-            case VM_ITER_FETCH :
+            VM_CASE(VM_ITER_FETCH) :
                 {
                     obj1 = vm_frame_stack_pop(frame, 1);
 
+                    // Find the current iteration block (doesn't have to be the current block, as we might be
+                    // inside a while-loop within the foreach.
+                    t_vm_frameblock *block = vm_find_iter_block(frame);
+
                     // If we need 3 values, create and push metadata
                     if (oparg1 == 3) {
+                        t_object *meta_obj = _vm_iter_meta(block);
+                        vm_frame_stack_push(frame, meta_obj);
+                        object_inc_ref(meta_obj);
+                    }
 
-                        // Find the current iteration block (doesn't have to be the current block, as we might be
-                        // inside a while-loop within the foreach.
-                        t_vm_frameblock *block = vm_find_iter_block(frame);
-
-                        // Increase iteration count
-                        block->iter.index++;
+                    if (block->iter.native != ITER_NATIVE_NONE) {
+                        _vm_iter_fetch_native(frame, block, obj1, oparg1);
 
-                        // Create meta data object with correct values
-                        t_object *meta_obj = (t_object *)object_alloc_instance(Object_Meta, 0);
-                        object_add_constant(meta_obj, "first", ATTRIB_TYPE_CONSTANT | ATTRIB_ACCESS_RO | ATTRIB_VISIBILITY_PUBLIC, block->iter.index == 0 ? Object_True : Object_False);
-                        object_add_constant(meta_obj, "last", ATTRIB_TYPE_CONSTANT | ATTRIB_ACCESS_RO | ATTRIB_VISIBILITY_PUBLIC, (block->iter.count > 0 && block->iter.index == block->iter.count - 1) ? Object_True : Object_False);
-                        object_add_constant(meta_obj, "count", ATTRIB_TYPE_CONSTANT | ATTRIB_ACCESS_RO | ATTRIB_VISIBILITY_PUBLIC, NUM2OBJ(block->iter.count));
-                        object_add_constant(meta_obj, "index", ATTRIB_TYPE_CONSTANT | ATTRIB_ACCESS_RO | ATTRIB_VISIBILITY_PUBLIC, NUM2OBJ(block->iter.index));
-                        // Set meta_obj as immutable
+                        // Rewrite into a list-specialized opcode once we keep iterating builtin lists
+                        quickened_opcode = block->iter.native == ITER_NATIVE_LIST ? VM_ITER_FETCH_LIST : 0;
+                        if (_vm_quicken_count(instruction, quickened_opcode)) {
+                            VM_REWRITE(instruction, quickened_opcode);
+                        }
 
-                        vm_frame_stack_push(frame, meta_obj);
-                        object_inc_ref(meta_obj);
+                        object_release(obj1);
+                        VM_DISPATCH();
+                        break;
                     }
+
                     // Always push value
                     attr_obj = object_attrib_find(obj1, "__value");
                     obj3 = call_saffire_method(obj1, attr_obj, 0);
@@ -1902,14 +2857,110 @@ dispatch:
                         obj3 = call_saffire_method(obj1, attr_obj, 0);
                     }
 
+                    _vm_quicken_count(instruction, 0);
+
                     object_release(obj1);
                 }
-                goto dispatch;
+                VM_DISPATCH();
+                break;
+
+            // Quickened ITER_FETCH on a builtin list. Reads the list through the cursor in the iteration block.
+            VM_CASE(VM_ITER_FETCH_LIST) :
+                {
+                    obj1 = vm_frame_stack_fetch_top(frame, 1);
+                    t_vm_frameblock *block = vm_find_iter_block(frame);
+                    if (! IS_NATIVE_LIST(obj1) || block->iter.native != ITER_NATIVE_LIST) {
+                        VM_DEOPTIMIZE();
+                    }
+                    vm_frame_stack_pop(frame, 1);
+
+                    // If we need 3 values, create and push metadata
+                    if (oparg1 == 3) {
+                        t_object *meta_obj = _vm_iter_meta(block);
+                        vm_frame_stack_push(frame, meta_obj);
+                        object_inc_ref(meta_obj);
+                    }
+
+                    _vm_iter_fetch_native(frame, block, obj1, oparg1);
+
+                    object_release(obj1);
+                }
+                VM_DISPATCH();
+                break;
+
+            // Quickened OPERATOR on two builtin numericals. The right operand is on top of the stack.
+            VM_CASE(VM_ADD_NUM_NUM) :
+                if (! _vm_fetch_num_num(frame, &right_obj, &left_obj)) {
+                    VM_DEOPTIMIZE();
+                }
+                dst = _vm_numerical(OBJ2NUM(left_obj) + OBJ2NUM(right_obj));
+                goto quickened_num_num;
+
+            VM_CASE(VM_SUB_NUM_NUM) :
+                if (! _vm_fetch_num_num(frame, &right_obj, &left_obj)) {
+                    VM_DEOPTIMIZE();
+                }
+                dst = _vm_numerical(OBJ2NUM(left_obj) - OBJ2NUM(right_obj));
+                goto quickened_num_num;
+
+            // Quickened COMPARE_OP on two builtin numericals. The left operand is on top of the stack.
+            VM_CASE(VM_EQ_NUM_NUM) :
+                if (! _vm_fetch_num_num(frame, &left_obj, &right_obj)) {
+                    VM_DEOPTIMIZE();
+                }
+                dst = NATIVE_BOOLEAN(OBJ2NUM(left_obj) == OBJ2NUM(right_obj));
+                goto quickened_num_num;
+
+            VM_CASE(VM_NE_NUM_NUM) :
+                if (! _vm_fetch_num_num(frame, &left_obj, &right_obj)) {
+                    VM_DEOPTIMIZE();
+                }
+                dst = NATIVE_BOOLEAN(OBJ2NUM(left_obj) != OBJ2NUM(right_obj));
+                goto quickened_num_num;
+
+            VM_CASE(VM_LT_NUM_NUM) :
+                if (! _vm_fetch_num_num(frame, &left_obj, &right_obj)) {
+                    VM_DEOPTIMIZE();
+                }
+                dst = NATIVE_BOOLEAN(OBJ2NUM(left_obj) < OBJ2NUM(right_obj));
+                goto quickened_num_num;
+
+            VM_CASE(VM_GT_NUM_NUM) :
+                if (! _vm_fetch_num_num(frame, &left_obj, &right_obj)) {
+                    VM_DEOPTIMIZE();
+                }
+                dst = NATIVE_BOOLEAN(OBJ2NUM(left_obj) > OBJ2NUM(right_obj));
+                goto quickened_num_num;
+
+            VM_CASE(VM_LE_NUM_NUM) :
+                if (! _vm_fetch_num_num(frame, &left_obj, &right_obj)) {
+                    VM_DEOPTIMIZE();
+                }
+                dst = NATIVE_BOOLEAN(OBJ2NUM(left_obj) <= OBJ2NUM(right_obj));
+                goto quickened_num_num;
+
+            VM_CASE(VM_GE_NUM_NUM) :
+                if (! _vm_fetch_num_num(frame, &left_obj, &right_obj)) {
+                    VM_DEOPTIMIZE();
+                }
+                dst = NATIVE_BOOLEAN(OBJ2NUM(left_obj) >= OBJ2NUM(right_obj));
+                goto quickened_num_num;
+
+quickened_num_num:
+                // Operands are only popped once the guard has passed. They can be tagged, so they are not boxed.
+                vm_frame_stack_pop_tagged(frame, 1);
+                vm_frame_stack_pop_tagged(frame, 1);
+                object_release(right_obj);
+                object_release(left_obj);
+
+                vm_frame_stack_push(frame, dst);
+                object_inc_ref(dst);
+                VM_DISPATCH();
                 break;
 
 
             // Build a datastructure from the values on the stack and place the datastructure object back onto the stack
-            case VM_BUILD_DATASTRUCT   :
+            VM_CASE(VM_BUILD_DATASTRUCT) :
                 {
                     // Fetch methods to call
                     t_object *obj = (t_object *)vm_frame_stack_pop(frame, 1);
@@ -1942,19 +2993,48 @@ dispatch:
                     // Create new object, because we know it's a data-structure, just add them to the list
                     t_object *ret_obj = (t_object *)object_alloc_instance(obj, 2, NULL, dll);  // arg 1 is hashtable, arg2 is dll
 
+                    // The data structure holds its own references to the elements
+                    t_dll_element *e = DLL_HEAD(dll);
+                    while (e) {
+                        object_release(DLL_DATA_PTR(e));
+                        e = DLL_NEXT(e);
+                    }
+                    dll_free(dll);
+
                     vm_frame_stack_push(frame, ret_obj);
                     object_inc_ref(ret_obj);
 
                     object_release(obj);
                 }
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Load a subscription [] value out of a datastructure onto the stack
-            case VM_LOAD_SUBSCRIPT :
+            VM_CASE(VM_LOAD_SUBSCRIPT) :
                 {
                     // Fetch actual data structure
                     obj1 = vm_frame_stack_pop(frame, 1);
+
+                    // Builtin lists and tuples are indexed directly, without calling __get()
+                    if (oparg1 == 1 && (IS_NATIVE_LIST(obj1) || IS_NATIVE_TUPLE(obj1)) && IS_NATIVE_NUMERICAL(vm_frame_stack_fetch_tagged(frame, 0, 1))) {
+                        obj2 = vm_frame_stack_pop_tagged(frame, 1);
+                        obj3 = _vm_subscript_get_native(obj1, OBJ2NUM(obj2));
+                        if (obj3) {
+                            vm_frame_stack_push(frame, obj3);
+                            object_inc_ref(obj3);
+                        }
+
+                        object_release(obj2);
+                        object_release(obj1);
+
+                        if (! obj3) {
+                            reason = REASON_EXCEPTION;
+                            goto block_end;
+                        }
+                        VM_DISPATCH();
+                        break;
+                    }
+
                     if (! object_has_interface(obj1, "subscription")) {
                         object_release(obj1);
 
@@ -2016,12 +3096,36 @@ dispatch:
                     vm_frame_stack_push(frame, ret_obj);
                     object_inc_ref(ret_obj);
                 }
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
             // Store a value into a datastructure
-            case VM_STORE_SUBSCRIPT :
+            VM_CASE(VM_STORE_SUBSCRIPT) :
                 obj1 = vm_frame_stack_pop(frame, 1);       // subscription
+
+                // Builtin lists are stored into directly, without calling __set()
+                if (IS_NATIVE_LIST(obj1) && IS_NATIVE_NUMERICAL(vm_frame_stack_fetch_tagged(frame, 0, 1))) {
+                    obj2 = vm_frame_stack_pop_tagged(frame, 1);       // key
+                    obj3 = vm_frame_stack_pop(frame, 1);              // val
+
+                    int stored = object_list_set((t_list_object *)obj1, OBJ2NUM(obj2), obj3);
+                    if (stored == 0) {
+                        vm_frame_stack_push(frame, obj1);
+                        object_inc_ref(obj1);
+                    }
+
+                    object_release(obj3);
+                    object_release(obj2);
+                    object_release(obj1);
+
+                    if (stored != 0) {
+                        reason = REASON_EXCEPTION;
+                        goto block_end;
+                    }
+                    VM_DISPATCH();
+                    break;
+                }
+
                 obj2 = vm_frame_stack_pop(frame, 1);       // key
                 obj3 = vm_frame_stack_pop(frame, 1);       // val
 
@@ -2037,11 +3141,14 @@ dispatch:
                 object_release(obj2);
                 object_release(obj1);
 
-                goto dispatch;
+                VM_DISPATCH();
                 break;
 
 
             default:
+#ifdef VM_COMPUTED_GOTO
+            vm_target_unknown:
+#endif
                 fatal_error(1, "unknown opcode encountered: %0X\n", opcode);
                 break;
 
@@ -2069,6 +3176,34 @@ block_end:
     } // for (;;)
 
 
+    // Frames that are called from inside the loop return into their caller, which continues in the same loop
+    if (frame->caller) {
+        t_vm_stackframe *child_frame = frame;
+        frame = frame->caller;
+
+        _vm_frame_destroy_call(child_frame);
+
+        thread_set_current_frame(frame);
+#ifdef VM_COMPUTED_GOTO
+        instructions = frame->codeblock->instructions;
+#endif
+
+        if (ret == NULL || reason == REASON_EXCEPTION || reason == REASON_RERAISE) {
+            // NULL returned means exception occurred.
+            reason = REASON_EXCEPTION;
+            ret = NULL;
+            goto block_end;
+        }
+
+        // The reference to the returned object moves onto the stack of the caller
+        vm_frame_stack_push(frame, ret);
+
+        ret = NULL;
+        reason = REASON_NONE;
+        goto dispatch;
+    }
+
+
     // Restore current frame
     thread_set_current_frame(parent_frame);
 
@@ -2158,7 +3293,7 @@ t_vm_frameblock *unwind_blocks(t_vm_stackframe *frame, long *reason, t_object *r
             // Clean up any remaining items on the variable stack, but keep the last "REASON_FINALLY"
             while (frame->sp < block->sp - 1) {
                 DEBUG_PRINT_CHAR("Current SP: %d -> Needed SP: %d\n", frame->sp, block->sp);
-                t_object *obj = vm_frame_stack_pop(frame, 1);
+                t_object *obj = vm_frame_stack_pop_tagged(frame, 1);
                 object_release(obj);
             }
 
@@ -2185,7 +3320,7 @@ t_vm_frameblock *unwind_blocks(t_vm_stackframe *frame, long *reason, t_object *r
 
         // Unwind the variable stack. This will remove all variables used in the current (unwound) block.
         while (frame->sp < block->sp) {
-            t_object *obj = vm_frame_stack_pop(frame, 1);
+            t_object *obj = vm_frame_stack_pop_tagged(frame, 1);
             object_release(obj);
         }
 
@@ -2248,8 +3383,8 @@ t_vm_stackframe *vm_execute_import(t_vm_codeblock *codeblock, t_object **result)
     t_vm_stackframe *import_frame = vm_stackframe_new(NULL, codeblock);
 //    import_frame->trace_class = string_strdup0(current_frame->trace_class);
 //    import_frame->trace_method = string_strdup0("#import");
-    import_frame->trace_class = string_strdup0("##");
-    import_frame->trace_method = string_strdup0("#import");
+    import_frame->trace_class = "##";
+    import_frame->trace_method = "#import";
 
     if (result) {
         *result = _vm_execute(import_frame);
@@ -2359,7 +3494,7 @@ int vm_execute(t_vm_stackframe *frame) {
  */
 void vm_populate_builtins(const char *name, t_object *obj) {
     object_inc_ref(obj);
-    ht_add_str(builtin_identifiers_ht, (char *)name, (void *)obj);
+    ht_add_sym(builtin_identifiers_ht, symbol_intern0(name), (void *)obj);
 }
 
 /**
@@ -2369,27 +3504,19 @@ void vm_populate_builtins(const char *name, t_object *obj) {
 t_object *call_saffire_method(t_object *self, t_attrib_object *attrib_obj, int arg_count, ...) {
     if (! self || ! attrib_obj) return NULL;
 
-    t_dll *arg_list = NULL;
+    // Create the argument vector on the C stack
+    t_object *argv[arg_count > 0 ? arg_count : 1];
 
-    if (arg_count > 0) {
-        // Create DLL with all arguments
-        va_list args;
-        va_start(args, arg_count);
-        arg_list = dll_init();
-        for (int i=0; i!=arg_count; i++) {
-            dll_append(arg_list, va_arg(args, t_object *));
-        }
-        va_end(args);
+    va_list args;
+    va_start(args, arg_count);
+    for (int i=0; i!=arg_count; i++) {
+        argv[i] = va_arg(args, t_object *);
     }
+    va_end(args);
 
-    t_object *ret_obj = _object_call_attrib_with_args(self, attrib_obj, arg_list);
+    t_object *ret_obj = _object_call_attrib_with_args(self, attrib_obj, argv, arg_count);
 
     // @TODO: HIGH: should we check for exception. and if not found, throw a generic one?
 
-    // Free dll
-    if (arg_list) {
-        dll_free(arg_list);
-    }
-
     return ret_obj;
 }
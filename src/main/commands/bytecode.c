@@ -39,6 +39,8 @@
 #include <saffire/general/output.h>
 #include <saffire/vm/vm.h>
 #include <saffire/vm/stackframe.h>
+#include <saffire/vm/codeblock.h>
+#include <saffire/vm/context.h>
 #include <saffire/commands/command.h>
 #include <saffire/memory/smm.h>
 #include <saffire/general/parse_options.h>
@@ -60,6 +62,7 @@ int write_dot = 0;                  // 1 = write DOT file
 int write_sfa = 0;                  // 1 = write saffire assembly file
 char *forced_gpg_key = NULL;        // When set, overrides the configuration gpg key
 int flag_sign = 0;                  // 0 = default config setting, 1 = force sign, 2 = force unsigned
+int flag_run = 0;                   // 1 = execute the code before disassembling
 
 /**
  * Compiles single file
@@ -92,12 +95,6 @@ static int _compile_file(const char *source_file, int sign, char *gpg_key) {
         goto cleanup;
     }
 
-    // Write assembly output file if needed
-    if (write_sfa) {
-        char *sfa_dest_file = replace_extension(source_file, ".sf", ".sfa");
-        assembler_output(asm_code, sfa_dest_file);
-    }
-
     // Convert the assembler lines to bytecode
     t_bytecode *bc = assembler(asm_code, source_file);
     if (! bc) {
@@ -105,6 +102,12 @@ static int _compile_file(const char *source_file, int sign, char *gpg_key) {
         goto cleanup;
     }
 
+    // Write assembly output file if needed. This is done after assembling, so it shows the superinstructions.
+    if (write_sfa) {
+        char *sfa_dest_file = replace_extension(source_file, ".sf", ".sfa");
+        assembler_output(asm_code, sfa_dest_file);
+    }
+
     // Save bytecode structure to disk
     sfc_dest_file = replace_extension(source_file, ".sf", ".sfc");
     output_char("Compiling %s into %s%s\n", source_file, sign ? "signed " : "", sfc_dest_file);
@@ -279,6 +282,57 @@ static int do_info(void) {
     return 0;
 }
 
+/**
+ * Disassembles a saffire script or bytecode file. When the code is executed first, the instructions are shown as they
+ * are quickened by the VM.
+ */
+static int do_disasm(void) {
+    char *source_path = saffire_getopt_string(0);
+    t_bytecode *bc;
+
+    struct stat st;
+    if (stat(source_path, &st) != 0 || ! S_ISREG(st.st_mode)) {
+        warning("Cannot disassemble: file not found\n");
+        return 1;
+    }
+
+    char full_source_path[PATH_MAX+1];
+    realpath(source_path, full_source_path);
+
+    if (bytecode_is_valid_file(full_source_path)) {
+        bc = bytecode_load(full_source_path, 0);
+    } else {
+        bc = bytecode_generate_diskfile(full_source_path, NULL, NULL);
+    }
+    if (! bc) {
+        error("Cannot load bytecode\n");
+        return 1;
+    }
+
+    vm_init(VM_RUNMODE_CLI);
+
+    t_vm_context *ctx = vm_context_new("\\", full_source_path);
+    t_vm_codeblock *codeblock = vm_codeblock_new(bc, ctx);
+
+    if (flag_run) {
+        t_vm_stackframe *initial_frame = vm_stackframe_new(NULL, codeblock);
+        initial_frame->trace_class = "";
+        initial_frame->trace_method = "";
+
+        vm_execute(initial_frame);
+
+        vm_stackframe_destroy(initial_frame);
+    }
+
+    vm_codeblock_disassemble(codeblock);
+
+    bytecode_free(codeblock->bytecode);
+    vm_codeblock_destroy(codeblock);
+    vm_fini();
+
+    return 0;
+}
+
 /**
  *
  */
@@ -327,10 +381,14 @@ static const char help[] = "Compiles a Saffire script or scripts without running
     "       --sign           Sign the bytecode\n"
     "       --no-sign        Don't sign the bytecode\n"
     "       --key <key>      Use this key for signing the code\n"
+    "       --no-fuse        Don't fuse opcode sequences into superinstructions\n"
     "   sign                 Sign bytecode file or directory\n"
     "       --key <key>      Use this key for signing the code\n"
     "   unsign               Remove signature from bytecode file or directory\n"
     "   info                 Display information on bytecode file\n"
+    "   disasm               Display the decoded instructions of a saffire script or bytecode file\n"
+    "       --run            Execute the code first, and display the instructions as quickened by the VM\n"
+    "       --no-fuse        Don't fuse opcode sequences into superinstructions\n"
     "\n"
     "If the --[no-]sign option isn't given, the bytecode is signed according to the configuration settings.\n"
     "\n";
@@ -341,6 +399,12 @@ static void opt_text(void *data) {
 static void opt_dot(void *data) {
     write_dot = 1;
 }
+static void opt_run(void *data) {
+    flag_run = 1;
+}
+static void opt_no_fuse(void *data) {
+    asm_superinstructions = 0;
+}
 
 
 static void opt_key(void *data) {
@@ -368,6 +432,7 @@ static struct saffire_option compile_options[] = {
     { "key", "", required_argument, opt_key},
     { "text", "", no_argument, opt_text},
     { "dot", "", no_argument, opt_dot},
+    { "no-fuse", "", no_argument, opt_no_fuse},
     { 0, 0, 0, 0}
 };
 
@@ -376,12 +441,19 @@ static struct saffire_option sign_options[] = {
     { 0, 0, 0, 0}
 };
 
+static struct saffire_option disasm_options[] = {
+    { "run", "", no_argument, opt_run},
+    { "no-fuse", "", no_argument, opt_no_fuse},
+    { 0, 0, 0, 0}
+};
+
 /* Config actions */
 static struct command_action command_actions[] = {
     { "compile", "s", do_compile, compile_options},
     { "sign", "s", do_sign, sign_options},
     { "unsign", "s", do_unsign, NULL},
     { "info", "s", do_info, NULL},
+    { "disasm", "s", do_disasm, disasm_options},
     { 0, 0, 0, 0}
 };
 
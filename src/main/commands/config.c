@@ -58,6 +58,11 @@ static const char *default_ini[] = {
     "sign = true",
     "",
     "",
+    "[vm]",
+    "# Maximum number of nested calls before a callException is thrown",
+    "max_depth = 100000",
+    "",
+    "",
     "[fastcgi]",
     "pid.path = /var/run/saffire.pid",
     "",
@@ -121,6 +126,17 @@ static const char *default_ini[] = {
     "# Display the saffire logo upon start of the repl",
     "logo = false",
     "",
+    "[gc]",
+    "# Number of freed objects per type that are kept for reuse",
+    "queue.size = 100",
+    "# The size can be set for each type separately as well",
+    "#queue.size.string = 1000",
+    "",
+    "# Reference cycles are collected after this many allocations",
+    "threshold.allocations = 10000",
+    "# or when this many containers might be part of a cycle",
+    "threshold.roots = 10000",
+    "",
     "[debug]",
     "# Saffire only supports the dbgp protocol",
     "protocol = dbgp",
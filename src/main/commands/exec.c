@@ -94,8 +94,8 @@ static int do_exec(void) {
     t_vm_codeblock *codeblock = vm_codeblock_new(bc, ctx);
 
     t_vm_stackframe *initial_frame = vm_stackframe_new(NULL, codeblock);
-    initial_frame->trace_class = string_strdup0("");
-    initial_frame->trace_method = string_strdup0("");
+    initial_frame->trace_class = "";
+    initial_frame->trace_method = "";
 
     // Run the frame
     int exitcode = vm_execute(initial_frame);
@@ -70,7 +70,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 fp.write(header)
 
 for hex_code,str_code in opcodes.iteritems():
-    fp.write("    #define VM_%-20s%s\n" % (str_code.upper(), hex_code))
+    fp.write("    #define VM_%-20s %s\n" % (str_code.upper(), hex_code))
 fp.write("\n\n")
 
 
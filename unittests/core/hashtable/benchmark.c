@@ -0,0 +1,118 @@
+/*
+ * Compares lookups in the chained and swiss hash table backends, using the kind of keys the runtime stores
+ * in its attribute and identifier tables.
+ *
+ *   htbench [elements] [lookups]
+ *
+ * Only built when cmake is run with -DSAFFIRE_BUILD_BENCHMARKS=ON.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <saffire/general/hashtable.h>
+#include <saffire/general/hash/swiss.h>
+
+extern t_hashfuncs chained_hf;
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void bench(const char *name, t_hashfuncs *hf, char **keys, char **misses, int *order, int elements, long lookups) {
+    double add = 0, hit = 0, miss = 0, iterate = 0;
+    long found = 0;
+
+    // Small tables are built (and destroyed) a couple of times, so we measure more than a single allocation
+    int builds = 1 + 100000 / elements;
+
+    // Take the best of 3 runs, as we are only interested in the table, not in what else the machine is doing
+    for (int run = 0; run != 3; run++) {
+        t_hash_table *ht = NULL;
+
+        double start = now();
+        for (int b = 0; b != builds; b++) {
+            if (ht) ht_destroy(ht);
+            ht = ht_create_custom(16, 1.25, 1.75, hf);
+            for (int i = 0; i != elements; i++) {
+                ht_add_str(ht, keys[i], (void *)(intptr_t)(i + 1));
+            }
+        }
+        double t = (now() - start) * 1e9 / ((double)builds * elements);
+        if (run == 0 || t < add) add = t;
+
+        start = now();
+        for (long i = 0; i != lookups; i++) {
+            if (ht_find_str(ht, keys[order[i % elements]])) found++;
+        }
+        t = (now() - start) * 1e9 / lookups;
+        if (run == 0 || t < hit) hit = t;
+
+        start = now();
+        for (long i = 0; i != lookups; i++) {
+            if (ht_find_str(ht, misses[order[i % elements]])) found++;
+        }
+        t = (now() - start) * 1e9 / lookups;
+        if (run == 0 || t < miss) miss = t;
+
+        start = now();
+        for (int b = 0; b != builds; b++) {
+            t_hash_iter iter;
+            for (ht_iter_init(&iter, ht); ht_iter_valid(&iter); ht_iter_next(&iter)) {
+                found += (intptr_t)ht_iter_value(&iter) & 1;
+            }
+        }
+        t = (now() - start) * 1e9 / ((double)builds * elements);
+        if (run == 0 || t < iterate) iterate = t;
+
+        ht_destroy(ht);
+    }
+
+    printf("%-8s add: %7.1f ns   hit: %7.1f ns   miss: %7.1f ns   iterate: %7.1f ns   (%ld)\n", name,
+           add, hit, miss, iterate, found);
+}
+
+int main(int argc, char *argv[]) {
+    int elements = argc > 1 ? atoi(argv[1]) : 64;
+    long lookups = argc > 2 ? atol(argv[2]) : 10000000;
+    if (elements <= 0 || lookups <= 0) {
+        fprintf(stderr, "usage: %s [elements] [lookups]\n", argv[0]);
+        return 1;
+    }
+
+    char **keys = malloc(sizeof(char *) * elements);
+    char **misses = malloc(sizeof(char *) * elements);
+    int *order = malloc(sizeof(int) * elements);
+    for (int i = 0; i != elements; i++) {
+        keys[i] = malloc(32);
+        misses[i] = malloc(32);
+        snprintf(keys[i], 32, "__attribute_%d", i);
+        snprintf(misses[i], 32, "__missing_%d", i);
+        order[i] = i;
+    }
+
+    // Look up keys in random order, so neither table profits from elements allocated next to each other
+    srand(1);
+    for (int i = elements - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+
+    printf("%d elements, %ld lookups\n", elements, lookups);
+    bench("chained", &chained_hf, keys, misses, order, elements, lookups);
+    bench("swiss", &swiss_hf, keys, misses, order, elements, lookups);
+
+    for (int i = 0; i != elements; i++) {
+        free(keys[i]);
+        free(misses[i]);
+    }
+    free(keys);
+    free(misses);
+    free(order);
+    return 0;
+}
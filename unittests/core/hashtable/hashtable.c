@@ -1,7 +1,10 @@
 #include <CUnit/CUnit.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <string.h>
 #include "hashtable.h"
 #include <saffire/general/hashtable.h>
+#include <saffire/general/symbol.h>
 
 void test_hashtable_replace_does_not_affect_original_after_shallow_copy() {
     t_hash_table *original = ht_create();
@@ -24,8 +27,95 @@ void test_hashtable_replace_does_not_affect_original_after_shallow_copy() {
 }
 
 
+void test_hashtable_lookup_table_keeps_insertion_order() {
+    t_hash_table *ht = ht_create_lookup();
+    char key[32];
+
+    for (int i = 0; i != 1000; i++) {
+        snprintf(key, sizeof(key), "attribute_%d", i);
+        ht_add_str(ht, key, (void *)(intptr_t)(i + 1));
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        snprintf(key, sizeof(key), "attribute_%d", i);
+        CU_ASSERT((intptr_t)ht_remove_str(ht, key) == i + 1);
+    }
+
+    CU_ASSERT(ht->element_count == 500);
+    CU_ASSERT(ht_find_str(ht, "attribute_0") == NULL);
+    CU_ASSERT((intptr_t)ht_find_str(ht, "attribute_999") == 1000);
+
+    t_hash_iter iter;
+    int i = 1;
+    ht_iter_init(&iter, ht);
+    while (ht_iter_valid(&iter)) {
+        snprintf(key, sizeof(key), "attribute_%d", i);
+        CU_ASSERT(strcmp(ht_iter_key_str(&iter), key) == 0);
+        i += 2;
+        ht_iter_next(&iter);
+    }
+    CU_ASSERT(i == 1001);
+
+    ht_destroy(ht);
+}
+
+
+void test_hashtable_finds_keys_during_incremental_rehash() {
+    t_hash_table *ht = ht_create();
+    int migrating = 0;
+
+    for (long i = 0; i != 20000; i++) {
+        ht_add_num(ht, i, (void *)(i + 1));
+        if (ht->old_bucket_list) migrating++;
+
+        // Keys in both the old and the new bucket list must be found
+        CU_ASSERT((long)ht_find_num(ht, i / 2) == i / 2 + 1);
+    }
+    CU_ASSERT(migrating > 0);
+
+    for (long i = 0; i < 20000; i += 2) {
+        CU_ASSERT((long)ht_remove_num(ht, i) == i + 1);
+    }
+    CU_ASSERT(ht->element_count == 10000);
+    CU_ASSERT(ht_exists_num(ht, 0) == 0);
+    CU_ASSERT(ht_exists_num(ht, 19999) == 1);
+
+    ht_destroy(ht);
+}
+
+
+void test_hashtable_symbol_keys_match_string_keys() {
+    t_hash_table *ht = ht_create_lookup();
+
+    t_symbol *foo = symbol_intern0("foo");
+    CU_ASSERT(foo == symbol_intern("foobar", 3));
+    CU_ASSERT(foo != symbol_intern0("bar"));
+
+    ht_add_sym(ht, foo, (void *)1);
+    ht_add_str(ht, "bar", (void *)2);
+
+    // Symbols and plain strings with the same name are the same key
+    CU_ASSERT((long)ht_find_str(ht, "foo") == 1);
+    CU_ASSERT((long)ht_find_sym(ht, symbol_intern0("bar")) == 2);
+    CU_ASSERT(ht_exists_sym(ht, symbol_intern0("baz")) == 0);
+
+    t_hash_iter iter;
+    ht_iter_init(&iter, ht);
+    CU_ASSERT(ht_iter_key_sym(&iter) == foo);
+    ht_iter_next(&iter);
+    CU_ASSERT(ht_iter_key_sym(&iter) == NULL);
+
+    CU_ASSERT((long)ht_remove_sym(ht, foo) == 1);
+    CU_ASSERT(ht->element_count == 1);
+
+    ht_destroy(ht);
+}
+
+
 void test_hashtable_init() {
     CU_pSuite suite = CU_add_suite("hashtable", NULL, NULL);
     CU_add_test(suite, "hashtable_copy", test_hashtable_replace_does_not_affect_original_after_shallow_copy);
+    CU_add_test(suite, "hashtable_lookup_order", test_hashtable_lookup_table_keeps_insertion_order);
+    CU_add_test(suite, "hashtable_incremental_rehash", test_hashtable_finds_keys_during_incremental_rehash);
+    CU_add_test(suite, "hashtable_symbol_keys", test_hashtable_symbol_keys_match_string_keys);
 }
 